@@ -14,6 +14,7 @@ QT += quickcontrols2
 QT += serialport
 QT += gamepad
 QT += charts
+QT += concurrent
 
 CONFIG += c++11
 
@@ -42,27 +43,46 @@ include($$PWD/arcgisruntime.pri)
 
 HEADERS += \
     include/action_type.h \
+    include/angle_optimizer.h \
     include/avl_map_display.h \
+    include/clock_sync.h \
     include/comms/avl_commands.h \
     include/comms/field.h \
     include/comms/packet.h \
     include/comms_channel.h \
+    include/coverage_planner.h \
     include/geofence.h \
+    include/graphic_index.h \
     include/graphics.h \
+    include/link_stats.h \
     include/mission.h \
     include/mission_data_model.h \
+    include/mission_estimator.h \
+    include/mission_graphics.h \
+    include/packet_recorder.h \
+    include/path_history.h \
     include/points_data_model.h \
     include/pugiconfig.hpp \
     include/pugixml.hpp \
+    include/render_scheduler.h \
+    include/replay_engine.h \
+    include/replay_log.h \
+    include/survey_generator.h \
+    include/symbol_cache.h \
     include/task.h \
     include/task_type.h \
+    include/telemetry_channel.h \
+    include/telemetry_history.h \
     include/trajectory.h \
     include/util/byte.h \
+    include/util/geo.h \
+    include/util/span.h \
     include/util/vector.h \
     include/vehicle.h \
     include/vehicle_connection.h \
     include/vehicle_data_model.h \
     include/vehicle_manager.h \
+    include/vehicle_path.h \
     include/vehicle_status.h \
     include/vehicle_type.h \
     include/waypoint.h \
@@ -71,25 +91,42 @@ HEADERS += \
     include/param.h
 
 SOURCES += \
+    src/angle_optimizer.cpp \
     src/avl_map_display.cpp \
+    src/clock_sync.cpp \
     src/comms/avl_commands.cpp \
     src/comms/field.cpp \
     src/comms/packet.cpp \
+    src/coverage_planner.cpp \
     src/geofence.cpp \
     src/geofence_data_model.cpp \
+    src/graphic_index.cpp \
     src/graphics.cpp \
+    src/link_stats.cpp \
     src/main.cpp \
     src/mission.cpp \
     src/mission_data_model.cpp \
+    src/mission_estimator.cpp \
+    src/mission_graphics.cpp \
+    src/packet_recorder.cpp \
     src/param.cpp \
     src/param_data_model.cpp \
+    src/path_history.cpp \
     src/points_data_model.cpp \
     src/pugixml.cpp \
+    src/render_scheduler.cpp \
+    src/replay_engine.cpp \
+    src/replay_log.cpp \
+    src/survey_generator.cpp \
+    src/symbol_cache.cpp \
     src/task.cpp \
+    src/telemetry_history.cpp \
+    src/util/geo.cpp \
     src/vehicle.cpp \
     src/vehicle_connection.cpp \
     src/vehicle_data_model.cpp \
     src/vehicle_manager.cpp \
+    src/vehicle_path.cpp \
     src/vehicle_status.cpp
 
 RESOURCES += \
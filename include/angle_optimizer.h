@@ -0,0 +1,139 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Searches for the survey pass heading that covers a zone in
+//              the least time. Every candidate heading is planned with the
+//              coverage planner on the global thread pool and scored on its
+//              path length, its number of turns and the time to drive it.
+//
+//              The search runs in the background and its scores are read
+//              from a future once it finishes, so that the GUI thread never
+//              waits on the planner.
+//
+//              Headings that differ by 180 degrees give the same passes, so
+//              only half a circle is searched. The time estimate charges a
+//              fixed time per turn, since turning dominates on irregular
+//              zones where a poor heading cuts many short passes.
+//==============================================================================
+
+#ifndef ANGLE_OPTIMIZER_H
+#define ANGLE_OPTIMIZER_H
+
+// Zone outline points
+#include <QPointF>
+
+// Background candidate scoring
+#include <QFuture>
+
+// C++ includes
+#include <vector>
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+class AngleOptimizer
+{
+
+public:
+
+    // Spacing in degrees between the candidate headings
+    static constexpr double ANGLE_STEP = 1.0;
+
+    // Survey speed in meters per second and time in seconds per turn used
+    // when none is given
+    static constexpr double DEFAULT_SPEED = 1.5;
+    static constexpr double DEFAULT_TURN_TIME = 30.0;
+
+    // Score of one candidate heading
+    struct Candidate
+    {
+        double angle;
+        double length;
+        int turns;
+        double time;
+    };
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        AngleOptimizer constructor
+    // Description: Constructs an optimizer for passes at a spacing.
+    // Arguments:   - swath: spacing between passes in meters
+    //              - speed: survey speed in meters per second
+    //              - turn_time: time in seconds to turn onto a pass
+    //--------------------------------------------------------------------------
+    AngleOptimizer(double swath, double speed=DEFAULT_SPEED,
+                   double turn_time=DEFAULT_TURN_TIME);
+
+    //--------------------------------------------------------------------------
+    // Name:        AngleOptimizer destructor
+    // Description: Default destructor.
+    //--------------------------------------------------------------------------
+    virtual ~AngleOptimizer();
+
+    //--------------------------------------------------------------------------
+    // Name:        evaluate
+    // Description: Starts planning and scoring every candidate heading in
+    //              parallel on the global thread pool. The outline and the
+    //              optimizer settings are copied, so neither has to outlive
+    //              the search.
+    // Arguments:   - outline: zone outline with longitude as x and latitude
+    //                as y
+    // Returns:     Future holding the score of each candidate heading, in
+    //              order of heading. It has no results if the zone cannot be
+    //              surveyed.
+    //--------------------------------------------------------------------------
+    QFuture<Candidate> evaluate(const std::vector<QPointF>& outline) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_candidates
+    // Description: Gets the candidate headings from a finished search that
+    //              could be surveyed.
+    // Arguments:   - future: finished future returned by evaluate
+    // Returns:     Scored candidate headings, in order of heading.
+    //--------------------------------------------------------------------------
+    static std::vector<Candidate> get_candidates(const QFuture<Candidate>& future);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_best
+    // Description: Finds the candidate heading with the least survey time.
+    // Arguments:   - candidates: scored candidate headings
+    // Returns:     Fastest candidate. Its time is NaN if there are no
+    //              candidates.
+    //--------------------------------------------------------------------------
+    static Candidate get_best(const std::vector<Candidate>& candidates);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_pareto_set
+    // Description: Finds the candidate headings that no other candidate beats
+    //              on both path length and number of turns. Candidates with
+    //              equal scores are kept once.
+    // Arguments:   - candidates: scored candidate headings
+    // Returns:     Pareto optimal candidates in order of survey time.
+    //--------------------------------------------------------------------------
+    static std::vector<Candidate> get_pareto_set(const std::vector<Candidate>& candidates);
+
+private:
+
+    // Spacing between passes in meters, survey speed in meters per second
+    // and time per turn in seconds
+    double swath;
+    double speed;
+    double turn_time;
+
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        score
+    // Description: Plans and scores one candidate heading.
+    // Arguments:   - outline: zone outline with longitude as x and latitude
+    //                as y
+    //              - angle: candidate heading in degrees
+    // Returns:     Score of the candidate heading.
+    //--------------------------------------------------------------------------
+    Candidate score(const std::vector<QPointF>& outline, double angle) const;
+
+};
+
+#endif // ANGLE_OPTIMIZER_H
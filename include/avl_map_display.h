@@ -14,6 +14,9 @@
 // Vehicle class
 #include "vehicle.h"
 
+// Guarded vehicle pointers
+#include <QPointer>
+
 // ArcGIS Map includes
 #include "Map.h"
 #include "MapQuickView.h"
@@ -50,18 +53,6 @@ class AvlMapDisplay : public QQuickItem
 
     Q_OBJECT
 
-signals:
-
-    //--------------------------------------------------------------------------
-    // Name:        waypointMoved
-    // Description: Signal emitted when a mission waypoint is moved.
-    // Arguments:   - vehicle_index: index of the vehicle being edited in the
-    //                vehicle list. This is not the vehicle ID
-    //              - waypoint_index: index of the waypoint being edited
-    //              - new_location: new waypoint location in lat/lon in degrees
-    //--------------------------------------------------------------------------
-    void waypointMoved(int vehicle_index, int waypoint_index, QPointF new_location);
-
 public:
 
     //--------------------------------------------------------------------------
@@ -182,6 +173,11 @@ public:
     Q_INVOKABLE void load_offline_maps_tpk(QUrl paths);
 
 
+private:
+
+    // Distance in pixels from a graphic within which pressing picks it
+    static constexpr double PICK_TOLERANCE_PIXELS = 10.0;
+
 private:
 
     // Map and MapView used to display the map
@@ -194,14 +190,17 @@ private:
     // ENC exchange set used to load and display ENC data
     EncExchangeSet* encExchangeSet = nullptr;
 
-    // Dragging variables
+    // Dragging variables. The dragged vehicle previews the drag itself, and
+    // the mission is only changed when the drag ends
     bool dragging = false;
-    int dragged_vehicle_index;
-    int dragged_waypoint_index;
     Graphic* dragged_graphic;
+    QPointer<Vehicle> dragged_vehicle;
 
     std::shared_ptr<GraphicsOverlay> geofence_overlay;
 
+    // Vehicles whose paths are drawn on the map, which follow the map scale
+    QVector<QPointer<Vehicle>> path_vehicles;
+
 
 private slots:
 
@@ -225,13 +224,31 @@ private slots:
     void mouse_released(QMouseEvent& mouse_event);
 
     //--------------------------------------------------------------------------
-    // Name:        identify_graphics_overlays_completed
-    // Description: Called when the identify graphics overlay function finishes.
-    // Arguments:   - task_id: task ID of overlay identification
-    //              - identify_results: result of the overlay identification
+    // Name:        viewpoint_changed
+    // Description: Slot called when the map is panned or zoomed. Selects the
+    //              level of detail of each vehicle path from the map scale.
+    //--------------------------------------------------------------------------
+    void viewpoint_changed();
+
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        get_meters_per_pixel
+    // Description: Gets the ground distance covered by one pixel at the
+    //              current map scale.
+    // Returns:     Ground distance in meters.
+    //--------------------------------------------------------------------------
+    double get_meters_per_pixel();
+
+    //--------------------------------------------------------------------------
+    // Name:        pick_graphic
+    // Description: Finds the waypoint or vehicle icon graphic nearest to a
+    //              screen position in every vehicle's graphic index, and
+    //              starts dragging it if it is a waypoint.
+    // Arguments:   - mouse_x: screen x position in pixels
+    //              - mouse_y: screen y position in pixels
     //--------------------------------------------------------------------------
-    void identify_graphics_overlays_completed(QUuid task_id,
-        const QList<IdentifyGraphicsOverlayResult*> &identify_results);
+    void pick_graphic(double mouse_x, double mouse_y);
 
 };
 
@@ -0,0 +1,129 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Estimates the offset between a vehicle's clock and the local
+//              clock from ping round trips, in the same way as NTP. Each
+//              round trip gives four timestamps:
+//
+//                  t0: ping sent (local clock)
+//                  t1: ping received (vehicle clock)
+//                  t2: response sent (vehicle clock)
+//                  t3: response received (local clock)
+//
+//              from which the offset and round trip delay are
+//
+//                  offset = ((t1 - t0) + (t2 - t3)) / 2
+//                  delay  = (t3 - t0) - (t2 - t1)
+//
+//              The offset is taken from the sample with the smallest delay
+//              in a short window of recent samples, since that sample has
+//              the smallest error bound.
+//==============================================================================
+
+#ifndef CLOCK_SYNC_H
+#define CLOCK_SYNC_H
+
+// Sample window
+#include <deque>
+
+// NAN value
+#include <cmath>
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+class ClockSync
+{
+
+public:
+
+    // Number of recent round trip samples used to select the offset
+    static const size_t WINDOW_SIZE = 8;
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        ClockSync constructor
+    // Description: Default constructor.
+    //--------------------------------------------------------------------------
+    ClockSync();
+
+    //--------------------------------------------------------------------------
+    // Name:        ClockSync destructor
+    // Description: Default destructor.
+    //--------------------------------------------------------------------------
+    virtual ~ClockSync();
+
+    //--------------------------------------------------------------------------
+    // Name:        add_sample
+    // Description: Adds a ping round trip sample. Samples with a negative
+    //              delay are inconsistent and are ignored.
+    // Arguments:   - t0: ping sent time in local seconds since epoch
+    //              - t1: ping received time in vehicle seconds since epoch
+    //              - t2: response sent time in vehicle seconds since epoch
+    //              - t3: response received time in local seconds since epoch
+    // Returns:     True if the sample was used, false if it was ignored.
+    //--------------------------------------------------------------------------
+    bool add_sample(double t0, double t1, double t2, double t3);
+
+    //--------------------------------------------------------------------------
+    // Name:        has_offset
+    // Description: Checks whether any round trip samples have been added.
+    // Returns:     True if an offset estimate is available.
+    //--------------------------------------------------------------------------
+    bool has_offset() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_offset
+    // Description: Gets the estimated offset of the vehicle clock from the
+    //              local clock. A vehicle time minus the offset is the
+    //              equivalent local time.
+    // Returns:     Clock offset in seconds, or NaN if no samples were added.
+    //--------------------------------------------------------------------------
+    double get_offset() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_delay
+    // Description: Gets the round trip delay of the sample the offset was
+    //              taken from. Half of it bounds the offset error.
+    // Returns:     Round trip delay in seconds, or NaN if no samples were
+    //              added.
+    //--------------------------------------------------------------------------
+    double get_delay() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        to_local_time
+    // Description: Converts a vehicle timestamp to local time using the
+    //              current offset estimate. The timestamp is returned as is
+    //              if there is no estimate yet.
+    // Arguments:   - vehicle_time: vehicle time in seconds since epoch
+    // Returns:     Local time in seconds since epoch.
+    //--------------------------------------------------------------------------
+    double to_local_time(double vehicle_time) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        reset
+    // Description: Removes all round trip samples.
+    //--------------------------------------------------------------------------
+    void reset();
+
+private:
+
+    // Offset and delay of a single round trip
+    struct Sample
+    {
+        double offset;
+        double delay;
+    };
+
+    // Most recent round trip samples, oldest first
+    std::deque<Sample> samples;
+
+    // Offset and delay of the minimum delay sample in the window
+    double offset = std::nan("");
+    double delay = std::nan("");
+
+};
+
+#endif // CLOCK_SYNC_H
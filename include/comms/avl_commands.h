@@ -77,6 +77,7 @@ const uint8_t STATUS_UMODEM_SYNCED_DESC =      0x0A;
 const uint8_t STATUS_GPS_SATS_DESC =           0x0B;
 const uint8_t STATUS_IRIDIUM_STRENGTH_DESC =   0x0C;
 const uint8_t STATUS_TASK_DESC =               0x0D;
+const uint8_t STATUS_TIMESTAMP_DESC =          0x0E;
 
 // ACTION packet field descriptors
 const uint8_t ACTION_PING_DESC =                     0x00;
@@ -181,9 +182,12 @@ avl::Field STATUS_MAG_FLUX(double mx, double my, double mz);
 avl::Field STATUS_UMODEM_SYNCED(bool synced);
 avl::Field STATUS_GPS_SATS(uint8_t num_sats);
 avl::Field STATUS_IRIDIUM_STRENGTH(uint8_t strength);
+avl::Field STATUS_TASK(uint8_t task_num, uint8_t num_tasks, double percent);
+avl::Field STATUS_TIMESTAMP(double t);
 
 // ACTION packet field creation helper functions
 avl::Field ACTION_PING();
+avl::Field ACTION_PING(double t);
 avl::Field ACTION_EMERGENCY_STOP();
 avl::Field ACTION_POWER_CYCLE();
 avl::Field ACTION_RESTART_ROS();
@@ -104,7 +104,7 @@ public:
     // Description: Gets the field descriptor.
     // Returns:     field descriptor byte.
     //--------------------------------------------------------------------------
-    uint8_t get_descriptor();
+    uint8_t get_descriptor() const;
 
     //--------------------------------------------------------------------------
     // Name:        set_descriptor
@@ -120,6 +120,15 @@ public:
     //--------------------------------------------------------------------------
     std::vector<uint8_t> get_data();
 
+    //--------------------------------------------------------------------------
+    // Name:        get_data_ref
+    // Description: Gets a read-only reference to the field data without
+    //              copying it. The reference is only valid for the lifetime
+    //              of the field.
+    // Returns:     Reference to the field data bytes.
+    //--------------------------------------------------------------------------
+    const std::vector<uint8_t>& get_data_ref() const;
+
     //--------------------------------------------------------------------------
     // Name:        set_data
     // Description: Sets the field data. Also updates the field length.
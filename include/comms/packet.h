@@ -16,6 +16,7 @@
 // Core includes
 #include <comms/field.h>
 #include <iostream>
+#include <stdexcept>
 
 // Packet header bytes
 const std::vector<uint8_t> AVL_PACKET_HEADER = {0x75, 0x65};
@@ -27,6 +28,19 @@ const std::vector<uint8_t> AVL_PACKET_HEADER = {0x75, 0x65};
 namespace avl
 {
 
+//------------------------------------------------------------------------------
+// Name:        ChecksumError
+// Description: Exception thrown when packet bytes are correctly framed but
+//              their checksum does not match. Derives from std::runtime_error
+//              so existing handlers still catch it, while allowing callers
+//              to distinguish corrupted packets from malformed ones.
+//------------------------------------------------------------------------------
+class ChecksumError : public std::runtime_error
+{
+public:
+    explicit ChecksumError(const std::string& what) : std::runtime_error(what) {}
+};
+
 class Packet
 {
 
@@ -139,6 +153,15 @@ public:
     //--------------------------------------------------------------------------
     Field get_field(uint8_t field_descriptor);
 
+    //--------------------------------------------------------------------------
+    // Name:        get_fields
+    // Description: Gets a read-only reference to all of the packet's fields
+    //              in order, for decoders that visit every field once
+    //              instead of looking fields up by descriptor.
+    // Returns:     Reference to the packet's vector of fields.
+    //--------------------------------------------------------------------------
+    const std::vector<Field>& get_fields() const;
+
     //------------------------------------------------------------------------------
     // Name:        add_field
     // Description: Adds a field with the given parameters to the packet.
@@ -206,7 +229,8 @@ private:
     // Description: Checks whether a vector of bytes is a properly formatted
     //              packet, including a header and correct checksum bytes.
     //              Throws a std::runtime_error if the bytes are not a properly
-    //              formatted packet.
+    //              formatted packet, or an avl::ChecksumError if only the
+    //              checksum does not match.
     // Arguments:   - bytes: vector of bytes to validate
     //--------------------------------------------------------------------------
     void validate_bytes(std::vector<uint8_t> bytes);
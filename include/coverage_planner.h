@@ -0,0 +1,202 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Plans a lawnmower (boustrophedon) survey path that covers a
+//              polygonal zone with parallel passes spaced by a swath width.
+//              The planner is plain C++ with no map library dependencies.
+//
+//              The zone is projected into a local east-north plane centered
+//              on the zone, so that the swath width is measured in meters in
+//              every direction, and rotated so that the passes are
+//              horizontal. Each pass is clipped against every edge of the
+//              zone outline and its holes with an even-odd rule, so concave
+//              zones and holes split a pass into several segments rather
+//              than losing it.
+//
+//              Segments on neighbouring passes that overlap form cells, and
+//              a cell ends wherever the zone splits or merges. Each cell is
+//              covered back and forth on its own, and the cells are visited
+//              in nearest-first order, so the path does not zigzag across
+//              holes and notches on every pass.
+//
+//              A zone can also be partitioned between several vehicles.
+//              The passes are split into bands of whole passes with equal
+//              coverage time, so that each band is surveyed by one vehicle
+//              and planning a band on its own gives back the same passes.
+//              The vehicles are assumed to survey at the same speed, so
+//              bands of equal survey length take equal time.
+//==============================================================================
+
+#ifndef COVERAGE_PLANNER_H
+#define COVERAGE_PLANNER_H
+
+// Local east-north frames
+#include "util/geo.h"
+
+// C++ includes
+#include <vector>
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+class CoveragePlanner
+{
+
+public:
+
+    // Location in degrees
+    struct Location
+    {
+        double lat;
+        double lon;
+    };
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        CoveragePlanner constructor
+    // Description: Constructs a planner for passes at a heading and spacing.
+    // Arguments:   - angle: compass heading of the passes in degrees
+    //              - swath: spacing between passes in meters
+    //--------------------------------------------------------------------------
+    CoveragePlanner(double angle, double swath);
+
+    //--------------------------------------------------------------------------
+    // Name:        CoveragePlanner destructor
+    // Description: Default destructor.
+    //--------------------------------------------------------------------------
+    virtual ~CoveragePlanner();
+
+    //--------------------------------------------------------------------------
+    // Name:        plan
+    // Description: Plans a survey path covering a zone. The first pass is
+    //              half a swath inside the zone, and a zone narrower than
+    //              one swath gets a single pass through its middle.
+    // Arguments:   - outline: zone outline vertices, in order
+    //              - holes: vertices of each area inside the outline that is
+    //                not surveyed
+    // Returns:     Ordered path waypoints, the two ends of each pass segment
+    //              in the order they are driven. Empty if the outline has
+    //              fewer than three vertices, the swath is not positive or the
+    //              angle is not finite.
+    //--------------------------------------------------------------------------
+    std::vector<Location> plan(const std::vector<Location>& outline,
+        const std::vector<std::vector<Location>>& holes=std::vector<std::vector<Location>>()) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        partition
+    // Description: Splits a zone into bands across the passes that take
+    //              equal time to survey at the same speed. Each pass is
+    //              costed by its length plus one swath for the turn to each
+    //              of its segments, and bands are bounded halfway between
+    //              passes.
+    // Arguments:   - outline: zone outline vertices, in order
+    //              - num_parts: number of bands to split the zone into
+    // Returns:     Outline vertices of each band, in order across the passes.
+    //              Fewer bands are returned if the zone has fewer passes than
+    //              bands, and none under the same conditions as plan.
+    //--------------------------------------------------------------------------
+    std::vector<std::vector<Location>> partition(const std::vector<Location>& outline,
+                                                 int num_parts) const;
+
+private:
+
+    // Point in the planning plane, in meters. u runs along the passes and
+    // v across them
+    struct PlanePoint
+    {
+        double u;
+        double v;
+    };
+
+    // Part of a pass inside the zone, from u0 to u1 with u0 < u1
+    struct Segment
+    {
+        double v;
+        double u0;
+        double u1;
+    };
+
+    // Local plane tangent at a zone's center and rotated to the passes
+    struct Frame
+    {
+        avl::geo::EnuFrame enu;
+        double along_east;
+        double along_north;
+        PlanePoint to_plane(const Location& location) const;
+        Location to_location(const PlanePoint& point) const;
+    };
+
+private:
+
+    // Compass heading of the passes in degrees and spacing in meters
+    double angle;
+    double swath;
+
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        get_frame
+    // Description: Gets the planning plane of a zone.
+    // Arguments:   - outline: zone outline vertices
+    // Returns:     Planning plane tangent at the center of the outline's
+    //              bounding box.
+    //--------------------------------------------------------------------------
+    Frame get_frame(const std::vector<Location>& outline) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        clip_passes
+    // Description: Finds the segments of every pass across a zone. Pass i
+    //              is at i and a half swaths above the lowest v of the
+    //              outline, unless the zone is narrower than one swath.
+    // Arguments:   - rings: zone outline and holes in the planning plane
+    // Returns:     Segments of each pass, in order of increasing v.
+    //--------------------------------------------------------------------------
+    std::vector<std::vector<Segment>> clip_passes(
+        const std::vector<std::vector<PlanePoint>>& rings) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        clip_band
+    // Description: Clips a ring to the band between two values of v.
+    // Arguments:   - ring: ring in the planning plane
+    //              - v0: lower bound of the band
+    //              - v1: upper bound of the band
+    // Returns:     Vertices of the part of the ring inside the band. Parts of
+    //              a concave ring are joined along the band's bounds.
+    //--------------------------------------------------------------------------
+    static std::vector<PlanePoint> clip_band(const std::vector<PlanePoint>& ring,
+                                             double v0, double v1);
+
+    //--------------------------------------------------------------------------
+    // Name:        clip_pass
+    // Description: Finds the segments of a pass that are inside the zone.
+    // Arguments:   - rings: zone outline and holes in the planning plane
+    //              - v: position of the pass across the passes
+    // Returns:     Segments in order of increasing u.
+    //--------------------------------------------------------------------------
+    static std::vector<Segment> clip_pass(const std::vector<std::vector<PlanePoint>>& rings,
+                                          double v);
+
+    //--------------------------------------------------------------------------
+    // Name:        build_cells
+    // Description: Groups the segments of every pass into cells of
+    //              segments on consecutive passes that overlap one to one.
+    // Arguments:   - passes: segments of each pass, in pass order
+    // Returns:     Segments of each cell, in pass order.
+    //--------------------------------------------------------------------------
+    static std::vector<std::vector<Segment>> build_cells(
+        const std::vector<std::vector<Segment>>& passes);
+
+    //--------------------------------------------------------------------------
+    // Name:        order_cells
+    // Description: Drives every cell back and forth, visiting next the cell
+    //              with the nearest starting corner.
+    // Arguments:   - cells: segments of each cell, in pass order
+    // Returns:     Path waypoints in the planning plane.
+    //--------------------------------------------------------------------------
+    static std::vector<PlanePoint> order_cells(const std::vector<std::vector<Segment>>& cells);
+
+};
+
+#endif // COVERAGE_PLANNER_H
@@ -30,6 +30,46 @@
 class Geofence : public QObject
 {
     Q_OBJECT
+
+signals:
+
+    //--------------------------------------------------------------------------
+    // Name:        pointsAboutToBeInserted, pointsInserted
+    // Description: Signals emitted before and after points are inserted, so
+    //              that models showing the geofence can update only their
+    //              rows.
+    // Arguments:   - first: index of the first inserted point
+    //              - last: index of the last inserted point
+    //--------------------------------------------------------------------------
+    void pointsAboutToBeInserted(int first, int last);
+    void pointsInserted(int first, int last);
+
+    //--------------------------------------------------------------------------
+    // Name:        pointsAboutToBeRemoved, pointsRemoved
+    // Description: Signals emitted before and after points are removed.
+    // Arguments:   - first: index of the first removed point
+    //              - last: index of the last removed point
+    //--------------------------------------------------------------------------
+    void pointsAboutToBeRemoved(int first, int last);
+    void pointsRemoved(int first, int last);
+
+    //--------------------------------------------------------------------------
+    // Name:        pointAboutToBeMoved, pointMoved
+    // Description: Signals emitted before and after a point moves to another
+    //              index.
+    // Arguments:   - from: index of the point before it moves
+    //              - to: index of the point after it moves
+    //--------------------------------------------------------------------------
+    void pointAboutToBeMoved(int from, int to);
+    void pointMoved(int from, int to);
+
+    //--------------------------------------------------------------------------
+    // Name:        pointChanged
+    // Description: Signal emitted when the location of a point changes.
+    // Arguments:   - index: index of the point
+    //--------------------------------------------------------------------------
+    void pointChanged(int index);
+
 public:
     //--------------------------------------------------------------------------
     // Name:        Params constructor
@@ -90,6 +130,22 @@ public:
     //--------------------------------------------------------------------------
     QPointF get(int index);
 
+    //--------------------------------------------------------------------------
+    // Name:        set
+    // Description: Sets the location of the point at the given index.
+    // Arguments:   - index: index of the point to set
+    //              - point: new location with longitude as x and latitude as y
+    //--------------------------------------------------------------------------
+    void set(int index, QPointF point);
+
+    //--------------------------------------------------------------------------
+    // Name:        move
+    // Description: Moves the point at the given index to another index.
+    // Arguments:   - from: index of the point to move
+    //              - to: index to move the point to
+    //--------------------------------------------------------------------------
+    void move(int from, int to);
+
 
 
 private:
@@ -117,6 +117,13 @@ public:
     //--------------------------------------------------------------------------
     Q_INVOKABLE void set_task(Task* task_ptr);
 
+    //--------------------------------------------------------------------------
+    // Name:        set_geofence
+    // Description: Sets the geofence whose points should be displayed.
+    // Arguments:   - geofence: pointer to the geofence to display
+    //--------------------------------------------------------------------------
+    void set_geofence(Geofence* geofence);
+
     //--------------------------------------------------------------------------
     // Name:        redraw
     // Description: Redraws the points data model.
@@ -196,6 +203,19 @@ public:
     //--------------------------------------------------------------------------
     Q_INVOKABLE void load_geofence(QString filepath);
 
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        number_rows
+    // Description: Updates the point number column of a range of rows, whose
+    //              numbers change when rows are inserted, removed or moved
+    //              before them.
+    // Arguments:   - first: first row whose number changed
+    //              - last: last row whose number changed, or -1 for the last
+    //                row in the table
+    //--------------------------------------------------------------------------
+    void number_rows(int first, int last=-1);
+
 };
 
 #endif // GEOFENCE_DATA_MODEL_H
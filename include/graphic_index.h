@@ -0,0 +1,158 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Spatial index of point graphics on the map, used to pick the
+//              graphic under the mouse without asking the map view to
+//              identify graphics asynchronously. Graphics are kept in a
+//              uniform grid of WGS84 cells, so inserting, moving and removing
+//              a graphic only touches its cell, and a search only looks at
+//              the cells that its radius covers.
+//
+//              Distances are measured on a local flat approximation of the
+//              earth, which is accurate over the few pixels that a pick
+//              covers.
+//==============================================================================
+
+#ifndef GRAPHIC_INDEX_H
+#define GRAPHIC_INDEX_H
+
+// Graphic locations
+#include <QPointF>
+
+// Cell and graphic storage
+#include <QHash>
+
+// Earth radius and degree to radian conversion
+#include "util/geo.h"
+
+// ArcGIS includes
+#include <Graphic.h>
+
+// C++ includes
+#include <vector>
+
+using namespace Esri::ArcGISRuntime;
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+class GraphicIndex
+{
+
+public:
+
+    // Default cell side length in degrees, roughly 100 m of latitude
+    static constexpr double DEFAULT_CELL_SIZE = 0.001;
+
+    // Length in meters of one degree of latitude
+    static constexpr double METERS_PER_DEGREE = avl::geo::EARTH_RADIUS *
+                                                avl::geo::DEGREES_TO_RADIANS;
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        GraphicIndex constructor
+    // Description: Constructs an empty index.
+    // Arguments:   - cell_size: cell side length in degrees
+    //--------------------------------------------------------------------------
+    GraphicIndex(double cell_size=DEFAULT_CELL_SIZE);
+
+    //--------------------------------------------------------------------------
+    // Name:        GraphicIndex destructor
+    // Description: Default destructor.
+    //--------------------------------------------------------------------------
+    virtual ~GraphicIndex();
+
+    //--------------------------------------------------------------------------
+    // Name:        insert
+    // Description: Adds a graphic at a location, or moves it there if it is
+    //              already in the index.
+    // Arguments:   - graphic: graphic to add
+    //              - location: graphic location with longitude as x and
+    //                latitude as y
+    //--------------------------------------------------------------------------
+    void insert(Graphic* graphic, QPointF location);
+
+    //--------------------------------------------------------------------------
+    // Name:        remove
+    // Description: Removes a graphic. Does nothing if it is not in the index.
+    // Arguments:   - graphic: graphic to remove
+    //--------------------------------------------------------------------------
+    void remove(Graphic* graphic);
+
+    //--------------------------------------------------------------------------
+    // Name:        clear
+    // Description: Removes every graphic.
+    //--------------------------------------------------------------------------
+    void clear();
+
+    //--------------------------------------------------------------------------
+    // Name:        size
+    // Description: Gets the number of graphics in the index.
+    // Returns:     Number of graphics.
+    //--------------------------------------------------------------------------
+    int size() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        find_nearest
+    // Description: Finds the graphic nearest to a location within a radius.
+    // Arguments:   - location: location to search around with longitude as x
+    //                and latitude as y
+    //              - radius: search radius in meters
+    //              - distance: set to the distance in meters to the graphic
+    //                that is found, if not null
+    // Returns:     Nearest graphic, or null if none is within the radius.
+    //--------------------------------------------------------------------------
+    Graphic* find_nearest(QPointF location, double radius, double* distance=nullptr) const;
+
+private:
+
+    // Location of an indexed graphic and the key of its cell
+    struct Entry
+    {
+        QPointF location;
+        qint64 cell;
+    };
+
+private:
+
+    // Cell side length in degrees
+    double cell_size;
+
+    // Location of each graphic, and the graphics in each non-empty cell
+    QHash<Graphic*, Entry> entries;
+    QHash<qint64, std::vector<Graphic*>> cells;
+
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        get_cell
+    // Description: Gets the key of the cell at a pair of cell coordinates.
+    // Arguments:   - column: cell column, counted east from longitude 0
+    //              - row: cell row, counted north from latitude 0
+    // Returns:     Cell key.
+    //--------------------------------------------------------------------------
+    static qint64 get_cell(qint64 column, qint64 row);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_coordinate
+    // Description: Gets the cell coordinate that a longitude or latitude
+    //              falls in.
+    // Arguments:   - degrees: longitude or latitude in degrees
+    // Returns:     Cell column or row.
+    //--------------------------------------------------------------------------
+    qint64 get_coordinate(double degrees) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        remove_from_cell
+    // Description: Removes a graphic from the list of graphics in a cell,
+    //              dropping the cell if it becomes empty.
+    // Arguments:   - graphic: graphic to remove
+    //              - cell: key of the graphic's cell
+    //--------------------------------------------------------------------------
+    void remove_from_cell(Graphic* graphic, qint64 cell);
+
+};
+
+#endif // GRAPHIC_INDEX_H
@@ -0,0 +1,227 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Link statistics for a single vehicle communication channel.
+//              Counts packets and bytes in each direction, invalid packets,
+//              and builds a histogram of status packet inter-arrival times
+//              that is used to estimate the number of lost status packets.
+//              Also keeps a histogram of status latency, the age of the
+//              status data when it arrives, for timestamped statuses.
+//==============================================================================
+
+#ifndef LINK_STATS_H
+#define LINK_STATS_H
+
+// QObject base class
+#include <QObject>
+
+// QString class
+#include <QString>
+
+// QVariantList for exposing the histogram to QML
+#include <QVariant>
+
+// Comms channel enum
+#include "comms_channel.h"
+
+// AVL packet class
+#include "comms/packet.h"
+
+// NAN value
+#include <cmath>
+
+//==============================================================================
+//                              STRUCT DECLARATION
+//==============================================================================
+
+class LinkStats
+{
+
+    Q_GADGET
+
+    // Property configuration
+    Q_PROPERTY(QString comms_channel             MEMBER comms_channel)
+    Q_PROPERTY(int packets_in                    MEMBER packets_in)
+    Q_PROPERTY(int packets_out                   MEMBER packets_out)
+    Q_PROPERTY(qint64 bytes_in                   MEMBER bytes_in)
+    Q_PROPERTY(qint64 bytes_out                  MEMBER bytes_out)
+    Q_PROPERTY(int checksum_failures             MEMBER checksum_failures)
+    Q_PROPERTY(int parse_errors                  MEMBER parse_errors)
+    Q_PROPERTY(int status_packets                MEMBER status_packets)
+    Q_PROPERTY(int packets_lost                  MEMBER packets_lost)
+    Q_PROPERTY(double loss_percent               MEMBER loss_percent)
+    Q_PROPERTY(double expected_period            MEMBER expected_period)
+    Q_PROPERTY(double status_age                 MEMBER status_age)
+    Q_PROPERTY(QVariantList interarrival_bins    READ get_interarrival_bins)
+    Q_PROPERTY(QVariantList interarrival_histogram READ get_interarrival_histogram)
+    Q_PROPERTY(int latency_samples               MEMBER latency_samples)
+    Q_PROPERTY(double latency                    MEMBER latency)
+    Q_PROPERTY(double mean_latency               MEMBER mean_latency)
+    Q_PROPERTY(QVariantList latency_histogram    READ get_latency_histogram)
+
+public:
+
+    // Upper edges of the status inter-arrival and latency histogram bins in
+    // seconds. The final bin collects every time above the last edge
+    static const int NUM_INTERARRIVAL_BINS = 10;
+    static const double INTERARRIVAL_BIN_EDGES[NUM_INTERARRIVAL_BINS - 1];
+
+    // A gap longer than this multiple of the expected status period is
+    // counted as one or more lost status packets
+    static constexpr double LOSS_GAP_FACTOR = 1.5;
+
+    // Smoothing factor for the expected status period moving average
+    static constexpr double PERIOD_SMOOTHING = 0.1;
+
+public:
+
+    // Member variables
+    QString comms_channel = "RADIO";
+    int packets_in = 0;
+    int packets_out = 0;
+    qint64 bytes_in = 0;
+    qint64 bytes_out = 0;
+    int checksum_failures = 0;
+    int parse_errors = 0;
+    int status_packets = 0;
+    int packets_lost = 0;
+    double loss_percent = 0.0;
+    double expected_period = std::nan("");
+    double status_age = std::nan("");
+    int latency_samples = 0;
+    double latency = std::nan("");
+    double mean_latency = std::nan("");
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        LinkStats constructor
+    // Description: Default constructor.
+    //--------------------------------------------------------------------------
+    LinkStats();
+
+    //--------------------------------------------------------------------------
+    // Name:        LinkStats constructor
+    // Description: Constructs empty link statistics for a comms channel.
+    // Arguments:   - channel: comms channel the statistics describe
+    //--------------------------------------------------------------------------
+    LinkStats(CommsChannel::Value channel);
+
+    //--------------------------------------------------------------------------
+    // Name:        LinkStats destructor
+    // Description: Default destructor.
+    //--------------------------------------------------------------------------
+    virtual ~LinkStats();
+
+    //--------------------------------------------------------------------------
+    // Name:        get_packet_channel
+    // Description: Gets the comms channel a packet was sent over from its
+    //              comms channel field. Packets without the field are
+    //              assumed to have been sent over the radio.
+    // Arguments:   - packet: packet to get the comms channel of
+    // Returns:     Comms channel the packet was sent over.
+    //--------------------------------------------------------------------------
+    static CommsChannel::Value get_packet_channel(avl::Packet& packet);
+
+    //--------------------------------------------------------------------------
+    // Name:        record_packet_in
+    // Description: Records a valid packet received over the channel. Status
+    //              packets also update the inter-arrival histogram and the
+    //              lost packet estimate.
+    // Arguments:   - num_bytes: total number of bytes in the packet
+    //              - is_status: true if the packet is a status packet
+    //              - time_ms: receive time in milliseconds since epoch
+    //--------------------------------------------------------------------------
+    void record_packet_in(int num_bytes, bool is_status, qint64 time_ms);
+
+    //--------------------------------------------------------------------------
+    // Name:        record_packet_out
+    // Description: Records a packet sent over the channel.
+    // Arguments:   - num_bytes: total number of bytes in the packet
+    //--------------------------------------------------------------------------
+    void record_packet_out(int num_bytes);
+
+    //--------------------------------------------------------------------------
+    // Name:        record_checksum_failure
+    // Description: Records received bytes that failed checksum validation.
+    // Arguments:   - num_bytes: number of bytes that were discarded
+    //--------------------------------------------------------------------------
+    void record_checksum_failure(int num_bytes);
+
+    //--------------------------------------------------------------------------
+    // Name:        record_parse_error
+    // Description: Records received bytes that could not be parsed into a
+    //              packet for reasons other than a checksum failure.
+    // Arguments:   - num_bytes: number of bytes that were discarded
+    //--------------------------------------------------------------------------
+    void record_parse_error(int num_bytes);
+
+    //--------------------------------------------------------------------------
+    // Name:        record_latency
+    // Description: Records the latency of a timestamped status packet.
+    // Arguments:   - seconds: time from the status being sampled on the
+    //                vehicle to it being received, in local clock time
+    //--------------------------------------------------------------------------
+    void record_latency(double seconds);
+
+    //--------------------------------------------------------------------------
+    // Name:        update_status_age
+    // Description: Updates the status age from the time of the last status
+    //              packet. The age is NaN if no status has been received.
+    // Arguments:   - time_ms: current time in milliseconds since epoch
+    //--------------------------------------------------------------------------
+    void update_status_age(qint64 time_ms);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_interarrival_bins
+    // Description: Gets the upper edges of the inter-arrival histogram bins.
+    // Returns:     List of bin upper edges in seconds.
+    //--------------------------------------------------------------------------
+    QVariantList get_interarrival_bins() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_interarrival_histogram
+    // Description: Gets the status inter-arrival histogram counts.
+    // Returns:     List of counts, one per histogram bin.
+    //--------------------------------------------------------------------------
+    QVariantList get_interarrival_histogram() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_latency_histogram
+    // Description: Gets the status latency histogram counts. The histogram
+    //              uses the same bins as the inter-arrival histogram.
+    // Returns:     List of counts, one per histogram bin.
+    //--------------------------------------------------------------------------
+    QVariantList get_latency_histogram() const;
+
+private:
+
+    // Receive time of the last status packet in milliseconds since epoch,
+    // or -1 if no status packet has been received
+    qint64 last_status_ms = -1;
+
+    // Number of status packets falling in each inter-arrival bin
+    int interarrival_counts[NUM_INTERARRIVAL_BINS] = {};
+
+    // Number of status packets falling in each latency bin
+    int latency_counts[NUM_INTERARRIVAL_BINS] = {};
+
+    // Sum of all recorded latencies for the mean
+    double latency_sum = 0.0;
+
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        get_bin
+    // Description: Gets the histogram bin for a time in seconds.
+    // Arguments:   - seconds: time to get the bin of
+    // Returns:     Index of the first bin whose upper edge is above the
+    //              time, or the last bin if the time is above every edge.
+    //--------------------------------------------------------------------------
+    static int get_bin(double seconds);
+
+};
+
+Q_DECLARE_METATYPE(LinkStats)
+
+#endif // LINK_STATS_H
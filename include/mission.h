@@ -45,6 +45,43 @@ signals:
     //--------------------------------------------------------------------------
     void missionChanged();
 
+    //--------------------------------------------------------------------------
+    // Name:        tasksAboutToBeInserted, tasksInserted
+    // Description: Signals emitted before and after tasks are inserted, so
+    //              that models showing the mission can update only their rows.
+    // Arguments:   - first: index of the first inserted task
+    //              - last: index of the last inserted task
+    //--------------------------------------------------------------------------
+    void tasksAboutToBeInserted(int first, int last);
+    void tasksInserted(int first, int last);
+
+    //--------------------------------------------------------------------------
+    // Name:        tasksAboutToBeRemoved, tasksRemoved
+    // Description: Signals emitted before and after tasks are removed.
+    // Arguments:   - first: index of the first removed task
+    //              - last: index of the last removed task
+    //--------------------------------------------------------------------------
+    void tasksAboutToBeRemoved(int first, int last);
+    void tasksRemoved(int first, int last);
+
+    //--------------------------------------------------------------------------
+    // Name:        taskAboutToBeMoved, taskMoved
+    // Description: Signals emitted before and after a task moves to another
+    //              index.
+    // Arguments:   - from: index of the task before it moves
+    //              - to: index of the task after it moves
+    //--------------------------------------------------------------------------
+    void taskAboutToBeMoved(int from, int to);
+    void taskMoved(int from, int to);
+
+    //--------------------------------------------------------------------------
+    // Name:        taskEdited
+    // Description: Signal emitted when a value or point of one of the tasks
+    //              changes.
+    // Arguments:   - index: index of the task
+    //--------------------------------------------------------------------------
+    void taskEdited(int index);
+
 public:
 
     //--------------------------------------------------------------------------
@@ -139,7 +176,7 @@ private slots:
     //--------------------------------------------------------------------------
     // Name:        task_changed
     // Description: Slot called when one of the tasks in a mission changes.
-    //              Simply emits a missionChanged signal.
+    //              Emits taskEdited for the task and missionChanged.
     //--------------------------------------------------------------------------
     void task_changed();
 
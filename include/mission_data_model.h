@@ -81,6 +81,13 @@ public:
     //--------------------------------------------------------------------------
     virtual QHash<int, QByteArray> roleNames() const override;
 
+    //--------------------------------------------------------------------------
+    // Name:        set_mission
+    // Description: Sets the mission whose tasks should be displayed.
+    // Arguments:   - mission_ptr: pointer to the mission to display
+    //--------------------------------------------------------------------------
+    void set_mission(Mission* mission_ptr);
+
     //--------------------------------------------------------------------------
     // Name:        redraw
     // Description: Redraws the mission data model.
@@ -188,15 +195,18 @@ private:
     // Index of the currently selected task
     int selected_task = 0;
 
-private slots:
+private:
 
     //--------------------------------------------------------------------------
-    // Name:        points_changed
-    // Description: Slot that is called when the points in a task change. Emits
-    //              a dataChanged signal to update column indicating the number
-    //              of points in a task.
+    // Name:        number_rows
+    // Description: Updates the task number column of a range of rows, whose
+    //              numbers change when rows are inserted, removed or moved
+    //              before them.
+    // Arguments:   - first: first row whose number changed
+    //              - last: last row whose number changed, or -1 for the last
+    //                row in the table
     //--------------------------------------------------------------------------
-    void points_changed();
+    void number_rows(int first, int last=-1);
 
 };
 
@@ -0,0 +1,351 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Estimates the time and distance to run a mission by stepping
+//              a simple vehicle model through its tasks. The vehicle drives
+//              each leg at its task's speed, turns onto the next waypoint
+//              along a circle of fixed radius before driving straight to it,
+//              and changes depth at a fixed vertical speed while it drives,
+//              so a leg takes the longer of its horizontal and vertical
+//              times. A diving task surfaces at each of its waypoints.
+//              Primitive tasks hold for their duration, and zone tasks only
+//              hold the outline of the survey that follows them.
+//
+//              The mission is simulated from its first waypoint, so that
+//              the estimate does not change as the vehicle moves. The state
+//              of the vehicle at the start and end of each task is kept, so
+//              an update only simulates tasks whose values, points or
+//              starting state changed.
+//
+//              The vehicle turns from the line of its last leg, so the time
+//              and distance of a leg only depend on its waypoint and the two
+//              before it. Each task keeps the time and distance of its legs
+//              and their running sums. The estimator follows the point edit
+//              signals of each task to keep its legs lined up with the
+//              points and to mark the legs next to the edited points, so an
+//              update only drives the marked legs without comparing points.
+//==============================================================================
+
+#ifndef MISSION_ESTIMATOR_H
+#define MISSION_ESTIMATOR_H
+
+// Tasks to simulate
+#include "task.h"
+
+// Qt includes
+#include <QObject>
+#include <QVector>
+
+// C++ includes
+#include <vector>
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+class MissionEstimator
+{
+
+public:
+
+    // Speed in meters per second used by tasks without a speed, turn radius
+    // in meters and vertical speed in meters per second
+    static constexpr double DEFAULT_SPEED = 1.5;
+    static constexpr double DEFAULT_TURN_RADIUS = 10.0;
+    static constexpr double DEFAULT_VERTICAL_SPEED = 0.3;
+
+    // Task values that the simulation depends on. The point latitudes and
+    // longitudes are views of the task's points, which are only read while
+    // the task is simulated. One point can be given another location to
+    // preview moving it
+    struct TaskInput
+    {
+        TaskType::Value type;
+        double duration;
+        double speed;
+        double depth;
+        bool dive;
+        avl::Span<double> lats;
+        avl::Span<double> lons;
+        int moved_index = -1;
+        QPointF moved_point;
+        int get_num_points() const;
+        QPointF get_point(int index) const;
+        bool same_parameters(const TaskInput& other) const;
+    };
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        MissionEstimator constructor
+    // Description: Constructs an estimator for an empty mission.
+    // Arguments:   - turn_radius: vehicle turn radius in meters
+    //              - vertical_speed: vehicle vertical speed in meters per
+    //                second
+    //--------------------------------------------------------------------------
+    MissionEstimator(double turn_radius=DEFAULT_TURN_RADIUS,
+                     double vertical_speed=DEFAULT_VERTICAL_SPEED);
+
+    //--------------------------------------------------------------------------
+    // Name:        MissionEstimator destructor
+    // Description: Disconnects from the tasks of the mission.
+    //--------------------------------------------------------------------------
+    virtual ~MissionEstimator();
+
+    // The estimator is connected to its tasks, so it is not copied
+    MissionEstimator(const MissionEstimator&) = delete;
+    MissionEstimator& operator=(const MissionEstimator&) = delete;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_input
+    // Description: Gets the values of a task that the simulation depends on.
+    //              The task's x velocity is its speed if it is positive.
+    // Arguments:   - task: task to get the values of
+    // Returns:     Task values.
+    //--------------------------------------------------------------------------
+    static TaskInput get_input(Task* task);
+
+    //--------------------------------------------------------------------------
+    // Name:        update
+    // Description: Updates the estimate to a mission, simulating only the
+    //              tasks whose starting state or values changed, and only
+    //              the legs of an edited task next to its changed points.
+    //              Tasks are matched to their previous results by identity,
+    //              and new tasks are connected to so that their point edits
+    //              are followed.
+    // Arguments:   - tasks: tasks in the mission
+    // Returns:     Number of legs that were driven.
+    //--------------------------------------------------------------------------
+    size_t update(const QVector<Task*>& tasks);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_time
+    // Description: Gets the estimated time to run the mission.
+    // Returns:     Mission time in seconds.
+    //--------------------------------------------------------------------------
+    double get_time() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_distance
+    // Description: Gets the estimated horizontal distance driven in the
+    //              mission, including turns.
+    // Returns:     Mission distance in meters.
+    //--------------------------------------------------------------------------
+    double get_distance() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_eta
+    // Description: Gets the estimated time from the start of the mission
+    //              that a waypoint is reached.
+    // Arguments:   - task_index: index of the task in the mission
+    //              - point_index: index of the waypoint in the task
+    // Returns:     Time in seconds, or NaN if there is no such waypoint.
+    //--------------------------------------------------------------------------
+    double get_eta(int task_index, int point_index) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        preview_point
+    // Description: Estimates the mission with a waypoint moved, without
+    //              changing the estimate. Only the legs to the waypoint and
+    //              the two after it are driven, along with the first legs of
+    //              the tasks after it whose starting state changes.
+    // Arguments:   - task: task that the waypoint belongs to
+    //              - index: index of the waypoint in the task
+    //              - location: location to move the waypoint to with
+    //                longitude as x and latitude as y
+    //              - time: set to the mission time in seconds
+    //              - distance: set to the mission distance in meters
+    // Returns:     True if the legs could be previewed, or false if a task
+    //              has edits that were not simulated yet or points that are
+    //              not valid locations.
+    //--------------------------------------------------------------------------
+    bool preview_point(Task* task, int index, QPointF location,
+                       double& time, double& distance) const;
+
+private:
+
+    // Vehicle state between legs. The heading is the compass bearing in
+    // radians of the line of the last leg, which is only known once the
+    // vehicle has driven a leg
+    struct State
+    {
+        bool has_location = false;
+        QPointF location;
+        bool has_heading = false;
+        double heading = 0.0;
+        double depth = 0.0;
+        bool operator==(const State& other) const;
+    };
+
+    // Time in seconds and horizontal distance in meters of the leg to a
+    // waypoint, which is only driven if the waypoint is a valid location
+    struct Leg
+    {
+        double time = 0.0;
+        double distance = 0.0;
+        bool driven = false;
+    };
+
+    // Task with the inputs it was simulated with, the state at its start and
+    // end, and the leg to each of its points. The task's time and distance
+    // are running sums of its legs, counted from the start of the task, which
+    // is counted from the start of the mission. Legs are only reused when
+    // every point of the task is a valid location. The legs from the first
+    // edited leg up to the end of the edited legs are driven on the next
+    // update, and every leg is driven if the legs stopped following the
+    // points
+    struct TaskResult
+    {
+        Task* task = nullptr;
+        std::vector<QMetaObject::Connection> connections;
+        TaskInput input;
+        State start;
+        State end;
+        std::vector<Leg> legs;
+        bool valid_points = true;
+        size_t edited_begin = 0;
+        size_t edited_end = 0;
+        bool reset = true;
+        double time = 0.0;
+        double distance = 0.0;
+        double start_time = 0.0;
+        double start_distance = 0.0;
+    };
+
+private:
+
+    // Vehicle turn radius in meters and vertical speed in meters per second
+    double turn_radius;
+    double vertical_speed;
+
+    // Result of each task in the mission
+    std::vector<TaskResult> results;
+
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        connect_task
+    // Description: Connects to the point edit signals of a task so that the
+    //              legs of its result follow its points.
+    // Arguments:   - result: result of the task to connect to
+    //--------------------------------------------------------------------------
+    void connect_task(TaskResult& result);
+
+    //--------------------------------------------------------------------------
+    // Name:        find_result
+    // Description: Finds the result of a task in the mission.
+    // Arguments:   - task: task to find the result of
+    // Returns:     Result of the task, or null if it has not been simulated.
+    //--------------------------------------------------------------------------
+    TaskResult* find_result(Task* task);
+
+    //--------------------------------------------------------------------------
+    // Name:        points_inserted, points_removed, point_moved,
+    //              point_changed, points_reset
+    // Description: Slots called when points of a task are edited. The legs
+    //              are shifted to line up with the points, and the legs to
+    //              the edited points and the two points after them are
+    //              marked to be driven. If the legs no longer line up with
+    //              the points, every leg is driven on the next update.
+    // Arguments:   - task: task whose points were edited
+    //              - first: index of the first inserted or removed point
+    //              - last: index of the last inserted or removed point
+    //              - from: index of the point before it moved
+    //              - to: index of the point after it moved
+    //              - index: index of the changed point
+    //--------------------------------------------------------------------------
+    void points_inserted(Task* task, int first, int last);
+    void points_removed(Task* task, int first, int last);
+    void point_moved(Task* task, int from, int to);
+    void point_changed(Task* task, int index);
+    void points_reset(Task* task);
+
+    //--------------------------------------------------------------------------
+    // Name:        insert_legs, remove_legs
+    // Description: Inserts or removes the legs to a range of points of a
+    //              task, shifting its edited legs and marking the legs that
+    //              now follow different points.
+    // Arguments:   - result: result of the task
+    //              - first: index of the first inserted or removed leg
+    //              - count: number of legs to insert or remove
+    //--------------------------------------------------------------------------
+    static void insert_legs(TaskResult& result, size_t first, size_t count);
+    static void remove_legs(TaskResult& result, size_t first, size_t count);
+
+    //--------------------------------------------------------------------------
+    // Name:        mark_legs
+    // Description: Marks a range of legs of a task to be driven on the next
+    //              update, along with the legs already marked.
+    // Arguments:   - result: result of the task
+    //              - begin: index of the first leg to mark
+    //              - end: index after the last leg to mark
+    //--------------------------------------------------------------------------
+    static void mark_legs(TaskResult& result, size_t begin, size_t end);
+
+    //--------------------------------------------------------------------------
+    // Name:        simulate
+    // Description: Simulates one task, reusing the legs of its previous
+    //              result that were not marked as edited.
+    // Arguments:   - input: task values
+    //              - start: vehicle state at the start of the task
+    //              - result: previous result of the task, which is updated
+    // Returns:     Number of legs that were driven.
+    //--------------------------------------------------------------------------
+    size_t simulate(const TaskInput& input, const State& start,
+                    TaskResult& result) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        simulate_edit
+    // Description: Simulates a task whose points or start state were edited by
+    //              driving only the legs that depend on the changes. The leg to
+    //              a waypoint depends on it and the two waypoints before it, and
+    //              only the first three legs depend on more of the start state
+    //              than the depth that the task's legs end at.
+    // Arguments:   - input: task values
+    //              - start: vehicle state at the start of the task
+    //              - result: previous result of the task, with the same values
+    //                other than the points, which is updated
+    // Returns:     Number of legs that were driven, or -1 if the legs that were
+    //              kept would change or the edit added points that are not
+    //              valid locations.
+    //--------------------------------------------------------------------------
+    int simulate_edit(const TaskInput& input, const State& start,
+                      TaskResult& result) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_leg_start
+    // Description: Gets the state of the vehicle before the leg to a point of
+    //              a task whose points are all valid locations.
+    // Arguments:   - input: task values
+    //              - start: vehicle state at the start of the task
+    //              - index: index of the point, or the number of points to
+    //                get the state at the end of the task
+    // Returns:     Vehicle state.
+    //--------------------------------------------------------------------------
+    State get_leg_start(const TaskInput& input, const State& start,
+                        size_t index) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        drive_leg
+    // Description: Gets the leg driving the vehicle to a waypoint, turning
+    //              onto it first and changing depth on the way.
+    // Arguments:   - input: values of the task that the waypoint belongs to
+    //              - state: vehicle state before the leg
+    //              - target: waypoint with longitude as x and latitude as y
+    // Returns:     Time and distance of the leg.
+    //--------------------------------------------------------------------------
+    Leg drive_leg(const TaskInput& input, const State& state, QPointF target) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        advance
+    // Description: Moves the vehicle state to the end of the leg to a
+    //              waypoint.
+    // Arguments:   - input: values of the task that the waypoint belongs to
+    //              - target: waypoint with longitude as x and latitude as y
+    //              - state: vehicle state, which is advanced to the waypoint
+    //--------------------------------------------------------------------------
+    static void advance(const TaskInput& input, QPointF target, State& state);
+
+};
+
+#endif // MISSION_ESTIMATOR_H
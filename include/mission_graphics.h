@@ -0,0 +1,342 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Map graphics for a vehicle's mission. The graphics of each
+//              task are kept between updates along with the points that
+//              they were drawn from, and an update only touches the graphics
+//              of points that changed. Moving a point moves its waypoint and
+//              the lines to its neighbours. Points inserted into, removed
+//              from or reordered within a path or zone task shift the drawn
+//              graphics at the edited index as the task signals the edit, so
+//              only the graphics of the edited points and their neighbours
+//              are touched.
+//
+//              Survey paths are only generated again when their zone's
+//              points, angle or swath width change. They are generated off
+//              the GUI thread and cached by their inputs, and the survey
+//              path task keeps its old points until its new path is ready.
+//
+//              The graphics have no symbols of their own. The overlay draws
+//              them with one renderer that picks a shared symbol by each
+//              graphic's kind attribute, and labels waypoints from their
+//              label attribute, so the symbols do not grow with the number
+//              of waypoints and recoloring the mission touches no graphic.
+//              Waypoint graphics also carry their task and point index as
+//              attributes, so they can be identified on the map no matter
+//              where they are in the overlay, and are kept in a graphic index
+//              so that they can be picked without a map view query.
+//==============================================================================
+
+#ifndef MISSION_GRAPHICS_H
+#define MISSION_GRAPHICS_H
+
+// QObject base class, which owns the graphics
+#include <QObject>
+
+// Mission graphics color
+#include <QColor>
+
+// Mission to draw
+#include "mission.h"
+
+// Spatial index of waypoint graphics for picking
+#include "graphic_index.h"
+
+// Background survey path generation
+#include "survey_generator.h"
+
+// ArcGIS includes
+#include <GraphicsOverlay.h>
+#include <Graphic.h>
+#include <SimpleLineSymbol.h>
+#include <UniqueValueRenderer.h>
+
+// C++ includes
+#include <map>
+#include <vector>
+
+using namespace Esri::ArcGISRuntime;
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+class MissionGraphics : public QObject
+{
+
+    Q_OBJECT
+
+signals:
+
+    //--------------------------------------------------------------------------
+    // Name:        surveyChanged
+    // Description: Signal that is emitted when a survey path finishes
+    //              generating or is written into its task, so that the
+    //              mission can be updated.
+    //--------------------------------------------------------------------------
+    void surveyChanged();
+
+public:
+
+    // Names of the graphic attributes holding the kind of graphic, which
+    // selects its symbol, and the waypoint label
+    static const char* KIND_ATTRIBUTE;
+    static const char* LABEL_ATTRIBUTE;
+
+    // Names of the waypoint graphic attributes holding the index of the
+    // waypoint's task in the mission and of the waypoint in its task
+    static const char* TASK_INDEX_ATTRIBUTE;
+    static const char* POINT_INDEX_ATTRIBUTE;
+
+    // Values of the kind attribute
+    static const char* WAYPOINT_KIND;
+    static const char* SEGMENT_KIND;
+    static const char* OUTLINE_KIND;
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        MissionGraphics constructor
+    // Description: Constructs mission graphics that draw into a graphics
+    //              overlay, with nothing drawn.
+    // Arguments:   - graphics_overlay: overlay to add the graphics to
+    //              - graphic_index: index to keep the visible waypoint
+    //                graphics in
+    //              - parent: parent QObject
+    //--------------------------------------------------------------------------
+    MissionGraphics(GraphicsOverlay* graphics_overlay, GraphicIndex* graphic_index,
+                    QObject* parent=nullptr);
+
+    //--------------------------------------------------------------------------
+    // Name:        MissionGraphics destructor
+    // Description: Default destructor.
+    //--------------------------------------------------------------------------
+    ~MissionGraphics();
+
+    //--------------------------------------------------------------------------
+    // Name:        update
+    // Description: Updates the graphics to match a mission, generating the
+    //              survey path of any zone task whose survey inputs changed.
+    // Arguments:   - mission: mission to draw
+    //--------------------------------------------------------------------------
+    void update(Mission* mission);
+
+    //--------------------------------------------------------------------------
+    // Name:        preview_point
+    // Description: Moves the graphics of one point of a drawn task without
+    //              looking at the rest of the mission. Only the point's
+    //              waypoint, the segments to its neighbours and its zone
+    //              outline are touched. The next update sees the point as
+    //              already drawn.
+    // Arguments:   - task: task that the point belongs to
+    //              - point_index: index of the point in the task
+    //              - location: new point location with longitude as x and
+    //                latitude as y
+    //--------------------------------------------------------------------------
+    void preview_point(Task* task, int point_index, QPointF location);
+
+    //--------------------------------------------------------------------------
+    // Name:        set_color
+    // Description: Sets the mission color.
+    // Arguments:   - color: mission color
+    //--------------------------------------------------------------------------
+    void set_color(QColor color);
+
+    //--------------------------------------------------------------------------
+    // Name:        clear
+    // Description: Removes every graphic.
+    //--------------------------------------------------------------------------
+    void clear();
+
+private:
+
+    // Graphics of one task and the values they were drawn from
+    struct TaskGraphics
+    {
+
+        // Task type and index in the mission when last drawn
+        TaskType::Value type;
+        int task_index = -1;
+
+        // Drawn points, and the waypoint graphic of each point. Segment i
+        // joins point i-1 to point i, so the first segment is always null
+        std::vector<QPointF> points;
+        std::vector<Graphic*> waypoint_graphics;
+        std::vector<Graphic*> segment_graphics;
+
+        // Zone outline graphic, only used by zone tasks
+        Graphic* outline_graphic = nullptr;
+
+        // Task that the survey path following a zone task was last written
+        // into, and the key of the inputs it was generated from
+        Task* survey_task = nullptr;
+        quint64 survey_key = 0;
+
+        // True if the task was found in the mission on this update
+        bool found = false;
+
+        // Connections to the task's point edit signals
+        std::vector<QMetaObject::Connection> connections;
+
+    };
+
+private:
+
+    // Overlay that the graphics are drawn in, and the index that visible
+    // waypoint graphics are kept in
+    GraphicsOverlay* graphics_overlay;
+    GraphicIndex* graphic_index;
+
+    // Mission color, the line symbols shared by every segment and zone
+    // outline graphic, and the renderer values that select each kind's
+    // symbol
+    QColor color = Qt::white;
+    SimpleLineSymbol* segment_symbol;
+    SimpleLineSymbol* outline_symbol;
+    UniqueValue* waypoint_value;
+    UniqueValue* segment_value;
+    UniqueValue* outline_value;
+
+    // Graphics of each drawn task
+    std::map<Task*, TaskGraphics> task_graphics;
+
+    // Generator and cache of survey paths
+    SurveyGenerator* survey_generator;
+
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        update_task
+    // Description: Updates the graphics of a task to match its points.
+    // Arguments:   - task: task to draw
+    //              - task_index: index of the task in the mission
+    //--------------------------------------------------------------------------
+    void update_task(Task* task, int task_index);
+
+    //--------------------------------------------------------------------------
+    // Name:        connect_task
+    // Description: Connects to a task's point edit signals so that its drawn
+    //              graphics are shifted as points are inserted, removed and
+    //              moved.
+    // Arguments:   - task: task to connect to
+    //              - graphics: graphics of the task
+    //--------------------------------------------------------------------------
+    void connect_task(Task* task, TaskGraphics& graphics);
+
+    //--------------------------------------------------------------------------
+    // Name:        insert_points
+    // Description: Inserts the graphics of points inserted into a drawn path
+    //              or zone task. Does nothing if the task is not drawn up to
+    //              the inserted points, leaving them to the next update.
+    // Arguments:   - task: task that the points were inserted into
+    //              - first: index of the first inserted point
+    //              - last: index of the last inserted point
+    //--------------------------------------------------------------------------
+    void insert_points(Task* task, int first, int last);
+
+    //--------------------------------------------------------------------------
+    // Name:        remove_points
+    // Description: Removes the graphics of points removed from a drawn path
+    //              or zone task. Does nothing if the task was not drawn with
+    //              the removed points, leaving them to the next update.
+    // Arguments:   - task: task that the points were removed from
+    //              - first: index of the first removed point
+    //              - last: index of the last removed point
+    //--------------------------------------------------------------------------
+    void remove_points(Task* task, int first, int last);
+
+    //--------------------------------------------------------------------------
+    // Name:        move_point
+    // Description: Moves the graphics of a point that moved to another index
+    //              of a drawn path or zone task.
+    // Arguments:   - task: task that the point moved in
+    //              - from: index of the point before it moved
+    //              - to: index of the point after it moved
+    //--------------------------------------------------------------------------
+    void move_point(Task* task, int from, int to);
+
+    //--------------------------------------------------------------------------
+    // Name:        redraw_points
+    // Description: Redraws the waypoints of a range of points after the
+    //              graphics were shifted, along with the segments joining
+    //              them to each other and to their neighbours, the zone
+    //              outline, and the labels and point indices of every
+    //              waypoint from the start of the range on.
+    // Arguments:   - graphics: graphics of the task
+    //              - begin: index of the first point to redraw
+    //              - end: index past the last point to redraw
+    //--------------------------------------------------------------------------
+    void redraw_points(TaskGraphics& graphics, size_t begin, size_t end);
+
+    //--------------------------------------------------------------------------
+    // Name:        update_survey
+    // Description: Writes the survey path of a zone task into the task that
+    //              follows it if the zone's survey inputs changed and the
+    //              path has been generated, and starts generating it if it
+    //              has not.
+    // Arguments:   - zone_task: zone task
+    //              - path_task: task to hold the survey path
+    //--------------------------------------------------------------------------
+    void update_survey(Task* zone_task, Task* path_task);
+
+    //--------------------------------------------------------------------------
+    // Name:        update_points
+    // Description: Updates the waypoint and segment graphics of a task to
+    //              match a list of points, only touching the graphics of
+    //              changed points.
+    // Arguments:   - graphics: graphics of the task
+    //              - points: points to draw
+    //              - label_prefix: text before each waypoint's number
+    //              - connect: true to join the points with segments
+    // Returns:     True if any point changed.
+    //--------------------------------------------------------------------------
+    bool update_points(TaskGraphics& graphics, const std::vector<QPointF>& points,
+                       QString label_prefix, bool connect);
+
+    //--------------------------------------------------------------------------
+    // Name:        update_waypoint
+    // Description: Moves the waypoint graphic of a point to its drawn
+    //              location, creating it if needed, and hides it if the point
+    //              has no location.
+    // Arguments:   - graphics: graphics of the task
+    //              - index: index of the point
+    //              - label_prefix: text before the waypoint's number
+    //--------------------------------------------------------------------------
+    void update_waypoint(TaskGraphics& graphics, size_t index, QString label_prefix);
+
+    //--------------------------------------------------------------------------
+    // Name:        update_outline
+    // Description: Redraws the outline of a zone task through its drawn
+    //              points.
+    // Arguments:   - graphics: graphics of the zone task
+    //--------------------------------------------------------------------------
+    void update_outline(TaskGraphics& graphics);
+
+    //--------------------------------------------------------------------------
+    // Name:        update_segment
+    // Description: Redraws the segment joining a point to the point before
+    //              it, hiding it if either point has no location.
+    // Arguments:   - graphics: graphics of the task
+    //              - index: index of the point that the segment ends at
+    //--------------------------------------------------------------------------
+    void update_segment(TaskGraphics& graphics, size_t index);
+
+    //--------------------------------------------------------------------------
+    // Name:        remove_task_graphics
+    // Description: Removes every graphic of a task and disconnects from the
+    //              task's point edit signals.
+    // Arguments:   - graphics: graphics of the task
+    //--------------------------------------------------------------------------
+    void remove_task_graphics(TaskGraphics& graphics);
+
+    //--------------------------------------------------------------------------
+    // Name:        remove_graphic
+    // Description: Removes a graphic from the overlay and the graphic index
+    //              and deletes it. Does nothing if the graphic is null.
+    // Arguments:   - graphic: graphic to remove
+    //--------------------------------------------------------------------------
+    void remove_graphic(Graphic* graphic);
+
+};
+
+#endif // MISSION_GRAPHICS_H
@@ -0,0 +1,305 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Flight recorder for raw vehicle traffic. Every buffer that is
+//              received from or sent to a vehicle is appended, with its
+//              timestamp, interface, peer address and direction, to a pcapng
+//              file that can be opened in Wireshark or replayed later.
+//
+//              Recording is split between the caller and a background
+//              writer thread so that the cost on the ingest path is a single
+//              copy into a preallocated buffer. The writer thread swaps that
+//              buffer with a second preallocated buffer, formats the records
+//              as pcapng blocks and writes them to disk. Files are rotated
+//              when they reach a maximum size, and only the most recent
+//              files are kept.
+//
+//              Each record is stored as an enhanced packet block on one of
+//              two interfaces, one for the UDP multicast status traffic and
+//              one for the TCP vehicle connections, with the link type set
+//              to LINKTYPE_USER0 since the payloads are raw AVL packets.
+//              The direction is stored in the epb_flags option and the peer
+//              address in the opt_comment option.
+//==============================================================================
+
+#ifndef PACKET_RECORDER_H
+#define PACKET_RECORDER_H
+
+// C++ includes
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+class PacketRecorder
+{
+
+public:
+
+    // Interfaces that traffic is recorded on. The values are the pcapng
+    // interface IDs
+    enum Interface
+    {
+        INTERFACE_UDP = 0,
+        INTERFACE_TCP = 1,
+        NUM_INTERFACES
+    };
+
+    // Direction of a recorded buffer relative to this application
+    enum Direction
+    {
+        DIRECTION_IN,
+        DIRECTION_OUT
+    };
+
+    // Default size of each of the two record buffers in bytes
+    static const size_t DEFAULT_BUFFER_SIZE = 4 * 1024 * 1024;
+
+    // Default file size in bytes at which a new file is started
+    static const size_t DEFAULT_MAX_FILE_SIZE = 64 * 1024 * 1024;
+
+    // Default number of files to keep before the oldest is deleted
+    static const size_t DEFAULT_MAX_FILES = 16;
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        PacketRecorder constructor
+    // Description: Constructs a stopped recorder and allocates both record
+    //              buffers.
+    // Arguments:   - buffer_size: size of each record buffer in bytes
+    //              - max_file_size: file size in bytes at which a new file
+    //                is started
+    //              - max_files: number of files to keep, or 0 to keep every
+    //                file
+    //--------------------------------------------------------------------------
+    PacketRecorder(size_t buffer_size = DEFAULT_BUFFER_SIZE,
+                   size_t max_file_size = DEFAULT_MAX_FILE_SIZE,
+                   size_t max_files = DEFAULT_MAX_FILES);
+
+    //--------------------------------------------------------------------------
+    // Name:        PacketRecorder destructor
+    // Description: Stops the recorder, writing any buffered records.
+    //--------------------------------------------------------------------------
+    virtual ~PacketRecorder();
+
+    //--------------------------------------------------------------------------
+    // Name:        start
+    // Description: Opens the first file and starts the writer thread. Files
+    //              are named with the prefix followed by a file number and
+    //              the .pcapng extension. Throws a std::runtime_error if the
+    //              recorder is already running or the file cannot be
+    //              opened.
+    // Arguments:   - file_prefix: path and file name prefix of the files
+    //--------------------------------------------------------------------------
+    void start(const std::string& file_prefix);
+
+    //--------------------------------------------------------------------------
+    // Name:        stop
+    // Description: Stops the writer thread after it has written all buffered
+    //              records and closes the current file. Does nothing if the
+    //              recorder is not running.
+    //--------------------------------------------------------------------------
+    void stop();
+
+    //--------------------------------------------------------------------------
+    // Name:        is_running
+    // Description: Checks whether the recorder is running.
+    // Returns:     True if the recorder is running, false otherwise.
+    //--------------------------------------------------------------------------
+    bool is_running();
+
+    //--------------------------------------------------------------------------
+    // Name:        record
+    // Description: Records a buffer with the current time as its timestamp.
+    //              The buffer is copied, so it does not need to outlive the
+    //              call. If the record buffer is full the buffer is dropped
+    //              and counted instead of blocking the caller. Does nothing
+    //              if the recorder is not running.
+    // Arguments:   - interface: interface the buffer was received or sent on
+    //              - direction: direction of the buffer
+    //              - peer_address: IPv4 address of the peer in host byte
+    //                order
+    //              - peer_port: port of the peer
+    //              - data: pointer to the buffer
+    //              - size: number of bytes in the buffer
+    //--------------------------------------------------------------------------
+    void record(Interface interface, Direction direction, uint32_t peer_address,
+                uint16_t peer_port, const void* data, size_t size);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_num_recorded
+    // Description: Gets the number of buffers that have been recorded.
+    // Returns:     Number of recorded buffers.
+    //--------------------------------------------------------------------------
+    uint64_t get_num_recorded();
+
+    //--------------------------------------------------------------------------
+    // Name:        get_num_dropped
+    // Description: Gets the number of buffers that were dropped because the
+    //              record buffer was full or a file could not be written.
+    // Returns:     Number of dropped buffers.
+    //--------------------------------------------------------------------------
+    uint64_t get_num_dropped();
+
+    //--------------------------------------------------------------------------
+    // Name:        get_file_name
+    // Description: Gets the name of the file currently being written.
+    // Returns:     Current file name, or an empty string if the recorder is
+    //              not running.
+    //--------------------------------------------------------------------------
+    std::string get_file_name();
+
+private:
+
+    // Fixed size header stored in front of each buffer's bytes in the record
+    // buffer. The writer thread turns each header and its bytes into an
+    // enhanced packet block
+    struct RecordHeader
+    {
+        int64_t time_us;
+        uint32_t size;
+        uint32_t peer_address;
+        uint16_t peer_port;
+        uint8_t interface;
+        uint8_t direction;
+    };
+
+private:
+
+    // Size limits
+    size_t buffer_size;
+    size_t max_file_size;
+    size_t max_files;
+
+    // Record buffer filled by callers, and the buffer being written by the
+    // writer thread. Both are allocated once and swapped
+    std::vector<uint8_t> front_buffer;
+    std::vector<uint8_t> back_buffer;
+
+    // Guards the front buffer, the counters and the running flags
+    std::mutex mutex;
+    std::condition_variable buffer_ready;
+
+    // Running flags. The stop flag tells the writer thread to write the
+    // remaining records and exit
+    bool running = false;
+    bool stop_requested = false;
+
+    // Counters
+    uint64_t num_recorded = 0;
+    uint64_t num_dropped = 0;
+
+    // Writer thread
+    std::thread writer_thread;
+
+    // Current file, its size, and the files written so far. Only used by
+    // the writer thread while it is running
+    std::FILE* file = nullptr;
+    size_t file_size = 0;
+    std::string file_prefix;
+    std::string file_name;
+    size_t file_number = 0;
+    std::deque<std::string> file_names;
+
+    // Block bytes built by the writer thread, kept to reuse its storage
+    std::vector<uint8_t> block;
+
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        writer_loop
+    // Description: Writer thread function. Waits for records, swaps the
+    //              record buffers and writes the records to file until the
+    //              recorder is stopped.
+    //--------------------------------------------------------------------------
+    void writer_loop();
+
+    //--------------------------------------------------------------------------
+    // Name:        write_records
+    // Description: Writes every record in the back buffer to file, rotating
+    //              the file when it reaches the maximum size.
+    // Arguments:   - num_written: set to the number of records written
+    //              - num_failed: set to the number of records that could not
+    //                be written
+    //--------------------------------------------------------------------------
+    void write_records(uint64_t& num_written, uint64_t& num_failed);
+
+    //--------------------------------------------------------------------------
+    // Name:        open_file
+    // Description: Closes the current file, opens the next file and writes
+    //              the section header and interface description blocks.
+    //              Deletes the oldest file if there are too many files.
+    // Returns:     True if the file was opened, false otherwise.
+    //--------------------------------------------------------------------------
+    bool open_file();
+
+    //--------------------------------------------------------------------------
+    // Name:        close_file
+    // Description: Closes the current file if one is open.
+    //--------------------------------------------------------------------------
+    void close_file();
+
+    //--------------------------------------------------------------------------
+    // Name:        write_block
+    // Description: Writes the block bytes to the current file.
+    // Returns:     True if the block was written, false otherwise.
+    //--------------------------------------------------------------------------
+    bool write_block();
+
+    //--------------------------------------------------------------------------
+    // Name:        begin_block
+    // Description: Clears the block bytes and adds the header of a block.
+    //              The block length is filled in by end_block.
+    // Arguments:   - type: pcapng block type
+    //--------------------------------------------------------------------------
+    void begin_block(uint32_t type);
+
+    //--------------------------------------------------------------------------
+    // Name:        end_block
+    // Description: Adds the trailing block length and fills in the leading
+    //              block length.
+    //--------------------------------------------------------------------------
+    void end_block();
+
+    //--------------------------------------------------------------------------
+    // Name:        add_bytes
+    // Description: Adds bytes to the block, padded to a multiple of four
+    //              bytes.
+    // Arguments:   - data: pointer to the bytes
+    //              - size: number of bytes
+    //--------------------------------------------------------------------------
+    void add_bytes(const void* data, size_t size);
+
+    //--------------------------------------------------------------------------
+    // Name:        add_option
+    // Description: Adds an option to the block.
+    // Arguments:   - code: pcapng option code
+    //              - data: pointer to the option value
+    //              - size: number of bytes in the option value
+    //--------------------------------------------------------------------------
+    void add_option(uint16_t code, const void* data, size_t size);
+
+    //--------------------------------------------------------------------------
+    // Name:        add_value
+    // Description: Adds a value to the block in host byte order.
+    // Arguments:   - value: value to add
+    //--------------------------------------------------------------------------
+    template <typename T>
+    void add_value(T value)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        block.insert(block.end(), bytes, bytes + sizeof(T));
+    }
+
+};
+
+#endif // PACKET_RECORDER_H
@@ -39,6 +39,28 @@ struct param
 class Params : public QObject
 {
     Q_OBJECT
+
+signals:
+
+    //--------------------------------------------------------------------------
+    // Name:        paramsAboutToBeInserted, paramsInserted
+    // Description: Signals emitted before and after parameters are inserted,
+    //              so that models showing the list can update only their rows.
+    // Arguments:   - first: index of the first inserted parameter
+    //              - last: index of the last inserted parameter
+    //--------------------------------------------------------------------------
+    void paramsAboutToBeInserted(int first, int last);
+    void paramsInserted(int first, int last);
+
+    //--------------------------------------------------------------------------
+    // Name:        paramsAboutToBeRemoved, paramsRemoved
+    // Description: Signals emitted before and after parameters are removed.
+    // Arguments:   - first: index of the first removed parameter
+    //              - last: index of the last removed parameter
+    //--------------------------------------------------------------------------
+    void paramsAboutToBeRemoved(int first, int last);
+    void paramsRemoved(int first, int last);
+
 public:
     //--------------------------------------------------------------------------
     // Name:        Params constructor
@@ -84,6 +84,13 @@ public:
     //--------------------------------------------------------------------------
     virtual QHash<int, QByteArray> roleNames() const override;
 
+    //--------------------------------------------------------------------------
+    // Name:        set_params
+    // Description: Sets the parameter list that should be displayed.
+    // Arguments:   - params: pointer to the parameter list to display
+    //--------------------------------------------------------------------------
+    void set_params(Params* params);
+
     //--------------------------------------------------------------------------
     // Name:        redraw
     // Description: Redraws the mission data model.
@@ -0,0 +1,192 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Compact history of a vehicle's locations, stored as a struct
+//              of arrays in a ring buffer. Each sample holds a timestamp,
+//              location, yaw and depth in 18 bytes:
+//
+//              - latitude and longitude as int32 fixed point in units of
+//                1e-7 degrees, about 1 cm
+//              - time as uint32 milliseconds since the first sample after
+//                the history was cleared, which covers 49 days
+//              - yaw as uint16 hundredths of a degree in [0, 360)
+//              - depth as a float in meters
+//
+//              Samples are converted to doubles only when they are read, so
+//              the history holds no geometry. Storage grows as samples are
+//              appended up to the capacity, after which the oldest sample is
+//              overwritten.
+//
+//              Samples are addressed by their sequence index, counted from
+//              the first sample appended since the history was cleared, so a
+//              sample keeps its index when older samples are overwritten.
+//==============================================================================
+
+#ifndef PATH_HISTORY_H
+#define PATH_HISTORY_H
+
+// C++ includes
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+class PathHistory
+{
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        PathHistory constructor
+    // Description: Constructs an empty history. Throws a std::runtime_error if
+    //              the capacity is zero.
+    // Arguments:   - capacity: maximum number of samples stored
+    //--------------------------------------------------------------------------
+    PathHistory(size_t capacity);
+
+    //--------------------------------------------------------------------------
+    // Name:        PathHistory destructor
+    // Description: Default destructor.
+    //--------------------------------------------------------------------------
+    virtual ~PathHistory();
+
+    //--------------------------------------------------------------------------
+    // Name:        append
+    // Description: Appends a sample, overwriting the oldest sample if the
+    //              history is full. A timestamp older than the newest
+    //              sample is replaced with the newest sample's.
+    // Arguments:   - time: sample time in seconds
+    //              - lat: latitude in degrees
+    //              - lon: longitude in degrees
+    //              - yaw: yaw in degrees
+    //              - depth: depth in meters
+    //--------------------------------------------------------------------------
+    void append(double time, double lat, double lon, double yaw, double depth);
+
+    //--------------------------------------------------------------------------
+    // Name:        clear
+    // Description: Removes all samples and releases their storage.
+    //--------------------------------------------------------------------------
+    void clear();
+
+    //--------------------------------------------------------------------------
+    // Name:        size
+    // Description: Gets the number of stored samples.
+    // Returns:     Number of stored samples.
+    //--------------------------------------------------------------------------
+    size_t size() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        capacity
+    // Description: Gets the maximum number of samples that can be stored.
+    // Returns:     History capacity in samples.
+    //--------------------------------------------------------------------------
+    size_t capacity() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_first_index
+    // Description: Gets the sequence index of the oldest stored sample.
+    // Returns:     Sequence index of the oldest sample.
+    //--------------------------------------------------------------------------
+    uint64_t get_first_index() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_end_index
+    // Description: Gets the sequence index that the next sample will have,
+    //              which is one past the newest stored sample.
+    // Returns:     Sequence index of the next sample.
+    //--------------------------------------------------------------------------
+    uint64_t get_end_index() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_time
+    // Description: Gets the time of a sample. Throws a std::runtime_error if
+    //              the sample is not stored.
+    // Arguments:   - index: sequence index of the sample
+    // Returns:     Sample time in seconds.
+    //--------------------------------------------------------------------------
+    double get_time(uint64_t index) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_lat
+    // Description: Gets the latitude of a sample. Throws a std::runtime_error
+    //              if the sample is not stored.
+    // Arguments:   - index: sequence index of the sample
+    // Returns:     Latitude in degrees.
+    //--------------------------------------------------------------------------
+    double get_lat(uint64_t index) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_lon
+    // Description: Gets the longitude of a sample. Throws a std::runtime_error
+    //              if the sample is not stored.
+    // Arguments:   - index: sequence index of the sample
+    // Returns:     Longitude in degrees.
+    //--------------------------------------------------------------------------
+    double get_lon(uint64_t index) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_yaw
+    // Description: Gets the yaw of a sample. Throws a std::runtime_error if
+    //              the sample is not stored.
+    // Arguments:   - index: sequence index of the sample
+    // Returns:     Yaw in degrees in [0, 360).
+    //--------------------------------------------------------------------------
+    double get_yaw(uint64_t index) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_depth
+    // Description: Gets the depth of a sample. Throws a std::runtime_error if
+    //              the sample is not stored.
+    // Arguments:   - index: sequence index of the sample
+    // Returns:     Depth in meters.
+    //--------------------------------------------------------------------------
+    double get_depth(uint64_t index) const;
+
+private:
+
+    // Fixed point scales of the stored location, time and yaw
+    static constexpr double DEGREES_SCALE = 1.0e7;
+    static constexpr double MILLISECONDS_SCALE = 1000.0;
+    static constexpr double YAW_SCALE = 100.0;
+
+private:
+
+    // Maximum number of samples
+    size_t max_samples;
+
+    // Ring buffer slot of the oldest sample, the number of samples, and the
+    // sequence index of the next sample
+    size_t head = 0;
+    size_t count = 0;
+    uint64_t end_index = 0;
+
+    // Time in seconds that stored times are counted from, and the newest
+    // stored time
+    double time_origin = 0.0;
+    uint32_t last_time = 0;
+
+    // Sample ring buffers
+    std::vector<int32_t> lats;
+    std::vector<int32_t> lons;
+    std::vector<uint32_t> times;
+    std::vector<uint16_t> yaws;
+    std::vector<float> depths;
+
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        get_slot
+    // Description: Converts a sequence index to a ring buffer slot. Throws a
+    //              std::runtime_error if the sample is not stored.
+    // Arguments:   - index: sequence index of the sample
+    // Returns:     Ring buffer slot.
+    //--------------------------------------------------------------------------
+    size_t get_slot(uint64_t index) const;
+
+};
+
+#endif // PATH_HISTORY_H
@@ -162,6 +162,19 @@ public:
     //--------------------------------------------------------------------------
     Q_INVOKABLE void append_point(double lat, double lon, ActionType::Value command);
 
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        number_rows
+    // Description: Updates the point number column of a range of rows, whose
+    //              numbers change when rows are inserted, removed or moved
+    //              before them.
+    // Arguments:   - first: first row whose number changed
+    //              - last: last row whose number changed, or -1 for the last
+    //                row in the table
+    //--------------------------------------------------------------------------
+    void number_rows(int first, int last=-1);
+
 };
 
 #endif // POINTS_DATA_MODEL_H
@@ -0,0 +1,179 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Schedules display updates at a fixed frame rate instead of on
+//              every received packet. Updates are recorded as dirty flags
+//              per vehicle, and repeated updates to the same vehicle between
+//              frames are merged, so a burst of packets costs one redraw per
+//              vehicle per frame no matter how many packets it contains.
+//
+//              Each frame redraws dirty vehicles until its time budget is
+//              spent, and the rest are redrawn first on the next frame. The
+//              budget adapts to the frame rate the event loop actually
+//              achieves: it is halved when frames arrive late and grows back
+//              slowly while they arrive on time.
+//==============================================================================
+
+#ifndef RENDER_SCHEDULER_H
+#define RENDER_SCHEDULER_H
+
+// QObject base class
+#include <QObject>
+
+// Frame timing
+#include <QTimer>
+#include <QElapsedTimer>
+
+// Dirty flag storage
+#include <QHash>
+
+// C++ includes
+#include <deque>
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+class RenderScheduler : public QObject
+{
+
+    Q_OBJECT
+
+signals:
+
+    //--------------------------------------------------------------------------
+    // Name:        renderRequested
+    // Description: Signal that is emitted once per frame for each vehicle
+    //              with a pending update.
+    // Arguments:   - vehicle_id: ID of the vehicle to redraw
+    //              - flags: bitwise OR of the dirty flags set since the
+    //                vehicle was last redrawn
+    //--------------------------------------------------------------------------
+    void renderRequested(int vehicle_id, int flags);
+
+public:
+
+    // Parts of a vehicle's display that can be out of date
+    enum DirtyFlag
+    {
+        DIRTY_PATH =     0x01,
+        DIRTY_ICON =     0x02,
+        DIRTY_MISSION =  0x04,
+        DIRTY_ROW =      0x08,
+        DIRTY_STATUS =   0x10,
+        DIRTY_DRAG =     0x20
+    };
+
+    // Range and default of the frame rate in Hz
+    static const int MIN_FRAME_RATE = 10;
+    static const int MAX_FRAME_RATE = 30;
+    static const int DEFAULT_FRAME_RATE = 20;
+
+    // Fraction of the frame period that a frame may spend redrawing, and
+    // the smallest budget in milliseconds that it is reduced to
+    static constexpr double MAX_BUDGET_FRACTION = 0.5;
+    static constexpr double MIN_BUDGET_MS = 2.0;
+
+    // Frame interval, as a multiple of the frame period, above which a frame
+    // counts as late and the budget is halved
+    static constexpr double LATE_FRAME_FACTOR = 1.5;
+
+    // Budget increase in milliseconds after each frame that is on time
+    static constexpr double BUDGET_INCREASE_MS = 0.5;
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        RenderScheduler constructor
+    // Description: Constructs the scheduler at the default frame rate with
+    //              nothing to redraw.
+    // Arguments:   - parent: parent QObject
+    //--------------------------------------------------------------------------
+    RenderScheduler(QObject* parent=nullptr);
+
+    //--------------------------------------------------------------------------
+    // Name:        RenderScheduler destructor
+    // Description: Default destructor.
+    //--------------------------------------------------------------------------
+    ~RenderScheduler();
+
+    //--------------------------------------------------------------------------
+    // Name:        mark_dirty
+    // Description: Records that part of a vehicle's display is out of date.
+    //              The vehicle is redrawn on one of the following frames.
+    // Arguments:   - vehicle_id: ID of the vehicle
+    //              - flags: bitwise OR of dirty flags
+    //--------------------------------------------------------------------------
+    void mark_dirty(int vehicle_id, int flags);
+
+    //--------------------------------------------------------------------------
+    // Name:        flush
+    // Description: Redraws every dirty vehicle now, ignoring the budget.
+    //--------------------------------------------------------------------------
+    void flush();
+
+    //--------------------------------------------------------------------------
+    // Name:        set_frame_rate
+    // Description: Sets the frame rate, limited to the supported range.
+    // Arguments:   - frame_rate: frame rate in Hz
+    //--------------------------------------------------------------------------
+    void set_frame_rate(int frame_rate);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_frame_rate
+    // Description: Gets the frame rate.
+    // Returns:     Frame rate in Hz.
+    //--------------------------------------------------------------------------
+    int get_frame_rate() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_budget
+    // Description: Gets the current redraw time budget of a frame.
+    // Returns:     Budget in milliseconds.
+    //--------------------------------------------------------------------------
+    double get_budget() const;
+
+private:
+
+    // Frame timer, which only runs while a vehicle is dirty, and the time
+    // since the last frame
+    QTimer* frame_timer;
+    QElapsedTimer frame_interval_timer;
+
+    // Frame rate in Hz and redraw time budget in milliseconds
+    int frame_rate = DEFAULT_FRAME_RATE;
+    double budget;
+
+    // Dirty flags of each dirty vehicle, and the dirty vehicles in the order
+    // that they are redrawn
+    QHash<int, int> dirty_flags;
+    std::deque<int> dirty_order;
+
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        get_frame_period
+    // Description: Gets the frame period.
+    // Returns:     Frame period in milliseconds.
+    //--------------------------------------------------------------------------
+    double get_frame_period() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        render_next
+    // Description: Redraws the dirty vehicle that has waited the longest.
+    //--------------------------------------------------------------------------
+    void render_next();
+
+private slots:
+
+    //--------------------------------------------------------------------------
+    // Name:        frame_timer_timeout
+    // Description: Slot that is called on each frame. Adapts the budget to
+    //              the frame interval and redraws dirty vehicles until the
+    //              budget is spent.
+    //--------------------------------------------------------------------------
+    void frame_timer_timeout();
+
+};
+
+#endif // RENDER_SCHEDULER_H
@@ -0,0 +1,226 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Replays recorded vehicle traffic into the vehicle manager as
+//              if the vehicles were live. Recorded UDP datagrams go through
+//              the same parsing as live status datagrams and recorded TCP
+//              data through the same parsing as live vehicle connection
+//              data, so a replay exercises the whole path from ingest to
+//              rendering.
+//
+//              Replay can be paused, seeked and run at a speed multiple of
+//              real time. A speed of zero replays as fast as possible, in
+//              batches that leave the event loop free to render between
+//              them.
+//==============================================================================
+
+#ifndef REPLAY_ENGINE_H
+#define REPLAY_ENGINE_H
+
+// QObject base class
+#include <QObject>
+
+// Replay timing
+#include <QTimer>
+#include <QElapsedTimer>
+
+// Vehicle manager to replay into
+#include "vehicle_manager.h"
+
+// Recorded traffic
+#include "replay_log.h"
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+class ReplayEngine : public QObject
+{
+
+    Q_OBJECT
+
+signals:
+
+    //--------------------------------------------------------------------------
+    // Name:        replayLoaded
+    // Description: Signal that is emitted when a replay file is loaded.
+    // Arguments:   - duration: replay duration in seconds
+    //              - num_events: number of recorded buffers to replay
+    //--------------------------------------------------------------------------
+    void replayLoaded(double duration, int num_events);
+
+    //--------------------------------------------------------------------------
+    // Name:        playingChanged
+    // Description: Signal that is emitted when replay starts or stops.
+    // Arguments:   - playing: true if replay is playing, false otherwise
+    //--------------------------------------------------------------------------
+    void playingChanged(bool playing);
+
+    //--------------------------------------------------------------------------
+    // Name:        positionChanged
+    // Description: Signal that is emitted when the replay position changes.
+    // Arguments:   - position: seconds from the start of the replay
+    //--------------------------------------------------------------------------
+    void positionChanged(double position);
+
+    //--------------------------------------------------------------------------
+    // Name:        replayFinished
+    // Description: Signal that is emitted when the last event is replayed.
+    //--------------------------------------------------------------------------
+    void replayFinished();
+
+public:
+
+    // Interval between replay timer ticks in milliseconds when replaying in
+    // real time or a multiple of it
+    static const int TICK_INTERVAL_MS = 10;
+
+    // Maximum number of events replayed in one timer tick, so that the
+    // event loop stays responsive at high speeds
+    static const size_t MAX_EVENTS_PER_TICK = 2000;
+
+    // Speed value that replays as fast as possible
+    static constexpr double SPEED_UNLIMITED = 0.0;
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        ReplayEngine constructor
+    // Description: Constructs a replay engine that replays into a vehicle
+    //              manager.
+    // Arguments:   - vehicle_manager: pointer to the vehicle manager
+    //              - parent: parent QObject
+    //--------------------------------------------------------------------------
+    ReplayEngine(VehicleManager* vehicle_manager, QObject* parent=nullptr);
+
+    //--------------------------------------------------------------------------
+    // Name:        ReplayEngine destructor
+    // Description: Default destructor.
+    //--------------------------------------------------------------------------
+    ~ReplayEngine();
+
+    //--------------------------------------------------------------------------
+    // Name:        load
+    // Description: Stops any replay and loads a replay file. Files with the
+    //              .pcapng extension are loaded as packet captures and any
+    //              other file as an AVL text log.
+    // Arguments:   - file_path: path or file URL of the replay file
+    //              - vehicle_id: vehicle ID given to statuses from an AVL
+    //                text log, which does not contain one
+    // Returns:     True if the file was loaded, false otherwise.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE bool load(QString file_path, int vehicle_id);
+
+    //--------------------------------------------------------------------------
+    // Name:        play
+    // Description: Starts or resumes replay from the current position. Does
+    //              nothing if there is nothing left to replay.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE void play();
+
+    //--------------------------------------------------------------------------
+    // Name:        pause
+    // Description: Pauses replay at the current position.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE void pause();
+
+    //--------------------------------------------------------------------------
+    // Name:        stop
+    // Description: Stops replay and moves back to the start of the replay.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE void stop();
+
+    //--------------------------------------------------------------------------
+    // Name:        seek
+    // Description: Moves the replay position. Events before the new position
+    //              are skipped, and replay continues from the first event at
+    //              or after it.
+    // Arguments:   - position: seconds from the start of the replay
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE void seek(double position);
+
+    //--------------------------------------------------------------------------
+    // Name:        set_speed
+    // Description: Sets the replay speed as a multiple of real time.
+    // Arguments:   - speed: speed multiplier, or SPEED_UNLIMITED to replay
+    //                as fast as possible
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE void set_speed(double speed);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_speed
+    // Description: Gets the replay speed.
+    // Returns:     Speed multiplier, or SPEED_UNLIMITED.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE double get_speed();
+
+    //--------------------------------------------------------------------------
+    // Name:        is_playing
+    // Description: Checks whether replay is playing.
+    // Returns:     True if replay is playing, false otherwise.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE bool is_playing();
+
+    //--------------------------------------------------------------------------
+    // Name:        get_position
+    // Description: Gets the replay position.
+    // Returns:     Seconds from the start of the replay.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE double get_position();
+
+    //--------------------------------------------------------------------------
+    // Name:        get_duration
+    // Description: Gets the replay duration.
+    // Returns:     Seconds from the first to the last event.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE double get_duration();
+
+private:
+
+    // Vehicle manager that events are replayed into
+    VehicleManager* vehicle_manager;
+
+    // Loaded events and the index of the next one to replay
+    ReplayLog replay_log;
+    size_t next_event = 0;
+
+    // Replay position in seconds from the first event, and the position
+    // and wall clock time at which the replay clock was last anchored
+    double position = 0.0;
+    double anchor_position = 0.0;
+    QElapsedTimer anchor_timer;
+
+    // Speed multiplier
+    double speed = 1.0;
+
+    // Timer that drives replay
+    QTimer replay_timer;
+
+private slots:
+
+    //--------------------------------------------------------------------------
+    // Name:        replay_timer_timeout
+    // Description: Slot that is called on each replay timer tick. Replays the
+    //              events up to the current replay time.
+    //--------------------------------------------------------------------------
+    void replay_timer_timeout();
+
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        anchor_clock
+    // Description: Restarts the replay clock from the current position, so
+    //              that speed changes and seeks take effect from now.
+    //--------------------------------------------------------------------------
+    void anchor_clock();
+
+    //--------------------------------------------------------------------------
+    // Name:        replay_event
+    // Description: Feeds an event into the vehicle manager.
+    // Arguments:   - event: event to replay
+    //--------------------------------------------------------------------------
+    void replay_event(const ReplayLog::Event& event);
+
+};
+
+#endif // REPLAY_ENGINE_H
@@ -0,0 +1,183 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Recorded vehicle traffic loaded for replay. Traffic can be
+//              loaded from a pcapng capture, either written by the packet
+//              recorder or captured with Wireshark on an Ethernet interface,
+//              or from an AVL text log, whose status data lines are turned
+//              back into STATUS packets.
+//
+//              Only traffic received from vehicles is kept, as time ordered
+//              events that carry the raw bytes and the interface they
+//              arrived on so that they can be fed back into the same parsing
+//              code as live traffic.
+//==============================================================================
+
+#ifndef REPLAY_LOG_H
+#define REPLAY_LOG_H
+
+// Interface enum
+#include "packet_recorder.h"
+
+// C++ includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+class ReplayLog
+{
+
+public:
+
+    // Received buffer to be replayed
+    struct Event
+    {
+        double time;
+        PacketRecorder::Interface interface;
+        uint32_t peer_address;
+        std::vector<uint8_t> data;
+    };
+
+    // UDP port that vehicles send status datagrams to. Used to pick the AVL
+    // traffic out of Ethernet captures
+    static const uint16_t STATUS_PORT = 1338;
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        ReplayLog constructor
+    // Description: Constructs an empty replay log.
+    //--------------------------------------------------------------------------
+    ReplayLog();
+
+    //--------------------------------------------------------------------------
+    // Name:        ReplayLog destructor
+    // Description: Default destructor.
+    //--------------------------------------------------------------------------
+    virtual ~ReplayLog();
+
+    //--------------------------------------------------------------------------
+    // Name:        load_pcapng
+    // Description: Replaces the events with the received traffic in a pcapng
+    //              file. Packet recorder captures are replayed on the
+    //              interface they were recorded on. Ethernet captures are
+    //              searched for IPv4 UDP datagrams sent to the status port.
+    //              Packets on other link types are skipped. Throws a
+    //              std::runtime_error if the file cannot be read or is not a
+    //              valid pcapng file.
+    // Arguments:   - file_path: path to the pcapng file
+    //--------------------------------------------------------------------------
+    void load_pcapng(const std::string& file_path);
+
+    //--------------------------------------------------------------------------
+    // Name:        load_avl_log
+    // Description: Replaces the events with STATUS packets built from the
+    //              data lines of an AVL text log. The first two data lines
+    //              of each tag hold the labels and units of the values in
+    //              the following lines, and values are matched to status
+    //              fields by their label. The tag selects the comms channel
+    //              of the packet. Throws a std::runtime_error if the file
+    //              cannot be read.
+    // Arguments:   - file_path: path to the log file
+    //              - vehicle_id: vehicle ID to give the STATUS packets
+    //--------------------------------------------------------------------------
+    void load_avl_log(const std::string& file_path, int vehicle_id);
+
+    //--------------------------------------------------------------------------
+    // Name:        clear
+    // Description: Removes all events.
+    //--------------------------------------------------------------------------
+    void clear();
+
+    //--------------------------------------------------------------------------
+    // Name:        size
+    // Description: Gets the number of events.
+    // Returns:     Number of events.
+    //--------------------------------------------------------------------------
+    size_t size() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_event
+    // Description: Gets an event. Throws a std::runtime_error if the index is
+    //              out of range.
+    // Arguments:   - index: event index, in time order
+    // Returns:     Event at the index.
+    //--------------------------------------------------------------------------
+    const Event& get_event(size_t index) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_start_time
+    // Description: Gets the time of the first event.
+    // Returns:     Time of the first event in seconds, or 0 if there are no
+    //              events.
+    //--------------------------------------------------------------------------
+    double get_start_time() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_duration
+    // Description: Gets the time from the first event to the last event.
+    // Returns:     Duration in seconds, or 0 if there are no events.
+    //--------------------------------------------------------------------------
+    double get_duration() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        find_event
+    // Description: Finds the first event at or after a time using a binary
+    //              search.
+    // Arguments:   - time: time in seconds
+    // Returns:     Index of the first event at or after the time, or the
+    //              number of events if there is none.
+    //--------------------------------------------------------------------------
+    size_t find_event(double time) const;
+
+private:
+
+    // Time ordered events
+    std::vector<Event> events;
+
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        read_file
+    // Description: Reads an entire file. Throws a std::runtime_error if the
+    //              file cannot be read.
+    // Arguments:   - file_path: path to the file
+    // Returns:     File bytes.
+    //--------------------------------------------------------------------------
+    static std::vector<uint8_t> read_file(const std::string& file_path);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_ethernet_payload
+    // Description: Gets the payload of an IPv4 UDP datagram sent to the
+    //              status port from an Ethernet frame.
+    // Arguments:   - frame: pointer to the frame bytes
+    //              - size: number of bytes in the frame
+    //              - event: event to fill with the sender and payload
+    // Returns:     True if the frame holds such a datagram, false otherwise.
+    //--------------------------------------------------------------------------
+    static bool get_ethernet_payload(const uint8_t* frame, size_t size, Event& event);
+
+    //--------------------------------------------------------------------------
+    // Name:        parse_peer_address
+    // Description: Parses the IPv4 address from a packet recorder peer
+    //              comment of the form a.b.c.d:port.
+    // Arguments:   - comment: comment string
+    // Returns:     IPv4 address in host byte order, or 0 if the comment is
+    //              not a peer address.
+    //--------------------------------------------------------------------------
+    static uint32_t parse_peer_address(const std::string& comment);
+
+    //--------------------------------------------------------------------------
+    // Name:        sort_events
+    // Description: Sorts the events by time, keeping the order of events
+    //              with equal times.
+    //--------------------------------------------------------------------------
+    void sort_events();
+
+};
+
+#endif // REPLAY_LOG_H
@@ -0,0 +1,133 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Generates survey paths for zone tasks off the GUI thread and
+//              caches them by their inputs. A survey is keyed by a hash of
+//              the zone outline, swath width and angle, so a zone whose
+//              inputs have not changed is never planned again, including
+//              a zone that is edited and then returned to an earlier shape.
+//
+//              Uncached surveys are planned on the global thread pool from
+//              copies of their inputs, so the planner never touches a task.
+//              The survey is then available from the cache once the ready
+//              signal is emitted.
+//==============================================================================
+
+#ifndef SURVEY_GENERATOR_H
+#define SURVEY_GENERATOR_H
+
+// QObject base class
+#include <QObject>
+
+// Survey path points
+#include <QPointF>
+
+// Survey cache and pending plans
+#include <QCache>
+#include <QHash>
+#include <QFutureWatcher>
+
+// C++ includes
+#include <vector>
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+class SurveyGenerator : public QObject
+{
+
+    Q_OBJECT
+
+signals:
+
+    //--------------------------------------------------------------------------
+    // Name:        surveyReady
+    // Description: Signal that is emitted when a survey finishes generating
+    //              and has been added to the cache.
+    // Arguments:   - key: key of the survey inputs
+    //--------------------------------------------------------------------------
+    void surveyReady(quint64 key);
+
+public:
+
+    // Maximum total number of path points kept in the cache
+    static const int MAX_CACHED_POINTS = 200000;
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        SurveyGenerator constructor
+    // Description: Constructs a generator with an empty cache.
+    // Arguments:   - parent: parent QObject
+    //--------------------------------------------------------------------------
+    SurveyGenerator(QObject* parent=nullptr);
+
+    //--------------------------------------------------------------------------
+    // Name:        SurveyGenerator destructor
+    // Description: Default destructor. Surveys that are still generating
+    //              finish in the background and are discarded.
+    //--------------------------------------------------------------------------
+    ~SurveyGenerator();
+
+    //--------------------------------------------------------------------------
+    // Name:        get_key
+    // Description: Hashes the inputs of a survey.
+    // Arguments:   - outline: zone outline with longitude as x and latitude
+    //                as y
+    //              - angle: pass heading in degrees
+    //              - swath: pass spacing in meters
+    // Returns:     Survey key.
+    //--------------------------------------------------------------------------
+    static quint64 get_key(const std::vector<QPointF>& outline, double angle, double swath);
+
+    //--------------------------------------------------------------------------
+    // Name:        generate
+    // Description: Plans a survey path on the calling thread.
+    // Arguments:   - outline: zone outline with longitude as x and latitude
+    //                as y
+    //              - angle: pass heading in degrees
+    //              - swath: pass spacing in meters
+    // Returns:     Survey path with longitude as x and latitude as y.
+    //--------------------------------------------------------------------------
+    static std::vector<QPointF> generate(const std::vector<QPointF>& outline,
+                                         double angle, double swath);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_survey
+    // Description: Gets a survey path from the cache. If it is not cached it
+    //              is generated in the background, unless it already is, and
+    //              surveyReady is emitted when it is.
+    // Arguments:   - outline: zone outline with longitude as x and latitude
+    //                as y
+    //              - angle: pass heading in degrees
+    //              - swath: pass spacing in meters
+    //              - path: set to the survey path with longitude as x and
+    //                latitude as y if it is cached
+    // Returns:     True if the survey was cached.
+    //--------------------------------------------------------------------------
+    bool get_survey(const std::vector<QPointF>& outline, double angle, double swath,
+                    std::vector<QPointF>& path);
+
+private:
+
+    // Inputs and path of a survey. The inputs are kept so that surveys
+    // whose keys collide are not confused
+    struct Survey
+    {
+        std::vector<QPointF> outline;
+        double angle;
+        double swath;
+        std::vector<QPointF> path;
+    };
+
+private:
+
+    // Generated surveys, whose cost is their number of path points, and
+    // surveys that are generating
+    QCache<quint64, Survey> cache;
+    QHash<quint64, QFutureWatcher<Survey>*> pending;
+
+};
+
+#endif // SURVEY_GENERATOR_H
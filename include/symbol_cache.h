@@ -0,0 +1,119 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Cache of recolored icon symbols and waypoint symbols.
+//              Recoloring an icon decodes the image resource and paints over
+//              it, which is far too slow to do on every status update, so
+//              each icon is recolored once per resource, color and size and
+//              the symbol is shared by every graphic that uses it. Waypoint
+//              symbols are cached by color, so that every waypoint of a
+//              color shares one symbol.
+//
+//              Cached symbols are never rotated. Graphics that need a
+//              rotated icon use a renderer with a rotation expression, so
+//              that the angle is a graphic attribute rather than part of the
+//              symbol.
+//==============================================================================
+
+#ifndef SYMBOL_CACHE_H
+#define SYMBOL_CACHE_H
+
+// QObject base class, which owns the symbols
+#include <QObject>
+
+// Icon colors
+#include <QColor>
+
+// ArcGIS includes
+#include <CompositeSymbol.h>
+#include <PictureMarkerSymbol.h>
+#include <SimpleMarkerSymbol.h>
+
+// C++ includes
+#include <map>
+#include <tuple>
+
+using namespace Esri::ArcGISRuntime;
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+class SymbolCache : public QObject
+{
+
+public:
+
+    // Vehicle icon resource, and the sizes of its white outline and of its
+    // colored fill in device independent pixels
+    static constexpr const char* VEHICLE_ICON_RESOURCE = ":/resources/gps_icon.png";
+    static const int VEHICLE_ICON_OUTLINE_SIZE = 55;
+    static const int VEHICLE_ICON_FILL_SIZE = 40;
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        instance
+    // Description: Gets the application's symbol cache, creating it on first
+    //              use. The cache is owned by the application object, so
+    //              the symbols are released before the ArcGIS runtime shuts
+    //              down.
+    // Returns:     Pointer to the symbol cache.
+    //--------------------------------------------------------------------------
+    static SymbolCache* instance();
+
+    //--------------------------------------------------------------------------
+    // Name:        get_icon_symbol
+    // Description: Gets a square picture symbol of an icon resource painted
+    //              in a color, creating it on first use.
+    // Arguments:   - resource_name: icon resource name
+    //              - color: icon color
+    //              - size: symbol width and height
+    // Returns:     Pointer to the cached symbol, owned by the cache.
+    //--------------------------------------------------------------------------
+    PictureMarkerSymbol* get_icon_symbol(QString resource_name, QColor color, int size);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_vehicle_icon_symbol
+    // Description: Gets the vehicle icon symbol in a color, which is the
+    //              icon in the color on top of a larger white outline.
+    // Arguments:   - color: vehicle icon color
+    // Returns:     Pointer to the cached symbol, owned by the cache.
+    //--------------------------------------------------------------------------
+    CompositeSymbol* get_vehicle_icon_symbol(QColor color);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_waypoint_symbol
+    // Description: Gets a mission waypoint symbol, which is a white circle
+    //              with a colored border, creating it on first use. Waypoint
+    //              labels are drawn separately.
+    // Arguments:   - color: waypoint border color
+    // Returns:     Pointer to the cached symbol, owned by the cache.
+    //--------------------------------------------------------------------------
+    CompositeSymbol* get_waypoint_symbol(QColor color);
+
+private:
+
+    // Cache key of a picture symbol. The color is compared as its RGBA
+    // value
+    typedef std::tuple<QString, QRgb, int> IconKey;
+
+private:
+
+    // Cached symbols
+    std::map<IconKey, PictureMarkerSymbol*> icon_symbols;
+    std::map<QRgb, CompositeSymbol*> vehicle_icon_symbols;
+    std::map<QRgb, CompositeSymbol*> waypoint_symbols;
+
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        SymbolCache constructor
+    // Description: Constructs an empty cache.
+    // Arguments:   - parent: parent QObject
+    //--------------------------------------------------------------------------
+    SymbolCache(QObject* parent);
+
+};
+
+#endif // SYMBOL_CACHE_H
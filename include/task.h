@@ -24,6 +24,7 @@
 // AVL command packets
 #include "comms/avl_commands.h"
 #include "util/byte.h"
+#include "util/span.h"
 #include "util/vector.h"
 
 //==============================================================================
@@ -43,6 +44,51 @@ signals:
     //--------------------------------------------------------------------------
     void taskChanged();
 
+    //--------------------------------------------------------------------------
+    // Name:        pointsAboutToBeInserted, pointsInserted
+    // Description: Signals emitted before and after points are inserted, so
+    //              that models showing the points can update only their rows.
+    // Arguments:   - first: index of the first inserted point
+    //              - last: index of the last inserted point
+    //--------------------------------------------------------------------------
+    void pointsAboutToBeInserted(int first, int last);
+    void pointsInserted(int first, int last);
+
+    //--------------------------------------------------------------------------
+    // Name:        pointsAboutToBeRemoved, pointsRemoved
+    // Description: Signals emitted before and after points are removed.
+    // Arguments:   - first: index of the first removed point
+    //              - last: index of the last removed point
+    //--------------------------------------------------------------------------
+    void pointsAboutToBeRemoved(int first, int last);
+    void pointsRemoved(int first, int last);
+
+    //--------------------------------------------------------------------------
+    // Name:        pointAboutToBeMoved, pointMoved
+    // Description: Signals emitted before and after a point moves to another
+    //              index.
+    // Arguments:   - from: index of the point before it moves
+    //              - to: index of the point after it moves
+    //--------------------------------------------------------------------------
+    void pointAboutToBeMoved(int from, int to);
+    void pointMoved(int from, int to);
+
+    //--------------------------------------------------------------------------
+    // Name:        pointsAboutToBeReset, pointsReset
+    // Description: Signals emitted before and after all of the points are
+    //              replaced.
+    //--------------------------------------------------------------------------
+    void pointsAboutToBeReset();
+    void pointsReset();
+
+    //--------------------------------------------------------------------------
+    // Name:        pointChanged
+    // Description: Signal emitted when the location or command of a point
+    //              changes.
+    // Arguments:   - index: index of the point
+    //--------------------------------------------------------------------------
+    void pointChanged(int index);
+
 public:
 
     // Property configuration
@@ -105,9 +151,34 @@ public:
     void set_command(ActionType::Value new_command);
     void set_command(int new_command);
 
-    QVector<std::pair<QPointF, ActionType::Value>> get_points();
+    //--------------------------------------------------------------------------
+    // Name:        get_num_points
+    // Description: Gets the number of points in the task.
+    // Returns:     Number of points.
+    //--------------------------------------------------------------------------
+    int get_num_points() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_point
+    // Description: Gets the location of a point. The index is not checked.
+    // Arguments:   - index: index of the point
+    // Returns:     Point location with longitude as x and latitude as y.
+    //--------------------------------------------------------------------------
+    QPointF get_point(int index) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_lats, get_lons, get_commands
+    // Description: Gets read-only views of the latitudes and longitudes in
+    //              degrees and the commands of the points, without copying
+    //              them. A view is only valid until the points next change.
+    // Returns:     View of the point values, one element per point.
+    //--------------------------------------------------------------------------
+    avl::Span<double> get_lats() const;
+    avl::Span<double> get_lons() const;
+    avl::Span<ActionType::Value> get_commands() const;
+
     void add_point(QPointF new_point, ActionType::Value command = ActionType::ACTION_NO_ACTION);
-    void add_point_silent(QPointF new_point);
+    void add_point_silent(QPointF new_point, ActionType::Value command = ActionType::ACTION_NO_ACTION);
     void edit_point(int index, QPointF new_point);
     void set_point_lat(int index, double lat);
     void set_point_lon(int index, double lon);
@@ -117,6 +188,17 @@ public:
     void remove_point(int index);
     void clear_points();
     void clear_points_silent();
+    void set_points(const QVector<QPointF>& new_points);
+    void set_points_silent(const QVector<QPointF>& new_points);
+
+    //--------------------------------------------------------------------------
+    // Name:        copy_parameters
+    // Description: Copies the type, command and guidance values of another
+    //              task, leaving this task's points as they are.
+    // Arguments:   - task: task to copy from
+    //--------------------------------------------------------------------------
+    void copy_parameters(Task* task);
+
     avl::Packet get_packet();
     static Task* packet_to_task(avl::Packet task_packet);
 
@@ -167,8 +249,11 @@ private:
     // Command Task
     ActionType::Value action = ActionType::ACTION_NO_ACTION;
 
-    // List of points
-    QVector<std::pair<QPointF, ActionType::Value>> points;
+    // Latitudes and longitudes in degrees and commands of the points, kept
+    // as separate contiguous arrays that always have the same length
+    QVector<double> point_lats;
+    QVector<double> point_lons;
+    QVector<ActionType::Value> point_commands;
 
 };
 
@@ -0,0 +1,74 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: QML accessible enumeration of the vehicle telemetry channels
+//              stored in a vehicle's telemetry history.
+//==============================================================================
+
+#ifndef TELEMETRY_CHANNEL_H
+#define TELEMETRY_CHANNEL_H
+
+// QObject base class
+#include <QObject>
+
+// QML registering
+#include <QQmlEngine>
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+class TelemetryChannel : public QObject
+{
+
+    Q_OBJECT
+
+public:
+
+    // Telemetry channels enumeration
+    enum Value
+    {
+        TELEMETRY_LAT,
+        TELEMETRY_LON,
+        TELEMETRY_ALT,
+        TELEMETRY_DEPTH,
+        TELEMETRY_HEIGHT,
+        TELEMETRY_ROLL,
+        TELEMETRY_PITCH,
+        TELEMETRY_YAW,
+        TELEMETRY_VX,
+        TELEMETRY_VY,
+        TELEMETRY_VZ,
+        TELEMETRY_RPM,
+        TELEMETRY_VOLTAGE,
+        TELEMETRY_TASK_PERCENT
+    };
+    Q_ENUM(Value)
+
+    // Number of telemetry channels in the enumeration
+    static const int NUM_CHANNELS = TELEMETRY_TASK_PERCENT + 1;
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        TelemetryChannel constructor
+    // Description: Default constructor.
+    //--------------------------------------------------------------------------
+    TelemetryChannel() : QObject()
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    // Name:        declare_qml
+    // Description: Registers types with the QML engine.
+    //--------------------------------------------------------------------------
+    static void declare_qml()
+    {
+        qmlRegisterType<TelemetryChannel>("Avl", 1, 0, "TelemetryChannel");
+        qRegisterMetaType<TelemetryChannel::Value>("TelemetryChannel.Value");
+    }
+
+};
+
+#endif // TELEMETRY_CHANNEL_H
@@ -0,0 +1,196 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Fixed capacity history of vehicle telemetry, stored as a
+//              struct of arrays. Each channel is one contiguous ring buffer
+//              and all channels share a single timestamp ring buffer, so a
+//              sample is appended in constant time and a time range is
+//              found with a binary search over the timestamps. When the
+//              history is full the oldest sample is overwritten.
+//
+//              Samples are addressed by index from the oldest (0) to the
+//              newest (size() - 1). Because the buffers wrap around, a range
+//              of samples is returned as at most two contiguous spans that
+//              can be read without copying.
+//==============================================================================
+
+#ifndef TELEMETRY_HISTORY_H
+#define TELEMETRY_HISTORY_H
+
+// C++ includes
+#include <vector>
+#include <cstddef>
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+class TelemetryHistory
+{
+
+public:
+
+    // Contiguous read-only run of samples in one of the ring buffers
+    struct Span
+    {
+        const double* data;
+        size_t size;
+    };
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        TelemetryHistory constructor
+    // Description: Constructs an empty history and allocates all of its
+    //              storage. Throws a std::runtime_error if the number of
+    //              channels or the capacity is zero.
+    // Arguments:   - num_channels: number of values in each sample
+    //              - capacity: maximum number of samples stored
+    //--------------------------------------------------------------------------
+    TelemetryHistory(size_t num_channels, size_t capacity);
+
+    //--------------------------------------------------------------------------
+    // Name:        TelemetryHistory destructor
+    // Description: Default destructor.
+    //--------------------------------------------------------------------------
+    virtual ~TelemetryHistory();
+
+    //--------------------------------------------------------------------------
+    // Name:        append
+    // Description: Appends a sample, overwriting the oldest sample if the
+    //              history is full. Timestamps must not decrease for the
+    //              time range search to work, so a timestamp older than the
+    //              newest sample is replaced with the newest sample's.
+    // Arguments:   - time: sample time in seconds
+    //              - sample_values: array of num_channels values in channel
+    //                order
+    //--------------------------------------------------------------------------
+    void append(double time, const double* sample_values);
+
+    //--------------------------------------------------------------------------
+    // Name:        clear
+    // Description: Removes all samples without releasing storage.
+    //--------------------------------------------------------------------------
+    void clear();
+
+    //--------------------------------------------------------------------------
+    // Name:        size
+    // Description: Gets the number of stored samples.
+    // Returns:     Number of stored samples.
+    //--------------------------------------------------------------------------
+    size_t size() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        capacity
+    // Description: Gets the maximum number of samples that can be stored.
+    // Returns:     History capacity in samples.
+    //--------------------------------------------------------------------------
+    size_t capacity() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_num_channels
+    // Description: Gets the number of values in each sample.
+    // Returns:     Number of channels.
+    //--------------------------------------------------------------------------
+    size_t get_num_channels() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_time
+    // Description: Gets the time of a sample. Throws a std::runtime_error if
+    //              the index is out of range.
+    // Arguments:   - index: sample index, 0 being the oldest
+    // Returns:     Sample time in seconds.
+    //--------------------------------------------------------------------------
+    double get_time(size_t index) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_value
+    // Description: Gets a channel value of a sample. Throws a
+    //              std::runtime_error if the channel or index is out of
+    //              range.
+    // Arguments:   - channel: channel index
+    //              - index: sample index, 0 being the oldest
+    // Returns:     Channel value.
+    //--------------------------------------------------------------------------
+    double get_value(size_t channel, size_t index) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        find_range
+    // Description: Finds the samples with times in [start_time, end_time]
+    //              using a binary search over the timestamps.
+    // Arguments:   - start_time: earliest sample time in seconds
+    //              - end_time: latest sample time in seconds
+    //              - first: set to the index of the first sample in range
+    //              - last: set to one past the index of the last sample in
+    //                range. Equal to first if no samples are in range
+    //--------------------------------------------------------------------------
+    void find_range(double start_time, double end_time,
+                    size_t& first, size_t& last) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_time_spans
+    // Description: Gets the timestamps of the samples in [first, last) as up
+    //              to two contiguous spans, in order. The second span is
+    //              empty unless the range wraps around the buffer end.
+    // Arguments:   - first: index of the first sample
+    //              - last: one past the index of the last sample
+    //              - spans: array of two spans to fill
+    //--------------------------------------------------------------------------
+    void get_time_spans(size_t first, size_t last, Span spans[2]) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_channel_spans
+    // Description: Gets the values of a channel for the samples in
+    //              [first, last) as up to two contiguous spans, in order.
+    //              Throws a std::runtime_error if the channel is out of
+    //              range.
+    // Arguments:   - channel: channel index
+    //              - first: index of the first sample
+    //              - last: one past the index of the last sample
+    //              - spans: array of two spans to fill
+    //--------------------------------------------------------------------------
+    void get_channel_spans(size_t channel, size_t first, size_t last,
+                           Span spans[2]) const;
+
+private:
+
+    // Number of values per sample and maximum number of samples
+    size_t num_channels;
+    size_t max_samples;
+
+    // Ring buffer slot of the oldest sample and the number of samples
+    size_t head = 0;
+    size_t count = 0;
+
+    // Timestamp ring buffer
+    std::vector<double> times;
+
+    // Channel ring buffers, stored back to back so that channel c occupies
+    // values[c * max_samples] to values[(c + 1) * max_samples - 1]
+    std::vector<double> values;
+
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        get_slot
+    // Description: Converts a sample index to a ring buffer slot.
+    // Arguments:   - index: sample index, 0 being the oldest
+    // Returns:     Ring buffer slot.
+    //--------------------------------------------------------------------------
+    size_t get_slot(size_t index) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_spans
+    // Description: Splits the samples in [first, last) of a ring buffer into
+    //              up to two contiguous spans.
+    // Arguments:   - buffer: start of the ring buffer
+    //              - first: index of the first sample
+    //              - last: one past the index of the last sample
+    //              - spans: array of two spans to fill
+    //--------------------------------------------------------------------------
+    void get_spans(const double* buffer, size_t first, size_t last,
+                   Span spans[2]) const;
+
+};
+
+#endif // TELEMETRY_HISTORY_H
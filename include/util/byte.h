@@ -97,6 +97,32 @@ T from_bytes(std::vector<uint8_t> bytes, bool reverse=false)
 
 }
 
+//------------------------------------------------------------------------------
+// Name:        from_bytes_at
+// Description: Converts the bytes of a vector starting at the given index to
+//              the given type without copying the vector. Throws a
+//              std::runtime_error if the vector does not contain enough bytes
+//              after the index for the specified type.
+// Arguments:   - bytes: vector of bytes to be converted
+//              - index: index of the first byte of the value
+// Returns:     Converted value
+//------------------------------------------------------------------------------
+template<typename T>
+T from_bytes_at(const std::vector<uint8_t>& bytes, size_t index)
+{
+
+    if (index > bytes.size() || bytes.size() - index < sizeof(T))
+    {
+        throw std::runtime_error("from_bytes_at: not enough bytes for conversion from bytes");
+    }
+
+    T var;
+    memcpy(&var, &bytes[index], sizeof(T));
+
+    return var;
+
+}
+
 //------------------------------------------------------------------------------
 // Name:        to_bytes
 // Description: Converts a given variable to a vector of bytes. The output
@@ -0,0 +1,163 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Geodesy functions shared by everything that measures or
+//              moves locations on the earth. Distances, bearings and
+//              destinations are great circle values on a sphere of the
+//              mean earth radius. Local east-north frames use the WGS84
+//              ellipsoid's radii of curvature at their origin, which are
+//              computed once when the frame is made.
+//
+//              Path lengths are summed over contiguous latitude and
+//              longitude arrays, computing each location's trigonometric
+//              values only once.
+//==============================================================================
+
+#ifndef GEO_H
+#define GEO_H
+
+// C++ includes
+#include <cstddef>
+
+namespace avl
+{
+
+namespace geo
+{
+
+//==============================================================================
+//                                  CONSTANTS
+//==============================================================================
+
+// Pi and conversions between degrees and radians
+constexpr double PI = 3.14159265358979323846;
+constexpr double DEGREES_TO_RADIANS = PI / 180.0;
+constexpr double RADIANS_TO_DEGREES = 180.0 / PI;
+
+// Mean earth radius in meters
+constexpr double EARTH_RADIUS = 6371000.0;
+
+// WGS84 ellipsoid semi-major axis in meters and first eccentricity squared
+constexpr double WGS84_A = 6378137.0;
+constexpr double WGS84_E2 = 6.69437999014e-3;
+
+//==============================================================================
+//                             FUNCTION DECLARATIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        distance
+// Description: Gets the great circle distance between two locations.
+// Arguments:   - lat1: start latitude in degrees
+//              - lon1: start longitude in degrees
+//              - lat2: end latitude in degrees
+//              - lon2: end longitude in degrees
+// Returns:     Distance in meters.
+//------------------------------------------------------------------------------
+double distance(double lat1, double lon1, double lat2, double lon2);
+
+//------------------------------------------------------------------------------
+// Name:        bearing
+// Description: Gets the initial great circle bearing from one location to
+//              another.
+// Arguments:   - lat1: start latitude in degrees
+//              - lon1: start longitude in degrees
+//              - lat2: end latitude in degrees
+//              - lon2: end longitude in degrees
+// Returns:     Compass bearing in degrees from 0 up to 360.
+//------------------------------------------------------------------------------
+double bearing(double lat1, double lon1, double lat2, double lon2);
+
+//------------------------------------------------------------------------------
+// Name:        destination
+// Description: Gets the location reached by following a great circle from
+//              a location at a bearing for a distance.
+// Arguments:   - lat: start latitude in degrees
+//              - lon: start longitude in degrees
+//              - bearing: initial compass bearing in degrees
+//              - distance: distance in meters
+//              - dest_lat: set to the destination latitude in degrees
+//              - dest_lon: set to the destination longitude in degrees, from
+//                -180 up to 180
+//------------------------------------------------------------------------------
+void destination(double lat, double lon, double bearing, double distance,
+                 double& dest_lat, double& dest_lon);
+
+//------------------------------------------------------------------------------
+// Name:        path_length
+// Description: Gets the length of a path of great circle segments.
+// Arguments:   - lat: path latitudes in degrees
+//              - lon: path longitudes in degrees
+//              - count: number of path locations
+// Returns:     Path length in meters.
+//------------------------------------------------------------------------------
+double path_length(const double* lat, const double* lon, size_t count);
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+class EnuFrame
+{
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        EnuFrame constructor
+    // Description: Constructs a local east-north frame tangent to the WGS84
+    //              ellipsoid at an origin.
+    // Arguments:   - origin_lat: origin latitude in degrees
+    //              - origin_lon: origin longitude in degrees
+    //--------------------------------------------------------------------------
+    EnuFrame(double origin_lat=0.0, double origin_lon=0.0);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_origin_lat
+    // Description: Gets the latitude of the frame's origin.
+    // Returns:     Origin latitude in degrees.
+    //--------------------------------------------------------------------------
+    double get_origin_lat() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_origin_lon
+    // Description: Gets the longitude of the frame's origin.
+    // Returns:     Origin longitude in degrees.
+    //--------------------------------------------------------------------------
+    double get_origin_lon() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        to_enu
+    // Description: Converts a location to the frame.
+    // Arguments:   - lat: latitude in degrees
+    //              - lon: longitude in degrees
+    //              - east: set to the east offset from the origin in meters
+    //              - north: set to the north offset from the origin in meters
+    //--------------------------------------------------------------------------
+    void to_enu(double lat, double lon, double& east, double& north) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        to_wgs84
+    // Description: Converts a point in the frame to a location.
+    // Arguments:   - east: east offset from the origin in meters
+    //              - north: north offset from the origin in meters
+    //              - lat: set to the latitude in degrees
+    //              - lon: set to the longitude in degrees
+    //--------------------------------------------------------------------------
+    void to_wgs84(double east, double north, double& lat, double& lon) const;
+
+private:
+
+    // Origin in degrees, and the meters per degree of latitude and longitude
+    // at the origin
+    double origin_lat;
+    double origin_lon;
+    double meters_per_lat;
+    double meters_per_lon;
+
+};
+
+} // namespace geo
+
+} // namespace avl
+
+#endif // GEO_H
@@ -0,0 +1,107 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Read-only view of a contiguous array that is owned by
+//              something else. A span is only a pointer and a size, so it
+//              is passed by value, and it is only valid until its owner
+//              changes the array.
+//==============================================================================
+
+#ifndef SPAN_H
+#define SPAN_H
+
+// C++ includes
+#include <cstddef>
+
+namespace avl
+{
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+template<typename T>
+class Span
+{
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        Span constructor
+    // Description: Constructs a view of an array.
+    // Arguments:   - data: pointer to the first element of the array
+    //              - size: number of elements in the array
+    //--------------------------------------------------------------------------
+    Span(const T* data=nullptr, size_t size=0) : m_data(data), m_size(size)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    // Name:        data
+    // Description: Gets a pointer to the first element of the array.
+    // Returns:     Pointer to the first element.
+    //--------------------------------------------------------------------------
+    const T* data() const
+    {
+        return m_data;
+    }
+
+    //--------------------------------------------------------------------------
+    // Name:        size
+    // Description: Gets the number of elements in the array.
+    // Returns:     Number of elements.
+    //--------------------------------------------------------------------------
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    //--------------------------------------------------------------------------
+    // Name:        empty
+    // Description: Checks if the array has no elements.
+    // Returns:     True if the array is empty.
+    //--------------------------------------------------------------------------
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    //--------------------------------------------------------------------------
+    // Name:        operator[]
+    // Description: Gets an element of the array. The index is not checked.
+    // Arguments:   - index: index of the element
+    // Returns:     Reference to the element.
+    //--------------------------------------------------------------------------
+    const T& operator[](size_t index) const
+    {
+        return m_data[index];
+    }
+
+    //--------------------------------------------------------------------------
+    // Name:        begin, end
+    // Description: Gets iterators to the first element and past the last
+    //              element of the array.
+    // Returns:     Pointer to the element.
+    //--------------------------------------------------------------------------
+    const T* begin() const
+    {
+        return m_data;
+    }
+
+    const T* end() const
+    {
+        return m_data + m_size;
+    }
+
+private:
+
+    // Array being viewed
+    const T* m_data;
+    size_t m_size;
+
+};
+
+} // namespace avl
+
+#endif // SPAN_H
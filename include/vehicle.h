@@ -26,13 +26,32 @@
 // Vehicle graphics generation
 #include "graphics.h"
 
+// Vehicle path and icon graphics
+#include "vehicle_path.h"
+
+// Vehicle mission graphics
+#include "mission_graphics.h"
+
+// Frame rate scheduling of graphics updates
+#include "render_scheduler.h"
+
+// Mission time and distance estimation
+#include "mission_estimator.h"
+
 // QTimer class
 #include <QTimer>
 
+// Guarded pointer to the task of a dragged waypoint
+#include <QPointer>
+
 #include "param.h"
 
 #include "geofence.h"
 
+// Telemetry history ring buffers and channel enum
+#include "telemetry_history.h"
+#include "telemetry_channel.h"
+
 //==============================================================================
 //                              CLASS DECLARATION
 //==============================================================================
@@ -228,6 +247,16 @@ public:
     //--------------------------------------------------------------------------
     Q_INVOKABLE double get_mission_duration();
 
+    //--------------------------------------------------------------------------
+    // Name:        get_waypoint_eta
+    // Description: Gets the estimated time from the start of the mission
+    //              that a mission waypoint is reached.
+    // Arguments:   - task_index: index of the waypoint's task in the mission
+    //              - point_index: index of the waypoint in its task
+    // Returns:     Time in seconds, or NaN if there is no such waypoint.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE double get_waypoint_eta(int task_index, int point_index);
+
     //--------------------------------------------------------------------------
     // Name:        get_vehicle_responses
     // Description: Gets a list of vehicle responses.
@@ -256,6 +285,41 @@ public:
     //--------------------------------------------------------------------------
     Q_INVOKABLE std::shared_ptr<GraphicsOverlay> get_geofence_overlay();
 
+    //--------------------------------------------------------------------------
+    // Name:        get_history
+    // Description: Gets the vehicle's telemetry history for reading.
+    // Returns:     Reference to the vehicle's telemetry history.
+    //--------------------------------------------------------------------------
+    const TelemetryHistory& get_history();
+
+    //--------------------------------------------------------------------------
+    // Name:        get_history_size
+    // Description: Gets the number of samples in the telemetry history.
+    // Returns:     Number of telemetry history samples.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE int get_history_size();
+
+    //--------------------------------------------------------------------------
+    // Name:        fill_history_series
+    // Description: Replaces the points of a QtCharts XY series (such as a
+    //              QML LineSeries) with the recent history of a telemetry
+    //              channel. X values are in milliseconds since epoch for use
+    //              with a DateTimeAxis. Does nothing if the object is not an
+    //              XY series.
+    // Arguments:   - series: XY series to fill
+    //              - channel: telemetry channel to plot
+    //              - duration: length of the history to plot in seconds
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE void fill_history_series(QObject* series,
+                                         TelemetryChannel::Value channel,
+                                         double duration);
+
+    //--------------------------------------------------------------------------
+    // Name:        clear_history
+    // Description: Clears the vehicle's telemetry history.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE void clear_history();
+
 
 
 
@@ -270,6 +334,73 @@ public:
     //--------------------------------------------------------------------------
     Q_INVOKABLE void set_vehicle_color(QColor new_color);
 
+    //--------------------------------------------------------------------------
+    // Name:        set_path_resolution
+    // Description: Sets the map resolution that the vehicle's path is drawn
+    //              at, which selects the path's level of detail.
+    // Arguments:   - meters_per_pixel: ground distance covered by one pixel
+    //                on the map in meters
+    //--------------------------------------------------------------------------
+    void set_path_resolution(double meters_per_pixel);
+
+    //--------------------------------------------------------------------------
+    // Name:        set_render_scheduler
+    // Description: Sets the scheduler that the vehicle's graphics updates are
+    //              deferred to. Without one the graphics are updated
+    //              immediately.
+    // Arguments:   - render_scheduler: pointer to the render scheduler
+    //--------------------------------------------------------------------------
+    void set_render_scheduler(RenderScheduler* render_scheduler);
+
+    //--------------------------------------------------------------------------
+    // Name:        render
+    // Description: Updates the out of date parts of the vehicle's graphics.
+    // Arguments:   - flags: bitwise OR of RenderScheduler dirty flags
+    //--------------------------------------------------------------------------
+    void render(int flags);
+
+    //--------------------------------------------------------------------------
+    // Name:        begin_waypoint_drag
+    // Description: Starts dragging a waypoint of the vehicle's mission. Until
+    //              the drag ends, moves only redraw the waypoint and its
+    //              neighbouring segments and leave the mission unchanged.
+    // Arguments:   - task_index: index of the waypoint's task in the mission
+    //              - point_index: index of the waypoint in its task
+    // Returns:     True if the drag started.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE bool begin_waypoint_drag(int task_index, int point_index);
+
+    //--------------------------------------------------------------------------
+    // Name:        drag_waypoint
+    // Description: Moves the dragged waypoint. The preview is redrawn on the
+    //              next frame, so moves between frames cost one redraw.
+    // Arguments:   - location: new waypoint location with longitude as x and
+    //                latitude as y
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE void drag_waypoint(QPointF location);
+
+    //--------------------------------------------------------------------------
+    // Name:        end_waypoint_drag
+    // Description: Ends the waypoint drag and moves the waypoint in the
+    //              mission to its last dragged location.
+    // Returns:     Final waypoint location with longitude as x and latitude
+    //              as y.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE QPointF end_waypoint_drag();
+
+    //--------------------------------------------------------------------------
+    // Name:        find_graphic
+    // Description: Finds the vehicle's waypoint or icon graphic nearest to a
+    //              map location.
+    // Arguments:   - location: location to search around with longitude as x
+    //                and latitude as y
+    //              - radius: search radius in meters
+    //              - distance: set to the distance in meters to the graphic
+    //                that is found, if not null
+    // Returns:     Nearest graphic, or null if none is within the radius.
+    //--------------------------------------------------------------------------
+    Graphic* find_graphic(QPointF location, double radius, double* distance=nullptr);
+
     //--------------------------------------------------------------------------
     // Name:        set_vehicle_type
     // Description: Sets the vehicle's type.
@@ -402,8 +533,27 @@ private slots:
     //--------------------------------------------------------------------------
     void mission_time_timer_timeout();
 
+    //--------------------------------------------------------------------------
+    // Name:        ping_timer_timeout
+    // Description: Slot that is called when the ping timer times out. Pings
+    //              the vehicle over the radio to update the clock offset
+    //              estimate if the vehicle is connected.
+    //--------------------------------------------------------------------------
+    void ping_timer_timeout();
+
     void geofence_changed(QVector<QPointF> geofencePoints);
 
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        request_render
+    // Description: Marks parts of the vehicle's graphics as out of date in
+    //              the render scheduler, or updates them immediately if there
+    //              is no scheduler.
+    // Arguments:   - flags: bitwise OR of RenderScheduler dirty flags
+    //--------------------------------------------------------------------------
+    void request_render(int flags);
+
 private:
 
     // Vehicle IP address, port, and ID number derived from the last three
@@ -438,6 +588,13 @@ private:
     double mission_distance = 0.0;
     double mission_duration = 0.0;
 
+    // Simulation of the mission that estimates its distance and duration
+    MissionEstimator mission_estimator;
+
+    // Timer for periodically pinging the vehicle to estimate its clock offset
+    QTimer* ping_timer = new QTimer(this);
+    const int PING_INTERVAL_MS = 10000;
+
     // Vector of command responses from the vehicle
     QVector<QString> vehicle_responses;
 
@@ -445,9 +602,28 @@ private:
     double distance_from_deckbox;
     double heading_from_deckbox;
 
-    // Queue of points representing the vehicle's path (location history)
-    const int MAX_PATH_POINTS = 60000;
-    QQueue<Point> path;
+    // Index of the vehicle's waypoint and icon graphics for picking
+    GraphicIndex graphic_index;
+
+    // Graphics of the vehicle's path (location history) and icon. The path
+    // keeps one day at 10 Hz, at 18 bytes per location
+    const int MAX_PATH_POINTS = 864000;
+    VehiclePath* path;
+
+    // Graphics of the vehicle's mission
+    MissionGraphics* mission_graphics;
+
+    // Scheduler that graphics updates are deferred to, if any
+    RenderScheduler* render_scheduler = nullptr;
+
+    // Task and index of the dragged waypoint and its drag location
+    QPointer<Task> drag_task;
+    int drag_point_index = -1;
+    QPointF drag_location;
+
+    // Telemetry history of every status, one hour at 10 Hz
+    const size_t HISTORY_CAPACITY = 36000;
+    TelemetryHistory history{TelemetryChannel::NUM_CHANNELS, HISTORY_CAPACITY};
 
     // Graphics overlays containing the vehicle's path and mission
     // graphics
@@ -14,6 +14,9 @@
 // QTcpSocket class for TCP communication with vehicle
 #include <QTcpSocket>
 
+// QTimer for limiting link statistics change signals
+#include <QTimer>
+
 // Vehicle command packets
 #include "comms/avl_commands.h"
 
@@ -22,6 +25,15 @@
 
 #include "comms_channel.h"
 
+// Per channel link statistics
+#include "link_stats.h"
+
+// Vehicle clock offset estimation
+#include "clock_sync.h"
+
+// Raw traffic flight recorder
+#include "packet_recorder.h"
+
 #include "mission.h"
 
 #include "param.h"
@@ -35,8 +47,19 @@ class VehicleConnection : public QObject
 
     Q_OBJECT
 
+    // Property configuration
+    Q_PROPERTY(QVariantList link_stats READ get_link_stats_list NOTIFY linkStatsChanged)
+
 signals:
 
+    //--------------------------------------------------------------------------
+    // Name:        linkStatsChanged
+    // Description: Signal that is emitted at most once per link statistics
+    //              interval while the link statistics or status ages change,
+    //              and when the statistics are reset.
+    //--------------------------------------------------------------------------
+    void linkStatsChanged();
+
     //--------------------------------------------------------------------------
     // Name:        connectionStatusChanged
     // Description: Signal that is emitted when the connection status of the
@@ -123,6 +146,41 @@ public:
     //--------------------------------------------------------------------------
     Q_INVOKABLE bool is_connected();
 
+    //--------------------------------------------------------------------------
+    // Name:        set_replayed
+    // Description: Marks the connection as belonging to a vehicle that only
+    //              exists in replayed traffic. A replayed connection is closed
+    //              and never opens or clock pings, so a replay sends nothing
+    //              to the real vehicle with the same address.
+    // Arguments:   - replayed: true if the vehicle is replayed
+    //--------------------------------------------------------------------------
+    void set_replayed(bool replayed);
+
+    //--------------------------------------------------------------------------
+    // Name:        is_replayed
+    // Description: Checks whether the vehicle only exists in replayed traffic.
+    // Returns:     True if the vehicle is replayed, false otherwise.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE bool is_replayed();
+
+    //--------------------------------------------------------------------------
+    // Name:        set_packet_recorder
+    // Description: Sets the recorder that all raw traffic to and from the
+    //              vehicle is recorded to.
+    // Arguments:   - recorder: pointer to the packet recorder, or nullptr to
+    //                stop recording
+    //--------------------------------------------------------------------------
+    void set_packet_recorder(PacketRecorder* recorder);
+
+    //--------------------------------------------------------------------------
+    // Name:        process_tcp_data
+    // Description: Parses and handles bytes received from the vehicle over TCP.
+    //              Called with live data by the TCP socket's read slot and with
+    //              recorded data during replay.
+    // Arguments:   - data: bytes received from the vehicle
+    //--------------------------------------------------------------------------
+    void process_tcp_data(const QByteArray& data);
+
     //--------------------------------------------------------------------------
     // Name:        get_connection_status
     // Description: Returns a string representing the status of the vehicle
@@ -138,6 +196,24 @@ public:
     Q_INVOKABLE void send_emergency_stop(CommsChannel::Value comms_channel,
                                          int vehicle_id);
 
+    //--------------------------------------------------------------------------
+    // Name:        send_ping
+    // Description: Sends a plain ping to the vehicle, whose response is shown
+    //              to the operator.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE void send_ping(CommsChannel::Value comms_channel,
+                               int vehicle_id);
+
+    //--------------------------------------------------------------------------
+    // Name:        send_clock_ping
+    // Description: Sends a ping carrying the current time to the vehicle. The
+    //              vehicle's timestamped response only updates the clock
+    //              offset estimate, so it is not shown to the operator.
+    //              Vehicles that have responded to a clock ping with text
+    //              rather than timestamps are not pinged again.
+    //--------------------------------------------------------------------------
+    void send_clock_ping(CommsChannel::Value comms_channel, int vehicle_id);
+
     //--------------------------------------------------------------------------
     // Name:        send_enable_helm_mode
     // Description: Sends an enable helm mode command to the vehicle.
@@ -343,6 +419,76 @@ public:
     Q_INVOKABLE void packet_to_parameter(avl::Packet parameter_packet,
                                          int vehicle_id);
 
+    //--------------------------------------------------------------------------
+    // Name:        get_link_stats
+    // Description: Gets the link statistics for one of the comms channels,
+    //              with the status age updated to the current time.
+    // Arguments:   - comms_channel: comms channel to get statistics for
+    // Returns:     Link statistics for the comms channel.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE LinkStats get_link_stats(CommsChannel::Value comms_channel);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_link_stats_list
+    // Description: Gets the link statistics for every comms channel, with
+    //              the status ages updated to the current time.
+    // Returns:     List of link statistics indexed by comms channel.
+    //--------------------------------------------------------------------------
+    QVariantList get_link_stats_list();
+
+    //--------------------------------------------------------------------------
+    // Name:        get_clock_offset
+    // Description: Gets the estimated offset of the vehicle clock from the
+    //              local clock.
+    // Returns:     Clock offset in seconds, or NaN if the vehicle has not
+    //              responded to a timestamped ping.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE double get_clock_offset();
+
+    //--------------------------------------------------------------------------
+    // Name:        get_clock_delay
+    // Description: Gets the round trip delay of the ping the clock offset
+    //              was estimated from. Half of it bounds the offset error.
+    // Returns:     Round trip delay in seconds, or NaN if the vehicle has
+    //              not responded to a timestamped ping.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE double get_clock_delay();
+
+    //--------------------------------------------------------------------------
+    // Name:        get_data_age
+    // Description: Gets the age of data timestamped by the vehicle, correcting
+    //              for the vehicle clock offset when it is known.
+    // Arguments:   - timestamp: vehicle timestamp in seconds since epoch
+    // Returns:     Age of the data in seconds, or NaN if the timestamp is NaN.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE double get_data_age(double timestamp);
+
+    //--------------------------------------------------------------------------
+    // Name:        reset_link_stats
+    // Description: Clears the link statistics for all comms channels.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE void reset_link_stats();
+
+    //--------------------------------------------------------------------------
+    // Name:        record_packet_received
+    // Description: Records a valid packet received from the vehicle in the
+    //              statistics of the channel it was sent over.
+    // Arguments:   - packet: packet that was received
+    //              - num_bytes: total number of bytes in the packet
+    //--------------------------------------------------------------------------
+    void record_packet_received(avl::Packet& packet, int num_bytes);
+
+    //--------------------------------------------------------------------------
+    // Name:        record_invalid_packet
+    // Description: Records received bytes that could not be parsed into a
+    //              packet. The channel cannot be read from invalid bytes, so
+    //              they are recorded in the radio statistics.
+    // Arguments:   - num_bytes: number of bytes that were discarded
+    //              - checksum_failure: true if the bytes failed checksum
+    //                validation, false for any other parse error
+    //--------------------------------------------------------------------------
+    void record_invalid_packet(int num_bytes, bool checksum_failure);
+
 
 
 private slots:
@@ -385,6 +531,29 @@ private:
     // String representing connection status
     QString connection_status = "DISCONNECTED";
 
+    // Flag indicating whether the vehicle only exists in replayed traffic
+    bool replayed = false;
+
+    // Link statistics indexed by comms channel
+    QVector<LinkStats> link_stats;
+
+    // Timer that limits how often link statistics changes are signalled,
+    // since the statistics change with every packet
+    QTimer* link_stats_timer = new QTimer(this);
+    const int LINK_STATS_INTERVAL_MS = 1000;
+
+    // Vehicle clock offset estimated from ping round trips
+    ClockSync clock_sync;
+
+    // Number of clock and operator pings that have not been responded to,
+    // and whether the vehicle responds to clock pings with timestamps
+    int clock_pings_pending = 0;
+    int operator_pings_pending = 0;
+    bool timestamped_pings = true;
+
+    // Recorder for raw traffic, owned by the vehicle manager
+    PacketRecorder* packet_recorder = nullptr;
+
 private:
 
     //--------------------------------------------------------------------------
@@ -34,6 +34,18 @@
 
 #include "geofence_data_model.h"
 
+// Raw traffic flight recorder
+#include "packet_recorder.h"
+
+// Frame rate scheduling of display updates
+#include "render_scheduler.h"
+
+// Splitting survey zones between vehicles
+#include "coverage_planner.h"
+
+// Survey zone pass heading search
+#include "angle_optimizer.h"
+
 //==============================================================================
 //                              CLASS DEFINITION
 //==============================================================================
@@ -162,6 +174,18 @@ signals:
 
     void vehicleParametersFullyReceived(int origin_vehicle_id);
 
+    //--------------------------------------------------------------------------
+    // Name:        zoneAngleOptimized
+    // Description: Signal that is emitted when a pass heading search started
+    //              by optimize_zone_angle finishes and its heading has been
+    //              set on the zone.
+    // Arguments:   - vehicle_id: ID of the vehicle whose mission holds the
+    //                zone
+    //              - task_index: index of the zone task in the mission
+    //              - angle: new pass heading in degrees
+    //--------------------------------------------------------------------------
+    void zoneAngleOptimized(int vehicle_id, int task_index, double angle);
+
 public:
 
     //--------------------------------------------------------------------------
@@ -306,17 +330,6 @@ public:
     //--------------------------------------------------------------------------
     Q_INVOKABLE VehicleStatus generate_empty_status();
 
-    //--------------------------------------------------------------------------
-    // Name:        move_vehicle_waypoint
-    // Description: Edits the position of a waypoint in a vehicle's mission.
-    // Arguments:   - vehicle_index: index of the vehicle being edited in the
-    //                vehicle list. This is not the vehicle ID
-    //              - waypoint_index: index of the waypoint being edited
-    //              - new_location: new waypoint location in lat/lon in degrees
-    //--------------------------------------------------------------------------
-    Q_INVOKABLE void move_vehicle_waypoint(int vehicle_index, int waypoint_index,
-                                           QPointF new_location);
-
     //--------------------------------------------------------------------------
     // Name:        get_deckbox_distance
     // Description: Calculates the distance from the deckbox to the vehicle with
@@ -341,6 +354,66 @@ public:
     //--------------------------------------------------------------------------
     Q_INVOKABLE void add_default_vehicle();
 
+    //--------------------------------------------------------------------------
+    // Name:        partition_zone
+    // Description: Splits a survey zone between its vehicle and the selected
+    //              vehicles in bands that take equal time to survey. The
+    //              zone task keeps the first band, and every other vehicle
+    //              gets a copy of the zone task with its band followed by a
+    //              survey path task appended to its mission. Each vehicle's
+    //              survey path is then generated in the background. Every
+    //              band's path task copies the zone's path task, so the
+    //              vehicles survey at the same speed.
+    // Arguments:   - vehicle_id: ID of the vehicle whose mission holds the
+    //                zone
+    //              - task_index: index of the zone task in the mission
+    // Returns:     Number of vehicles that the zone was split between, or 0
+    //              if the task is not a zone that can be surveyed.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE int partition_zone(int vehicle_id, int task_index);
+
+    //--------------------------------------------------------------------------
+    // Name:        optimize_zone_angle
+    // Description: Starts searching in the background for the pass heading
+    //              that surveys a zone in the least time. The heading is set
+    //              on the zone and zoneAngleOptimized is emitted when the
+    //              search finishes, unless the zone was removed or its points
+    //              changed in the meantime. The zone task's x velocity is
+    //              used as the survey speed if it is set.
+    // Arguments:   - vehicle_id: ID of the vehicle whose mission holds the
+    //                zone
+    //              - task_index: index of the zone task in the mission
+    // Returns:     True if the search was started, or false if the task is
+    //              not a zone task.
+    //--------------------------------------------------------------------------
+    Q_INVOKABLE bool optimize_zone_angle(int vehicle_id, int task_index);
+
+    //--------------------------------------------------------------------------
+    // Name:        process_udp_datagram
+    // Description: Parses and handles a datagram received over UDP multicast.
+    //              Called with live data by the UDP socket's read slot and with
+    //              recorded data during replay. Vehicles first seen in
+    //              replayed data are marked as replayed so that they never
+    //              connect to the real vehicle. Replayed data is only given to
+    //              replayed vehicles and live data only to live vehicles, so a
+    //              live vehicle and a recording with the same ID never mix.
+    // Arguments:   - datagram_data: bytes in the datagram
+    //              - ip_address: IP address the datagram was received from
+    //              - replayed: true if the datagram is recorded data
+    //--------------------------------------------------------------------------
+    void process_udp_datagram(const QByteArray& datagram_data, QString ip_address,
+                              bool replayed=false);
+
+    //--------------------------------------------------------------------------
+    // Name:        process_tcp_data
+    // Description: Parses and handles bytes received over TCP from a vehicle.
+    //              Used during replay. Does nothing if the vehicle is not in
+    //              the vehicle list or is a live vehicle.
+    // Arguments:   - ip_address: IP address of the vehicle
+    //              - data: bytes received from the vehicle
+    //--------------------------------------------------------------------------
+    void process_tcp_data(QString ip_address, const QByteArray& data);
+
 private:
 
     // List of vehicles being managed
@@ -359,6 +432,13 @@ private:
     QString multicast_address = "224.0.0.138";
     quint16 port = 1338;
 
+    // Flight recorder for all raw traffic to and from the vehicles
+    PacketRecorder packet_recorder;
+
+    // Scheduler that defers graphics, table and status display updates to
+    // the display frame rate
+    RenderScheduler render_scheduler;
+
     // Pointer to vehicle data model to display vehicle status as a table
     VehicleDataModel* vehicle_data_model;
 
@@ -472,6 +552,15 @@ private slots:
 
     void vehicle_parameters_fully_received(int origin_vehicle_id);
 
+    //--------------------------------------------------------------------------
+    // Name:        render_vehicle
+    // Description: Slot that is called by the render scheduler to update the
+    //              out of date parts of a vehicle's display.
+    // Arguments:   - vehicle_id: ID of the vehicle to update
+    //              - flags: bitwise OR of RenderScheduler dirty flags
+    //--------------------------------------------------------------------------
+    void render_vehicle(int vehicle_id, int flags);
+
 
 private:
 
@@ -0,0 +1,379 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Map graphics for a vehicle's location history and icon.
+//
+//              The path is drawn as a frozen history of fixed size polyline
+//              chunks and a short live tail. New locations are only added to
+//              the tail, and when the tail reaches the chunk size it is
+//              frozen into a chunk graphic that is never rebuilt. Each
+//              update therefore rebuilds at most one chunk's worth of
+//              points no matter how long the path is. When the path reaches
+//              its maximum length the oldest chunk is removed as a whole.
+//
+//              The path can be drawn at several levels of detail. Each level
+//              is simplified incrementally with a radial distance filter that
+//              only keeps a location once it is a tolerance away from the
+//              last kept location. Every level is filtered as locations
+//              arrive and remembers its newest kept locations, but only the
+//              level whose tolerance best matches the size of a pixel on the
+//              map is drawn, and only it has chunks and a tail.
+//
+//              The locations themselves are kept in a compact path history
+//              with their time, yaw and depth, and are only turned into
+//              geometry when they are drawn. When the drawn level changes,
+//              the old level's graphics are dropped and the new level is
+//              drawn from the locations it already kept, without filtering
+//              the history again.
+//
+//              Every level but the coarsest only remembers a fixed number of
+//              its newest kept locations, and the coarsest remembers every
+//              location it kept that is still in the history. The drawn
+//              level shows the locations it remembers, and the track before
+//              them is drawn from the finest coarser level that remembers
+//              every location in the history. That older track grows a chunk
+//              at a time as the drawn level forgets its oldest locations, so
+//              the whole history is shown at every level while no level
+//              builds geometry for more than its own remembered locations.
+//
+//              Every path graphic shares one line symbol, so changing the
+//              path color does not touch the chunks. The vehicle icon has
+//              no symbol of its own and is drawn by the overlay renderer
+//              with a cached icon symbol, rotated by a yaw attribute, so an
+//              update only moves the icon and sets its yaw. The icon is also
+//              kept in a graphic index so that it can be picked on the map.
+//==============================================================================
+
+#ifndef VEHICLE_PATH_H
+#define VEHICLE_PATH_H
+
+// QObject base class, which owns the graphics
+#include <QObject>
+
+// Path and icon colors
+#include <QColor>
+
+// Spatial index of the icon graphic for picking
+#include "graphic_index.h"
+
+// Compact location history
+#include "path_history.h"
+
+// ArcGIS includes
+#include <GraphicsOverlay.h>
+#include <Graphic.h>
+#include <Point.h>
+#include <Polyline.h>
+#include <SimpleLineSymbol.h>
+#include <SimpleRenderer.h>
+
+// C++ includes
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+using namespace Esri::ArcGISRuntime;
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+class VehiclePath : public QObject
+{
+
+public:
+
+    // Number of kept locations in each frozen chunk, which is also the
+    // maximum number of locations rebuilt on an update
+    static const int CHUNK_SIZE = 256;
+
+    // Maximum number of kept locations that each level but the coarsest
+    // remembers, which is a whole number of chunks
+    static const int MAX_LEVEL_POINTS = 64*CHUNK_SIZE;
+
+    // Number of levels of detail. Level 0 draws every location and each
+    // following level has LEVEL_TOLERANCE_FACTOR times the tolerance of
+    // the one before, starting from FIRST_LEVEL_TOLERANCE meters
+    static const int NUM_LEVELS = 6;
+    static constexpr double FIRST_LEVEL_TOLERANCE = 1.0;
+    static constexpr double LEVEL_TOLERANCE_FACTOR = 4.0;
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        VehiclePath constructor
+    // Description: Constructs an empty path that draws into a graphics
+    //              overlay, showing every location until a resolution is
+    //              set.
+    // Arguments:   - graphics_overlay: overlay to add the path and icon
+    //                graphics to
+    //              - graphic_index: index to keep the icon graphic in
+    //              - max_points: maximum number of locations to keep in the
+    //                history
+    //              - parent: parent QObject
+    //--------------------------------------------------------------------------
+    VehiclePath(GraphicsOverlay* graphics_overlay, GraphicIndex* graphic_index,
+                int max_points, QObject* parent=nullptr);
+
+    //--------------------------------------------------------------------------
+    // Name:        VehiclePath destructor
+    // Description: Default destructor.
+    //--------------------------------------------------------------------------
+    ~VehiclePath();
+
+    //--------------------------------------------------------------------------
+    // Name:        append
+    // Description: Adds a location to the end of the path. The live tail and
+    //              icon are not redrawn until redraw_tail and redraw_icon are
+    //              called, so that several locations can be added per redraw.
+    // Arguments:   - time: location time in seconds
+    //              - lat: latitude in degrees
+    //              - lon: longitude in degrees
+    //              - yaw: vehicle yaw in degrees
+    //              - depth: vehicle depth in meters
+    //--------------------------------------------------------------------------
+    void append(double time, double lat, double lon, double yaw, double depth);
+
+    //--------------------------------------------------------------------------
+    // Name:        redraw_tail
+    // Description: Redraws the visible live tail to end at the latest location.
+    //--------------------------------------------------------------------------
+    void redraw_tail();
+
+    //--------------------------------------------------------------------------
+    // Name:        redraw_icon
+    // Description: Moves and rotates the vehicle icon to the latest location
+    //              and yaw.
+    //--------------------------------------------------------------------------
+    void redraw_icon();
+
+    //--------------------------------------------------------------------------
+    // Name:        set_resolution
+    // Description: Draws the coarsest level of detail whose tolerance is no
+    //              larger than the ground size of a pixel.
+    // Arguments:   - meters_per_pixel: ground distance covered by one pixel
+    //                on the map in meters
+    //--------------------------------------------------------------------------
+    void set_resolution(double meters_per_pixel);
+
+    //--------------------------------------------------------------------------
+    // Name:        set_color
+    // Description: Sets the path and icon color.
+    // Arguments:   - color: path and icon color
+    //--------------------------------------------------------------------------
+    void set_color(QColor color);
+
+    //--------------------------------------------------------------------------
+    // Name:        clear
+    // Description: Removes every location and graphic from the path.
+    //--------------------------------------------------------------------------
+    void clear();
+
+    //--------------------------------------------------------------------------
+    // Name:        size
+    // Description: Gets the number of locations in the path.
+    // Returns:     Number of locations.
+    //--------------------------------------------------------------------------
+    int size() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        get_history
+    // Description: Gets the history of the path's locations.
+    // Returns:     Path history.
+    //--------------------------------------------------------------------------
+    const PathHistory& get_history() const;
+
+private:
+
+    // Frozen chunk graphic and the history indices of the first and last
+    // locations in it
+    struct Chunk
+    {
+        Graphic* graphic;
+        uint64_t first_index;
+        uint64_t last_index;
+    };
+
+    // Drawn part of the path
+    struct Track
+    {
+
+        // Frozen chunks, oldest first
+        std::deque<Chunk> chunks;
+
+        // History indices of the locations in the live tail. The first
+        // location is the last location of the newest chunk, so that the
+        // tail joins onto it
+        std::vector<uint64_t> tail_indices;
+
+        // Live tail graphic, created on the first location
+        Graphic* tail_graphic = nullptr;
+
+    };
+
+    // Path at one level of detail
+    struct Level
+    {
+
+        // Minimum distance in meters between kept locations
+        double tolerance;
+
+        // History indices of the kept locations, oldest first. Every level
+        // but the coarsest only remembers its newest MAX_LEVEL_POINTS
+        std::deque<uint64_t> kept_indices;
+
+        // History index after the newest location that the level forgot to
+        // stay within MAX_LEVEL_POINTS, from which on it remembers every
+        // location that it kept
+        uint64_t window_begin = 0;
+
+        // Last kept location
+        double last_lat = 0.0;
+        double last_lon = 0.0;
+
+    };
+
+private:
+
+    // Overlay that the graphics are drawn in
+    GraphicsOverlay* graphics_overlay;
+
+    // Every location appended since the path was cleared, up to its
+    // capacity
+    PathHistory history;
+
+    // Path and icon color, and the line symbol shared by every path graphic
+    QColor color = Qt::white;
+    SimpleLineSymbol* path_symbol;
+
+    // Levels of detail and the index of the drawn level. Every level keeps
+    // filtering locations, but only the drawn level and the level that the
+    // track before it is drawn from have graphics
+    std::vector<Level> levels;
+    int visible_level = 0;
+
+    // Track of the drawn level's remembered locations, and the older track
+    // before it and the level that it is drawn from, if any
+    Track track;
+    Track old_track;
+    int old_level = -1;
+
+    // Latest location and yaw
+    Point location;
+    double yaw = 0.0;
+
+    // Vehicle icon graphic, created on the first location, the renderer
+    // that draws it, and the index that it is kept in
+    Graphic* icon_graphic = nullptr;
+    SimpleRenderer* icon_renderer;
+    GraphicIndex* graphic_index;
+
+    // Name of the icon graphic attribute holding the vehicle yaw in degrees
+    static const char* YAW_ATTRIBUTE;
+
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        add_to_level
+    // Description: Keeps a location from the history in a level if it is at
+    //              least the level's tolerance away from the last kept
+    //              location, forgetting the level's kept locations that are
+    //              no longer stored, and its oldest past MAX_LEVEL_POINTS
+    //              unless it is the coarsest level.
+    // Arguments:   - level: level of detail
+    //              - index: history index of the location
+    // Returns:     True if the level kept the location.
+    //--------------------------------------------------------------------------
+    bool add_to_level(Level& level, uint64_t index);
+
+    //--------------------------------------------------------------------------
+    // Name:        add_to_tail
+    // Description: Adds a location to a track's live tail, freezing the tail
+    //              into a chunk once it is full.
+    // Arguments:   - track: drawn track
+    //              - index: history index of the location
+    //--------------------------------------------------------------------------
+    void add_to_tail(Track& track, uint64_t index);
+
+    //--------------------------------------------------------------------------
+    // Name:        freeze_tail
+    // Description: Turns a track's live tail into a chunk graphic and starts
+    //              a new tail from its last location.
+    // Arguments:   - track: drawn track
+    //--------------------------------------------------------------------------
+    void freeze_tail(Track& track);
+
+    //--------------------------------------------------------------------------
+    // Name:        remove_old_chunks
+    // Description: Removes the chunks and tail locations that start before
+    //              the oldest location left in the history, and the drawn
+    //              level's oldest chunks past MAX_LEVEL_POINTS locations,
+    //              which are drawn again in the older track.
+    //--------------------------------------------------------------------------
+    void remove_old_chunks();
+
+    //--------------------------------------------------------------------------
+    // Name:        update_tail
+    // Description: Rebuilds a track's live tail graphic.
+    // Arguments:   - track: drawn track
+    //              - last_index: history index of the location that the tail
+    //                ends at, even if it is not in the tail
+    //--------------------------------------------------------------------------
+    void update_tail(Track& track, uint64_t last_index);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_polyline
+    // Description: Builds a polyline through locations in the history,
+    //              skipping any that are no longer stored.
+    // Arguments:   - indices: history indices of the locations
+    // Returns:     Polyline through the locations.
+    //--------------------------------------------------------------------------
+    Polyline get_polyline(const std::vector<uint64_t>& indices) const;
+
+    //--------------------------------------------------------------------------
+    // Name:        build_level
+    // Description: Builds the drawn track from the locations that a level
+    //              remembers, and the older track before them if the level
+    //              forgot any locations that are still in the history.
+    // Arguments:   - level: level of detail
+    //--------------------------------------------------------------------------
+    void build_level(Level& level);
+
+    //--------------------------------------------------------------------------
+    // Name:        build_old_track
+    // Description: Builds the older track from the finest level coarser than
+    //              the drawn level that remembers every location in the
+    //              history.
+    // Arguments:   - end_index: history index of the first location of the
+    //                drawn track, which the older track ends at
+    //--------------------------------------------------------------------------
+    void build_old_track(uint64_t end_index);
+
+    //--------------------------------------------------------------------------
+    // Name:        extend_old_track
+    // Description: Extends the older track to a location that the drawn
+    //              track no longer shows, building it again from a coarser
+    //              level if its level forgot locations in the history.
+    // Arguments:   - end_index: history index of the new first location of
+    //                the drawn track, which the older track ends at
+    //--------------------------------------------------------------------------
+    void extend_old_track(uint64_t end_index);
+
+    //--------------------------------------------------------------------------
+    // Name:        clear_track
+    // Description: Removes every graphic and tail location of a track.
+    // Arguments:   - track: drawn track
+    //--------------------------------------------------------------------------
+    void clear_track(Track& track);
+
+    //--------------------------------------------------------------------------
+    // Name:        update_icon
+    // Description: Moves and rotates the vehicle icon to the latest location
+    //              and yaw. The icon symbol is shared, so only the geometry and
+    //              yaw attribute change.
+    //--------------------------------------------------------------------------
+    void update_icon();
+
+};
+
+#endif // VEHICLE_PATH_H
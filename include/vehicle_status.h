@@ -19,10 +19,54 @@
 // NAN value
 #include <cmath>
 
+// Fixed width integer types
+#include <cstdint>
+
 //==============================================================================
 //                              STRUCT DECLARATION
 //==============================================================================
 
+// Compact plain-old-data form of a decoded STATUS packet. Strings are stored
+// as IDs into the interned string table, so the core can be copied and
+// buffered without any allocation
+struct VehicleStatusCore
+{
+
+    // Bit (1 << descriptor) is set for each STATUS field in the packet
+    uint32_t fields;
+
+    // Raw comms channel and vehicle ID field values
+    uint8_t comms_channel;
+    uint8_t vehicle_id;
+
+    // Interned mode and operational status string IDs
+    uint16_t mode;
+    uint16_t operational_status;
+
+    uint8_t whoi_synced;
+    uint8_t num_gps_sats;
+    uint8_t iridium_strength;
+    uint8_t current_task;
+    uint8_t total_tasks;
+
+    double roll;
+    double pitch;
+    double yaw;
+    double vx;
+    double vy;
+    double vz;
+    double lat;
+    double lon;
+    double alt;
+    double depth;
+    double height;
+    double rpm;
+    double voltage;
+    double task_percent;
+    double timestamp;
+
+};
+
 class VehicleStatus
 {
 
@@ -52,6 +96,7 @@ class VehicleStatus
     Q_PROPERTY(int current_task           MEMBER current_task)
     Q_PROPERTY(int total_tasks            MEMBER total_tasks)
     Q_PROPERTY(double task_percent        MEMBER task_percent)
+    Q_PROPERTY(double timestamp           MEMBER timestamp)
 
 public:
 
@@ -79,6 +124,7 @@ public:
     int current_task = 0;
     int total_tasks = 0;
     double task_percent = 0.0;
+    double timestamp = std::nan("");
 
 public:
 
@@ -93,7 +139,14 @@ public:
     // Description: Creates a VehicleStatus class from an AVL status packet.
     // Arguments:   - packet: status packet
     //--------------------------------------------------------------------------
-    VehicleStatus(avl::Packet packet);
+    VehicleStatus(const avl::Packet& packet);
+
+    //--------------------------------------------------------------------------
+    // Name:        VehicleStatus constructor
+    // Description: Creates a VehicleStatus class from a decoded status core.
+    // Arguments:   - core: decoded status core
+    //--------------------------------------------------------------------------
+    VehicleStatus(const VehicleStatusCore& core);
 
     //--------------------------------------------------------------------------
     // Name:        VehicleStatus destructor
@@ -101,6 +154,53 @@ public:
     //--------------------------------------------------------------------------
     virtual ~VehicleStatus();
 
+    //--------------------------------------------------------------------------
+    // Name:        decode
+    // Description: Decodes an AVL status packet into a status core in a
+    //              single pass over its fields. Fields that are not in the
+    //              packet are left at their defaults (NaN or zero). Throws a
+    //              std::runtime_error if a field is improperly formatted,
+    //              leaving the fields decoded before it in the core.
+    // Arguments:   - packet: status packet
+    //              - core: status core to decode into
+    //--------------------------------------------------------------------------
+    static void decode(const avl::Packet& packet, VehicleStatusCore& core);
+
+    //--------------------------------------------------------------------------
+    // Name:        clear_core
+    // Description: Sets a status core to the values of an empty status.
+    // Arguments:   - core: status core to clear
+    //--------------------------------------------------------------------------
+    static void clear_core(VehicleStatusCore& core);
+
+    //--------------------------------------------------------------------------
+    // Name:        intern_string
+    // Description: Gets the interned string ID for a string, adding it to
+    //              the interned string table if it is new. ID 0 is always
+    //              "NONE", which is also returned if the table is full or the
+    //              string is too long to intern.
+    // Arguments:   - bytes: string bytes
+    // Returns:     Interned string ID.
+    //--------------------------------------------------------------------------
+    static uint16_t intern_string(const std::vector<uint8_t>& bytes);
+
+    //--------------------------------------------------------------------------
+    // Name:        interned_string
+    // Description: Gets the string for an interned string ID. Every status
+    //              with the same ID shares the same QString data.
+    // Arguments:   - id: interned string ID
+    // Returns:     Interned string, or "NONE" for an unknown ID.
+    //--------------------------------------------------------------------------
+    static QString interned_string(uint16_t id);
+
+    //--------------------------------------------------------------------------
+    // Name:        comms_channel_string
+    // Description: Gets the shared string for a raw comms channel value.
+    // Arguments:   - channel: comms channel field value
+    // Returns:     Comms channel string.
+    //--------------------------------------------------------------------------
+    static QString comms_channel_string(uint8_t channel);
+
 };
 
 Q_DECLARE_METATYPE(VehicleStatus)
@@ -9,6 +9,7 @@ import QtQuick 2.13
 import QtQuick.Controls 2.13
 import QtQuick.Controls.Material 2.13
 import QtQuick.Dialogs 1.3
+import QtQuick.Layouts 1.13
 import QtGamepad 1.0
 
 // Custom QML imports
@@ -35,6 +36,16 @@ ApplicationWindow
     property bool dark_theme_enabled: true
     property string matlab_path: ""
 
+    // Replay state, and the vehicle ID given to statuses replayed from AVL
+    // text logs, which do not record one
+    property bool replay_loaded: false
+    property bool replay_playing: false
+    property int replay_vehicle_id: 1
+
+    // Replay length and position in seconds from the start of the replay
+    property double replay_duration: 0.0
+    property double replay_position: 0.0
+
     // Action to toggle between light/dark theme
     Action
     {
@@ -186,8 +197,128 @@ ApplicationWindow
 
             } // Menu
 
+            Menu
+            {
+
+                title: qsTr("Replay")
+
+                Action
+                {
+                    text: qsTr("Open Recording")
+                    onTriggered: replay_file_dialog.open()
+                }
+
+                Action
+                {
+                    text: qsTr("Play")
+                    enabled: replay_loaded && !replay_playing
+                    onTriggered: replay_engine.play()
+                }
+
+                Action
+                {
+                    text: qsTr("Pause")
+                    enabled: replay_playing
+                    onTriggered: replay_engine.pause()
+                }
+
+                Action
+                {
+                    text: qsTr("Stop")
+                    enabled: replay_loaded
+                    onTriggered: replay_engine.stop()
+                }
+
+            } // Menu
+
         } // MenuBar
 
+    // Connects to the replay engine's signals to keep the replay menu up to
+    // date
+    Connections
+    {
+        target: replay_engine
+        onPlayingChanged: replay_playing = playing
+        onReplayLoaded:
+        {
+            replay_loaded = num_events > 0
+            replay_duration = duration
+        }
+        onPositionChanged: replay_position = position
+    }
+
+    // Replay position slider and speed selector, shown while a recording is
+    // loaded
+    footer:
+        ToolBar
+        {
+
+            visible: replay_loaded
+
+            RowLayout
+            {
+
+                anchors.fill: parent
+                anchors.leftMargin: 10
+                anchors.rightMargin: 10
+
+                Label
+                {
+                    text: Math.floor(replay_position) + " / " + Math.floor(replay_duration) + " s"
+                }
+
+                // The slider follows the replay unless it is being dragged,
+                // and seeks once it is released
+                Slider
+                {
+                    id: replay_slider
+                    Layout.fillWidth: true
+                    from: 0.0
+                    to: replay_duration
+                    value: pressed ? value : replay_position
+                    onPressedChanged:
+                    {
+                        if (!pressed)
+                            replay_engine.seek(value)
+                    }
+                }
+
+                // Speeds are multiples of real time, and a speed of zero
+                // replays as fast as possible
+                ComboBox
+                {
+                    id: replay_speed_combo_box
+                    editable: false
+                    textRole: "text"
+                    currentIndex: 2
+                    model: [ { text: "0.25x", speed: 0.25 },
+                             { text: "0.5x",  speed: 0.5 },
+                             { text: "1x",    speed: 1.0 },
+                             { text: "2x",    speed: 2.0 },
+                             { text: "5x",    speed: 5.0 },
+                             { text: "10x",   speed: 10.0 },
+                             { text: "Max",   speed: 0.0 } ]
+                    onActivated: replay_engine.set_speed(model[index].speed)
+                }
+
+            } // RowLayout
+
+        } // ToolBar
+
+    // File dialog for choosing recorded traffic to replay
+    FileDialog
+    {
+
+        id: replay_file_dialog
+        title: "Please choose a recording to replay"
+        folder: shortcuts.home
+        nameFilters: [ "Recordings (*.pcapng *.txt *.log)", "All files (*)" ]
+        selectExisting: true
+        selectMultiple: false
+        onAccepted: replay_loaded = replay_engine.load(fileUrl, replay_vehicle_id)
+
+    } // FileDialog
+
     // File dialog for adding nautical charts to the overlay
     FileDialog
     {
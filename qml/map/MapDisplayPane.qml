@@ -21,11 +21,6 @@ AvlMapDisplay
     anchors.fill: parent
     focus: true
 
-    onWaypointMoved:
-    {
-        vehicle_manager.move_vehicle_waypoint(vehicle_index, waypoint_index, new_location);
-    }
-
     // Action to toggle the weather overlay on button press
     Action
     {
@@ -128,7 +128,6 @@ Pane
             onPressed:
             {
                 geofence_data_model.clear_points()
-                geofence_data_model.redraw()
             }
 
         } // Button
@@ -110,7 +110,6 @@ Pane
         {
             var filepath = url_to_filepath(mission_load_dialog.fileUrl.toString())
             vehicle_manager.get_selected_vehicle().load_mission(filepath)
-            mission_data_model.redraw()
         }
 
     }
@@ -221,7 +220,6 @@ Pane
             {
                 var id = vehicle_manager.get_selected_vehicles()[0];
                 vehicle_manager.get_selected_vehicle().read_mission(CommsChannel.COMMS_RADIO, id)
-                mission_data_model.redraw()
             } // onPressed
 
         } // Button
@@ -36,6 +36,23 @@ Section
 
             color: "transparent"
 
+            // Connections to receive vehicle manager signals
+            Connections
+            {
+
+                target: vehicle_manager
+
+                // The angle field is only filled in when the popup opens, so
+                // it is set when a search for the selected zone finishes
+                onZoneAngleOptimized:
+                {
+                    if (vehicle_id === vehicle_manager.get_selected_vehicle().get_vehicle_id() &&
+                        task_index === mission_data_model.get_selected_task_index())
+                        angle_field.text = angle
+                }
+
+            } // Connections
+
             GridLayout
             {
                 anchors.left: parent.left
@@ -186,6 +203,7 @@ Section
 
                 TextField
                 {
+                    id: angle_field
                     color: dark_theme_enabled ? "white" : "black"
                     placeholderText: "---"
                     placeholderTextColor: dark_theme_enabled ? "white" : "black"
@@ -212,6 +230,34 @@ Section
 
                 } // TextField
 
+                // Searches for the pass heading that surveys the selected
+                // zone in the least time
+                Button
+                {
+                    Layout.columnSpan: 2
+                    Layout.fillWidth: true
+                    text: qsTr("Optimize Angle")
+                    onPressed:
+                    {
+                        var id = vehicle_manager.get_selected_vehicle().get_vehicle_id()
+                        vehicle_manager.optimize_zone_angle(id, mission_data_model.get_selected_task_index())
+                    }
+                } // Button
+
+                // Splits the selected zone between its vehicle and the other
+                // selected vehicles
+                Button
+                {
+                    Layout.columnSpan: 2
+                    Layout.fillWidth: true
+                    text: qsTr("Split Between Vehicles")
+                    onPressed:
+                    {
+                        var id = vehicle_manager.get_selected_vehicle().get_vehicle_id()
+                        vehicle_manager.partition_zone(id, mission_data_model.get_selected_task_index())
+                    }
+                } // Button
+
             } // GridLayout
 
         } // Rectangle
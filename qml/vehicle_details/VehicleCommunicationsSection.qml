@@ -1,7 +1,8 @@
 //==============================================================================
 // Autonomous Vehicle Library
 //
-// Description: A section containing the vehicle communications log.
+// Description: A section containing the vehicle communications log and the
+//              link statistics for each comms channel.
 //==============================================================================
 
 // Qt imports
@@ -9,6 +10,8 @@ import QtQuick 2.13
 import QtQuick.Controls 2.13
 import QtQuick.Layouts 1.13
 
+import Avl 1.0
+
 // Custom QML imports
 import "qrc:///qml"
 
@@ -21,6 +24,36 @@ Section
 
     title: "Communication Log"
 
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    // Properties
+
+    // Selected vehicle, and its link statistics with one entry per comms
+    // channel, which update when the vehicle signals that they changed
+    property var selected_vehicle: vehicle_manager.get_selected_vehicle()
+    property var link_stats: selected_vehicle ? selected_vehicle.link_stats : []
+
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    // Functions
+
+    // Formats a byte count with a binary unit prefix
+    function format_bytes(bytes)
+    {
+        if (bytes < 1024) return bytes + " B";
+        else if (bytes < 1048576) return (bytes / 1024).toFixed(1) + " KB";
+        else return (bytes / 1048576).toFixed(1) + " MB";
+    }
+
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    // Components
+
+    // Connects to the vehicle manager's selection signal to show the link
+    // statistics of the newly selected vehicle
+    Connections
+    {
+        target: vehicle_manager
+        onVehicleSelectionChanged: selected_vehicle = vehicle_manager.get_selected_vehicle()
+    }
+
     header_content:
         RowLayout
         {
@@ -46,28 +79,89 @@ Section
         } // RowLayout
 
     body_content:
-        ScrollView
+        ColumnLayout
         {
 
-            id: scroll_view
             anchors.fill: parent
-            clip: true
 
-            TextArea
+            GridLayout
+            {
+
+                Layout.fillWidth: true
+                columns: 10
+
+                Repeater
+                {
+                    model: [ "Channel", "Pkts In", "Pkts Out", "Bytes In",
+                             "Bytes Out", "Checksum", "Parse", "Loss", "Age",
+                             "Latency" ]
+
+                    Label
+                    {
+                        text: modelData
+                        font.bold: true
+                        Layout.fillWidth: true
+                        horizontalAlignment: Text.AlignHCenter
+                    }
+
+                } // Repeater
+
+                Repeater
+                {
+                    model: link_stats
+
+                    Repeater
+                    {
+                        property var stats: modelData
+                        model: [ stats.comms_channel,
+                                 stats.packets_in,
+                                 stats.packets_out,
+                                 format_bytes(stats.bytes_in),
+                                 format_bytes(stats.bytes_out),
+                                 stats.checksum_failures,
+                                 stats.parse_errors,
+                                 stats.loss_percent.toFixed(1) + " %",
+                                 isNaN(stats.status_age) ? "-----" : stats.status_age.toFixed(0) + " sec",
+                                 isNaN(stats.mean_latency) ? "-----" : stats.mean_latency.toFixed(1) + " sec" ]
+
+                        Label
+                        {
+                            text: modelData
+                            Layout.fillWidth: true
+                            horizontalAlignment: Text.AlignHCenter
+                        }
+
+                    } // Repeater
+
+                } // Repeater
+
+            } // GridLayout
+
+            ScrollView
             {
 
-                id: text_area
-                text: format_responses(vehicle_responses)
-                topPadding: 20
-                leftPadding: 20
-                rightPadding: 20
-                wrapMode: Text.Wrap
-                readOnly: true
-                color: dark_theme_enabled ? "white" : "black"
+                id: scroll_view
+                Layout.fillWidth: true
+                Layout.fillHeight: true
+                clip: true
+
+                TextArea
+                {
+
+                    id: text_area
+                    text: format_responses(vehicle_responses)
+                    topPadding: 20
+                    leftPadding: 20
+                    rightPadding: 20
+                    wrapMode: Text.Wrap
+                    readOnly: true
+                    color: dark_theme_enabled ? "white" : "black"
+
+                } // TextArea
 
-            } // TextArea
+            } // ScrollView
 
-        } // ScrollView
+        } // ColumnLayout
 
     footer_color: dark_theme_enabled ? "black" : "white"
     footer_content:
@@ -78,6 +172,7 @@ Section
             onClicked:
             {
                 vehicle_manager.get_selected_vehicle().clear_vehicle_responses();
+                vehicle_manager.get_selected_vehicle().reset_link_stats();
                 vehicle_responses = [""];
             }
         } // Button
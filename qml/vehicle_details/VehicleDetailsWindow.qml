@@ -44,6 +44,10 @@ ApplicationWindow
     // Stores the age of the most recent status update
     property int status_age: 0
 
+    // Stores the age of the data in the most recent status update, measured
+    // from the status timestamp. NaN if the vehicle does not send timestamps
+    property real data_age: NaN
+
     // Stores the time since a mission was started
     property int mission_time: 0
 
@@ -87,6 +91,13 @@ ApplicationWindow
         return s;
     }
 
+    // Updates the data age from the timestamp of the stored vehicle status
+    function update_data_age()
+    {
+        var vehicle = vehicle_manager.get_selected_vehicle();
+        data_age = vehicle ? vehicle.get_data_age(vehicle_status.timestamp) : NaN;
+    }
+
     // Formats a list of vehicle responses (vector of QStrings) as a QString
     function format_responses(responses)
     {
@@ -132,6 +143,7 @@ ApplicationWindow
                 vehicle_status = new_status;
                 status_age = 0;
                 status_age_timer.restart();
+                update_data_age();
                 deckbox_distance = vehicle_manager.get_deckbox_distance(selected_vehicle_id);
                 deckbox_heading = vehicle_manager.get_deckbox_heading(selected_vehicle_id);
             }
@@ -141,7 +153,6 @@ ApplicationWindow
         {
             vehicle_status = vehicle_manager.get_selected_vehicle().get_vehicle_status();
             vehicle_responses = vehicle_manager.get_selected_vehicle().get_vehicle_responses();
-            mission_data_model.redraw();
             mission_time = vehicle_manager.get_selected_vehicle().get_mission_time();
             mission_distance = vehicle_manager.get_selected_vehicle().get_mission_distance();
             mission_duration = vehicle_manager.get_selected_vehicle().get_mission_duration();
@@ -178,7 +189,11 @@ ApplicationWindow
     {
         id: status_age_timer
         interval: 1000; running: true; repeat: true
-        onTriggered: status_age = status_age + 1
+        onTriggered:
+        {
+            status_age = status_age + 1;
+            update_data_age();
+        }
     }
     SplitView
     {
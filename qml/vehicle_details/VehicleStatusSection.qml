@@ -50,6 +50,16 @@ Section
                 verticalAlignment: Text.AlignVCenter
             }
 
+            Label
+            {
+                text: "Data Age:   " + (isNaN(data_age) ? "-----" : data_age.toFixed(1) + " sec")
+                Layout.fillWidth: true
+                font.pointSize: 12
+                font.bold: true
+                horizontalAlignment: Text.AlignHCenter
+                verticalAlignment: Text.AlignVCenter
+            }
+
             Label
             {
                 text: "Mission Time:   " + mission_time + " sec"
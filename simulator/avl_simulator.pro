@@ -0,0 +1,43 @@
+#===============================================================================
+# Autonomous Vehicle Library
+#
+# Description: AVL Fleet Simulator project file. Builds a headless simulator
+#              that shares the AVL protocol sources with the user interface.
+#===============================================================================
+
+#~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+# Configure project dependencies
+
+TEMPLATE = app
+
+QT = core network
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+TARGET = avl_simulator
+
+#~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+# Set up file includes
+
+HEADERS += \
+    ../include/comms/avl_commands.h \
+    ../include/comms/field.h \
+    ../include/comms/packet.h \
+    ../include/util/byte.h \
+    ../include/util/geo.h \
+    ../include/util/vector.h \
+    include/fleet_simulator.h \
+    include/simulated_vehicle.h
+
+SOURCES += \
+    ../src/comms/avl_commands.cpp \
+    ../src/comms/field.cpp \
+    ../src/comms/packet.cpp \
+    ../src/util/geo.cpp \
+    src/fleet_simulator.cpp \
+    src/main.cpp \
+    src/simulated_vehicle.cpp
+
+INCLUDEPATH += $$PWD/include
+INCLUDEPATH += $$PWD/../include
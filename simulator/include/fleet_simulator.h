@@ -0,0 +1,195 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Simulates a fleet of vehicles on one machine for testing the
+//              GUI without vehicles in the water. Every simulated vehicle
+//              multicasts STATUS packets to the status group and answers
+//              commands received over TCP on the vehicle port.
+//
+//              The GUI connects to each vehicle at 10.0.10.<id>, so those
+//              addresses must reach this machine. On Linux the whole subnet
+//              can be routed to the loopback interface with
+//                  ip route add local 10.0.10.0/24 dev lo
+//              All connections are accepted by a single TCP server, and
+//              commands are routed to a vehicle by their VEHICLE_ID field.
+//
+//              One timer steps every vehicle, and the status sends are
+//              spread evenly over the status period so that hundreds of
+//              vehicles do not send in bursts.
+//==============================================================================
+
+#ifndef FLEET_SIMULATOR_H
+#define FLEET_SIMULATOR_H
+
+// QObject base class
+#include <QObject>
+
+// Network communication
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QUdpSocket>
+
+// Simulation timing
+#include <QTimer>
+#include <QElapsedTimer>
+
+// Simulated vehicles
+#include "simulated_vehicle.h"
+
+// C++ includes
+#include <map>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+class FleetSimulator : public QObject
+{
+
+    Q_OBJECT
+
+public:
+
+    // Multicast group and port that STATUS packets are sent to
+    static constexpr const char* STATUS_ADDRESS = "224.0.0.138";
+    static const quint16 STATUS_PORT = 1338;
+
+    // TCP port that vehicles accept command connections on
+    static const quint16 COMMAND_PORT = 1338;
+
+    // Interval between simulation steps in milliseconds
+    static const int STEP_INTERVAL_MS = 100;
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        FleetSimulator constructor
+    // Description: Constructs a simulator with no vehicles.
+    // Arguments:   - status_rate: STATUS packets sent per second by each
+    //                vehicle
+    //              - parent: parent QObject
+    //--------------------------------------------------------------------------
+    FleetSimulator(double status_rate, QObject* parent=nullptr);
+
+    //--------------------------------------------------------------------------
+    // Name:        FleetSimulator destructor
+    // Description: Default destructor.
+    //--------------------------------------------------------------------------
+    ~FleetSimulator();
+
+    //--------------------------------------------------------------------------
+    // Name:        add_vehicle
+    // Description: Adds a simulated vehicle. Throws a std::runtime_error if
+    //              a vehicle with the same ID exists.
+    // Arguments:   - id: vehicle ID
+    //              - lat: starting latitude in degrees
+    //              - lon: starting longitude in degrees
+    //              - yaw: starting heading in degrees
+    //--------------------------------------------------------------------------
+    void add_vehicle(uint8_t id, double lat, double lon, double yaw);
+
+    //--------------------------------------------------------------------------
+    // Name:        start
+    // Description: Starts listening for command connections and starts the
+    //              simulation. Throws a std::runtime_error if the command
+    //              port cannot be opened.
+    // Arguments:   - address: local address to accept connections on
+    //--------------------------------------------------------------------------
+    void start(QHostAddress address);
+
+private:
+
+    // Per connection state. TCP is a stream, so received bytes are kept
+    // until they form whole packets
+    struct Connection
+    {
+        QTcpSocket* socket;
+        std::vector<uint8_t> buffer;
+    };
+
+private:
+
+    // Simulated vehicles and their indices by vehicle ID
+    std::vector<std::unique_ptr<SimulatedVehicle>> vehicles;
+    std::map<uint8_t, size_t> vehicle_indices;
+
+    // Status period in seconds, and the time of the next status of each
+    // vehicle in seconds since the simulation started
+    double status_period;
+    std::vector<double> next_status_times;
+
+    // Sockets
+    QUdpSocket udp_socket;
+    QTcpServer tcp_server;
+    std::map<QTcpSocket*, Connection> connections;
+
+    // Simulation timer and the elapsed simulation time at the last step
+    QTimer step_timer;
+    QElapsedTimer elapsed_timer;
+    double last_step_time = 0.0;
+
+private slots:
+
+    //--------------------------------------------------------------------------
+    // Name:        step_timer_timeout
+    // Description: Slot that is called on each simulation step. Steps every
+    //              vehicle and sends the statuses that are due.
+    //--------------------------------------------------------------------------
+    void step_timer_timeout();
+
+    //--------------------------------------------------------------------------
+    // Name:        new_connection
+    // Description: Slot that is called when the TCP server has a pending
+    //              connection.
+    //--------------------------------------------------------------------------
+    void new_connection();
+
+    //--------------------------------------------------------------------------
+    // Name:        socket_ready_read
+    // Description: Slot that is called when a connection has data to read.
+    //              Handles every whole packet received.
+    //--------------------------------------------------------------------------
+    void socket_ready_read();
+
+    //--------------------------------------------------------------------------
+    // Name:        socket_disconnected
+    // Description: Slot that is called when a connection closes.
+    //--------------------------------------------------------------------------
+    void socket_disconnected();
+
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        handle_packet
+    // Description: Passes a command packet to the vehicle it is addressed to
+    //              and writes the responses back to the connection.
+    // Arguments:   - socket: connection the packet was received on
+    //              - packet: command packet
+    //--------------------------------------------------------------------------
+    void handle_packet(QTcpSocket* socket, avl::Packet packet);
+
+    //--------------------------------------------------------------------------
+    // Name:        extract_packet
+    // Description: Removes the first whole packet from a receive buffer.
+    //              Bytes that cannot start a packet are discarded.
+    // Arguments:   - buffer: receive buffer
+    //              - packet_bytes: set to the packet bytes
+    // Returns:     True if a whole packet was removed, false if more bytes
+    //              are needed.
+    //--------------------------------------------------------------------------
+    static bool extract_packet(std::vector<uint8_t>& buffer,
+                               std::vector<uint8_t>& packet_bytes);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_time
+    // Description: Gets the current time.
+    // Returns:     Current time in seconds since epoch.
+    //--------------------------------------------------------------------------
+    static double get_time();
+
+};
+
+#endif // FLEET_SIMULATOR_H
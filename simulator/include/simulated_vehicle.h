@@ -0,0 +1,298 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: A simulated vehicle that speaks the AVL protocol. It answers
+//              command packets the way a vehicle does, flies uploaded
+//              missions with a simple kinematic model, and builds the STATUS
+//              packets that a vehicle multicasts.
+//
+//              The model is a constant speed point that turns towards its
+//              target at a limited rate. Positions are integrated on a flat
+//              earth around the current position, which is accurate enough
+//              for missions a few kilometers across.
+//==============================================================================
+
+#ifndef SIMULATED_VEHICLE_H
+#define SIMULATED_VEHICLE_H
+
+// AVL packets
+#include "comms/avl_commands.h"
+
+// C++ includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//==============================================================================
+//                              CLASS DECLARATION
+//==============================================================================
+
+class SimulatedVehicle
+{
+
+public:
+
+    // Speed in meters per second used when a task does not set one
+    static constexpr double DEFAULT_SPEED = 1.5;
+
+    // Speed in meters per second at full helm throttle
+    static constexpr double MAX_SPEED = 2.5;
+
+    // Maximum turn rate in degrees per second
+    static constexpr double MAX_TURN_RATE = 30.0;
+
+    // Distance in meters at which a waypoint counts as reached
+    static constexpr double DEFAULT_ACCEPTANCE_RADIUS = 5.0;
+
+public:
+
+    //--------------------------------------------------------------------------
+    // Name:        SimulatedVehicle constructor
+    // Description: Constructs a stopped vehicle in manual mode with an empty
+    //              mission.
+    // Arguments:   - id: vehicle ID, which is also the last byte of the
+    //                vehicle's IP address
+    //              - lat: starting latitude in degrees
+    //              - lon: starting longitude in degrees
+    //              - yaw: starting heading in degrees
+    //--------------------------------------------------------------------------
+    SimulatedVehicle(uint8_t id, double lat, double lon, double yaw);
+
+    //--------------------------------------------------------------------------
+    // Name:        SimulatedVehicle destructor
+    // Description: Default destructor.
+    //--------------------------------------------------------------------------
+    virtual ~SimulatedVehicle();
+
+    //--------------------------------------------------------------------------
+    // Name:        get_id
+    // Description: Gets the vehicle ID.
+    // Returns:     Vehicle ID.
+    //--------------------------------------------------------------------------
+    uint8_t get_id() const;
+
+    //--------------------------------------------------------------------------
+    // Name:        handle_packet
+    // Description: Handles a command packet addressed to the vehicle and
+    //              builds the packets to send back. Each command field is
+    //              answered with a RESPONSE packet.
+    // Arguments:   - packet: command packet
+    //              - t: current time in seconds since epoch
+    // Returns:     RESPONSE packets to send back.
+    //--------------------------------------------------------------------------
+    std::vector<avl::Packet> handle_packet(avl::Packet packet, double t);
+
+    //--------------------------------------------------------------------------
+    // Name:        step
+    // Description: Advances the vehicle state by a time step.
+    // Arguments:   - dt: time step in seconds
+    //--------------------------------------------------------------------------
+    void step(double dt);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_status_packet
+    // Description: Builds a STATUS packet from the current vehicle state.
+    // Arguments:   - t: current time in seconds since epoch
+    // Returns:     STATUS packet.
+    //--------------------------------------------------------------------------
+    avl::Packet get_status_packet(double t);
+
+private:
+
+    // Mission task as flown by the simulator. Task fields that were not
+    // in the uploaded packet are NaN
+    struct SimulatedTask
+    {
+        avl::Packet packet;
+        std::vector<double> lats;
+        std::vector<double> lons;
+        double duration;
+        double speed;
+        double yaw;
+        double depth;
+    };
+
+    // Simulated parameter, stored in the format of a PARAMETER packet
+    struct SimulatedParam
+    {
+        std::string name;
+        std::string type;
+        std::vector<uint8_t> value;
+    };
+
+private:
+
+    // Vehicle ID
+    uint8_t id;
+
+    // Kinematic state. Angles are in degrees, speeds in meters per second
+    double lat;
+    double lon;
+    double yaw;
+    double speed = 0.0;
+    double depth = 0.0;
+
+    // Mode and operational status strings as reported in STATUS packets
+    std::string mode = "MANUAL";
+    std::string operational_status = "READY";
+
+    // Helm commands used in manual mode. Throttle is in percent and rudder
+    // angle in degrees
+    double helm_throttle = 0.0;
+    double helm_rudder = 0.0;
+
+    // Mission, the index of the task being flown, the index of the next
+    // point in that task, and the time spent on the task
+    std::vector<SimulatedTask> mission;
+    size_t current_task = 0;
+    size_t current_point = 0;
+    double task_time = 0.0;
+    bool mission_running = false;
+
+    // Simulated parameters
+    std::vector<SimulatedParam> params;
+
+private:
+
+    //--------------------------------------------------------------------------
+    // Name:        handle_action
+    // Description: Handles an ACTION packet field.
+    // Arguments:   - field: ACTION packet field
+    //              - t: current time in seconds since epoch
+    // Returns:     Data for the RESPONSE packet.
+    //--------------------------------------------------------------------------
+    std::vector<uint8_t> handle_action(avl::Field field, double t);
+
+    //--------------------------------------------------------------------------
+    // Name:        handle_mission
+    // Description: Handles a MISSION packet field.
+    // Arguments:   - field: MISSION packet field
+    // Returns:     Data for the RESPONSE packet.
+    //--------------------------------------------------------------------------
+    std::vector<uint8_t> handle_mission(avl::Field field);
+
+    //--------------------------------------------------------------------------
+    // Name:        handle_helm
+    // Description: Handles a HELM packet field.
+    // Arguments:   - field: HELM packet field
+    // Returns:     Data for the RESPONSE packet.
+    //--------------------------------------------------------------------------
+    std::vector<uint8_t> handle_helm(avl::Field field);
+
+    //--------------------------------------------------------------------------
+    // Name:        handle_parameter_list
+    // Description: Handles a PARAMETER_LIST packet field.
+    // Arguments:   - field: PARAMETER_LIST packet field
+    // Returns:     Data for the RESPONSE packet.
+    //--------------------------------------------------------------------------
+    std::vector<uint8_t> handle_parameter_list(avl::Field field);
+
+    //--------------------------------------------------------------------------
+    // Name:        append_task
+    // Description: Appends a task to the mission from a TASK packet.
+    // Arguments:   - task_packet: TASK packet
+    //--------------------------------------------------------------------------
+    void append_task(avl::Packet task_packet);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_mission_bytes
+    // Description: Gets the mission as concatenated TASK packet bytes, with
+    //              each task sent back as it was uploaded.
+    // Returns:     Mission bytes.
+    //--------------------------------------------------------------------------
+    std::vector<uint8_t> get_mission_bytes();
+
+    //--------------------------------------------------------------------------
+    // Name:        get_parameter_list_bytes
+    // Description: Gets the bytes of a PARAMETER_LIST packet holding every
+    //              simulated parameter.
+    // Returns:     PARAMETER_LIST packet bytes.
+    //--------------------------------------------------------------------------
+    std::vector<uint8_t> get_parameter_list_bytes();
+
+    //--------------------------------------------------------------------------
+    // Name:        set_param
+    // Description: Sets a simulated parameter, adding it if it does not
+    //              exist.
+    // Arguments:   - name: parameter name
+    //              - type: parameter type string
+    //              - value: parameter value bytes
+    //--------------------------------------------------------------------------
+    void set_param(std::string name, std::string type, std::vector<uint8_t> value);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_double_param
+    // Description: Gets a simulated double parameter.
+    // Arguments:   - name: parameter name
+    //              - default_value: value returned if the parameter does not
+    //                exist or is not a double
+    // Returns:     Parameter value.
+    //--------------------------------------------------------------------------
+    double get_double_param(std::string name, double default_value);
+
+    //--------------------------------------------------------------------------
+    // Name:        fly_task
+    // Description: Advances the current mission task by a time step, moving
+    //              on to the next task when it is complete.
+    // Arguments:   - dt: time step in seconds
+    //--------------------------------------------------------------------------
+    void fly_task(double dt);
+
+    //--------------------------------------------------------------------------
+    // Name:        next_task
+    // Description: Moves on to the next mission task, stopping the mission
+    //              after the last one.
+    //--------------------------------------------------------------------------
+    void next_task();
+
+    //--------------------------------------------------------------------------
+    // Name:        stop_mission
+    // Description: Stops the mission and the vehicle.
+    //--------------------------------------------------------------------------
+    void stop_mission();
+
+    //--------------------------------------------------------------------------
+    // Name:        turn_towards
+    // Description: Turns the vehicle towards a heading by at most the
+    //              maximum turn rate.
+    // Arguments:   - target_yaw: heading to turn to in degrees
+    //              - dt: time step in seconds
+    //--------------------------------------------------------------------------
+    void turn_towards(double target_yaw, double dt);
+
+    //--------------------------------------------------------------------------
+    // Name:        move
+    // Description: Moves the vehicle along its heading at its speed.
+    // Arguments:   - dt: time step in seconds
+    //--------------------------------------------------------------------------
+    void move(double dt);
+
+    //--------------------------------------------------------------------------
+    // Name:        get_task_percent
+    // Description: Gets the completion percentage of the current task.
+    // Returns:     Task completion percentage.
+    //--------------------------------------------------------------------------
+    double get_task_percent();
+
+    //--------------------------------------------------------------------------
+    // Name:        make_response
+    // Description: Builds a RESPONSE packet.
+    // Arguments:   - packet_descriptor: descriptor of the command packet
+    //              - field_descriptor: descriptor of the command field
+    //              - data: response data
+    // Returns:     RESPONSE packet.
+    //--------------------------------------------------------------------------
+    avl::Packet make_response(uint8_t packet_descriptor, uint8_t field_descriptor,
+                              std::vector<uint8_t> data);
+
+    //--------------------------------------------------------------------------
+    // Name:        to_data
+    // Description: Converts a response message to response data bytes.
+    // Arguments:   - message: response message
+    // Returns:     Message bytes.
+    //--------------------------------------------------------------------------
+    static std::vector<uint8_t> to_data(std::string message);
+
+};
+
+#endif // SIMULATED_VEHICLE_H
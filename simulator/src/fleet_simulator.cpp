@@ -0,0 +1,303 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Simulates a fleet of vehicles on one machine for testing the
+//              GUI without vehicles in the water. Every simulated vehicle
+//              multicasts STATUS packets to the status group and answers
+//              commands received over TCP on the vehicle port.
+//==============================================================================
+
+#include "fleet_simulator.h"
+
+// Current time
+#include <QDateTime>
+
+// Debug logging
+#include <QDebug>
+
+// Byte and vector utilities
+#include <util/byte.h>
+#include <util/vector.h>
+
+// C++ includes
+#include <algorithm>
+#include <stdexcept>
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        FleetSimulator constructor
+// Description: Constructs a simulator with no vehicles.
+// Arguments:   - status_rate: STATUS packets sent per second by each
+//                vehicle
+//              - parent: parent QObject
+//------------------------------------------------------------------------------
+FleetSimulator::FleetSimulator(double status_rate, QObject* parent) :
+    QObject(parent), status_period(1.0 / std::max(status_rate, 0.01))
+{
+
+    // Status packets stay on the local network, and are looped back so
+    // that a GUI on this machine receives them
+    udp_socket.setSocketOption(QAbstractSocket::MulticastTtlOption, 1);
+    udp_socket.setSocketOption(QAbstractSocket::MulticastLoopbackOption, 1);
+
+    connect(&tcp_server, &QTcpServer::newConnection,
+            this, &FleetSimulator::new_connection);
+    connect(&step_timer, &QTimer::timeout,
+            this, &FleetSimulator::step_timer_timeout);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        FleetSimulator destructor
+// Description: Default destructor.
+//------------------------------------------------------------------------------
+FleetSimulator::~FleetSimulator()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        add_vehicle
+// Description: Adds a simulated vehicle. Throws a std::runtime_error if
+//              a vehicle with the same ID exists.
+// Arguments:   - id: vehicle ID
+//              - lat: starting latitude in degrees
+//              - lon: starting longitude in degrees
+//              - yaw: starting heading in degrees
+//------------------------------------------------------------------------------
+void FleetSimulator::add_vehicle(uint8_t id, double lat, double lon, double yaw)
+{
+
+    if (vehicle_indices.count(id))
+        throw std::runtime_error("add_vehicle: vehicle " + std::to_string(id) + " already exists");
+
+    vehicle_indices[id] = vehicles.size();
+    vehicles.emplace_back(new SimulatedVehicle(id, lat, lon, yaw));
+    next_status_times.push_back(0.0);
+
+    // Spread the status sends of all vehicles evenly over the period
+    for (size_t i = 0; i < next_status_times.size(); i++)
+        next_status_times[i] = status_period * i / next_status_times.size();
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        start
+// Description: Starts listening for command connections and starts the
+//              simulation. Throws a std::runtime_error if the command
+//              port cannot be opened.
+// Arguments:   - address: local address to accept connections on
+//------------------------------------------------------------------------------
+void FleetSimulator::start(QHostAddress address)
+{
+
+    if (!tcp_server.listen(address, COMMAND_PORT))
+        throw std::runtime_error("start: failed to listen on port " +
+                                 std::to_string(COMMAND_PORT) + " (" +
+                                 tcp_server.errorString().toStdString() + ")");
+
+    elapsed_timer.start();
+    last_step_time = 0.0;
+    step_timer.start(STEP_INTERVAL_MS);
+
+    qDebug() << "simulating" << vehicles.size() << "vehicles, accepting commands on"
+             << address.toString() << "port" << COMMAND_PORT;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        step_timer_timeout
+// Description: Slot that is called on each simulation step. Steps every
+//              vehicle and sends the statuses that are due.
+//------------------------------------------------------------------------------
+void FleetSimulator::step_timer_timeout()
+{
+
+    // Step by the time that actually passed, so that a late timer does not
+    // slow the vehicles down
+    double now = elapsed_timer.nsecsElapsed() / 1e9;
+    double dt = now - last_step_time;
+    last_step_time = now;
+
+    double t = get_time();
+    QHostAddress status_address(STATUS_ADDRESS);
+
+    for (size_t i = 0; i < vehicles.size(); i++)
+    {
+
+        vehicles[i]->step(dt);
+
+        if (now < next_status_times[i])
+            continue;
+
+        // Statuses that fell more than a period behind are skipped rather
+        // than sent in a burst
+        next_status_times[i] = std::max(next_status_times[i] + status_period, now);
+
+        std::vector<uint8_t> bytes = vehicles[i]->get_status_packet(t).get_bytes();
+        udp_socket.writeDatagram(reinterpret_cast<const char*>(bytes.data()),
+                                 static_cast<qint64>(bytes.size()),
+                                 status_address, STATUS_PORT);
+
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        new_connection
+// Description: Slot that is called when the TCP server has a pending
+//              connection.
+//------------------------------------------------------------------------------
+void FleetSimulator::new_connection()
+{
+
+    while (tcp_server.hasPendingConnections())
+    {
+
+        QTcpSocket* socket = tcp_server.nextPendingConnection();
+        connections[socket] = Connection{socket, {}};
+
+        connect(socket, &QTcpSocket::readyRead,
+                this, &FleetSimulator::socket_ready_read);
+        connect(socket, &QTcpSocket::disconnected,
+                this, &FleetSimulator::socket_disconnected);
+
+        qDebug() << "accepted connection to" << socket->localAddress().toString()
+                 << "from" << socket->peerAddress().toString();
+
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        socket_ready_read
+// Description: Slot that is called when a connection has data to read.
+//              Handles every whole packet received.
+//------------------------------------------------------------------------------
+void FleetSimulator::socket_ready_read()
+{
+
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (socket == nullptr || !connections.count(socket))
+        return;
+
+    QByteArray data = socket->readAll();
+    std::vector<uint8_t>& buffer = connections[socket].buffer;
+    buffer.insert(buffer.end(), data.begin(), data.end());
+
+    std::vector<uint8_t> packet_bytes;
+    while (extract_packet(buffer, packet_bytes))
+    {
+        try
+        {
+            handle_packet(socket, avl::Packet(packet_bytes));
+        }
+        catch (const std::exception& ex)
+        {
+            qDebug() << "ignoring invalid packet from" << socket->peerAddress().toString()
+                     << "(" << ex.what() << ")";
+        }
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        socket_disconnected
+// Description: Slot that is called when a connection closes.
+//------------------------------------------------------------------------------
+void FleetSimulator::socket_disconnected()
+{
+
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (socket == nullptr)
+        return;
+
+    connections.erase(socket);
+    socket->deleteLater();
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        handle_packet
+// Description: Passes a command packet to the vehicle it is addressed to
+//              and writes the responses back to the connection.
+// Arguments:   - socket: connection the packet was received on
+//              - packet: command packet
+//------------------------------------------------------------------------------
+void FleetSimulator::handle_packet(QTcpSocket* socket, avl::Packet packet)
+{
+
+    if (!packet.has_field(VEHICLE_ID_DESC))
+    {
+        qDebug() << "ignoring packet without vehicle ID from" << socket->peerAddress().toString();
+        return;
+    }
+
+    uint8_t id = packet.get_field(VEHICLE_ID_DESC).get_data().at(0);
+    auto it = vehicle_indices.find(id);
+    if (it == vehicle_indices.end())
+    {
+        qDebug() << "ignoring packet for unknown vehicle" << static_cast<int>(id);
+        return;
+    }
+
+    std::vector<avl::Packet> responses = vehicles[it->second]->handle_packet(packet, get_time());
+    for (avl::Packet& response : responses)
+    {
+        std::vector<uint8_t> bytes = response.get_bytes();
+        socket->write(reinterpret_cast<const char*>(bytes.data()),
+                      static_cast<qint64>(bytes.size()));
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        extract_packet
+// Description: Removes the first whole packet from a receive buffer.
+//              Bytes that cannot start a packet are discarded.
+// Arguments:   - buffer: receive buffer
+//              - packet_bytes: set to the packet bytes
+// Returns:     True if a whole packet was removed, false if more bytes
+//              are needed.
+//------------------------------------------------------------------------------
+bool FleetSimulator::extract_packet(std::vector<uint8_t>& buffer,
+                                    std::vector<uint8_t>& packet_bytes)
+{
+
+    auto header = std::search(buffer.begin(), buffer.end(),
+                              AVL_PACKET_HEADER.begin(),
+                              AVL_PACKET_HEADER.end());
+    // Discard bytes up to the next packet header, keeping a trailing byte
+    // that could be the start of a header split across reads
+    if (header == buffer.end() && !buffer.empty() &&
+        buffer.back() == AVL_PACKET_HEADER.front())
+        header--;
+    buffer.erase(buffer.begin(), header);
+
+    // The total length of a packet is the two header bytes, the packet
+    // descriptor and payload length bytes, the payload size, and the two
+    // checksum bytes
+    if (buffer.size() < 5)
+        return false;
+    size_t packet_length = 2 + 3 + avl::from_bytes_at<uint16_t>(buffer, 3) + 2;
+    if (buffer.size() < packet_length)
+        return false;
+
+    packet_bytes.assign(buffer.begin(), buffer.begin() + packet_length);
+    buffer.erase(buffer.begin(), buffer.begin() + packet_length);
+    return true;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_time
+// Description: Gets the current time.
+// Returns:     Current time in seconds since epoch.
+//------------------------------------------------------------------------------
+double FleetSimulator::get_time()
+{
+    return QDateTime::currentMSecsSinceEpoch() / 1000.0;
+}
@@ -0,0 +1,93 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: AVL fleet simulator main file. Simulates a fleet of vehicles
+//              laid out in a grid, each of which multicasts status and
+//              accepts commands like a vehicle in the water.
+//==============================================================================
+
+// Qt includes
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QHostAddress>
+
+// AVL includes
+#include "fleet_simulator.h"
+#include "util/geo.h"
+
+// C++ includes
+#include <cmath>
+
+//==============================================================================
+//                                  MAIN
+//==============================================================================
+
+int main(int argc, char *argv[])
+{
+
+    QCoreApplication application(argc, argv);
+    QCoreApplication::setOrganizationName("ASCL");
+    QCoreApplication::setApplicationName("AVL Fleet Simulator");
+
+    // Configure the command line options
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Simulates a fleet of AVL vehicles");
+    parser.addHelpOption();
+    QCommandLineOption count_option({"n", "count"},
+        "Number of vehicles to simulate.", "count", "10");
+    QCommandLineOption first_id_option("first-id",
+        "ID of the first vehicle. Vehicles are numbered consecutively.", "id", "1");
+    QCommandLineOption rate_option("status-rate",
+        "STATUS packets sent per second by each vehicle.", "hz", "1");
+    QCommandLineOption lat_option("lat",
+        "Latitude of the first vehicle in degrees.", "degrees", "37.2296");
+    QCommandLineOption lon_option("lon",
+        "Longitude of the first vehicle in degrees.", "degrees", "-80.4139");
+    QCommandLineOption spacing_option("spacing",
+        "Distance between vehicles in the starting grid in meters.", "meters", "20");
+    QCommandLineOption address_option("address",
+        "Local address to accept command connections on.", "address", "0.0.0.0");
+    parser.addOptions({count_option, first_id_option, rate_option, lat_option,
+                       lon_option, spacing_option, address_option});
+    parser.process(application);
+
+    // Vehicle IP addresses end in the vehicle ID, so IDs are limited to the
+    // host addresses of a /24 subnet
+    int count = parser.value(count_option).toInt();
+    int first_id = parser.value(first_id_option).toInt();
+    if (count < 1 || first_id < 1 || first_id + count - 1 > 254)
+    {
+        qCritical() << "vehicle IDs must be between 1 and 254";
+        return 1;
+    }
+
+    FleetSimulator simulator(parser.value(rate_option).toDouble());
+
+    // Lay the vehicles out in a square grid facing north
+    double lat = parser.value(lat_option).toDouble();
+    double lon = parser.value(lon_option).toDouble();
+    double spacing = parser.value(spacing_option).toDouble();
+    int columns = static_cast<int>(std::ceil(std::sqrt(count)));
+    avl::geo::EnuFrame grid_frame(lat, lon);
+    for (int i = 0; i < count; i++)
+    {
+        double vehicle_lat, vehicle_lon;
+        grid_frame.to_wgs84(spacing * (i % columns), spacing * (i / columns),
+                            vehicle_lat, vehicle_lon);
+        simulator.add_vehicle(static_cast<uint8_t>(first_id + i), vehicle_lat, vehicle_lon, 0.0);
+    }
+
+    try
+    {
+        simulator.start(QHostAddress(parser.value(address_option)));
+    }
+    catch (const std::exception& ex)
+    {
+        qCritical() << ex.what();
+        return 1;
+    }
+
+    return application.exec();
+
+}
@@ -0,0 +1,684 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: A simulated vehicle that speaks the AVL protocol. It answers
+//              command packets the way a vehicle does, flies uploaded
+//              missions with a simple kinematic model, and builds the STATUS
+//              packets that a vehicle multicasts.
+//==============================================================================
+
+#include "simulated_vehicle.h"
+
+// Byte and vector utilities
+#include <util/byte.h>
+#include <util/vector.h>
+
+// Waypoint distances and bearings, and dead reckoning
+#include <util/geo.h>
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+
+using avl::geo::DEGREES_TO_RADIANS;
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+constexpr double SimulatedVehicle::DEFAULT_SPEED;
+constexpr double SimulatedVehicle::MAX_SPEED;
+constexpr double SimulatedVehicle::MAX_TURN_RATE;
+constexpr double SimulatedVehicle::DEFAULT_ACCEPTANCE_RADIUS;
+
+//------------------------------------------------------------------------------
+// Name:        SimulatedVehicle constructor
+// Description: Constructs a stopped vehicle in manual mode with an empty
+//              mission.
+// Arguments:   - id: vehicle ID, which is also the last byte of the
+//                vehicle's IP address
+//              - lat: starting latitude in degrees
+//              - lon: starting longitude in degrees
+//              - yaw: starting heading in degrees
+//------------------------------------------------------------------------------
+SimulatedVehicle::SimulatedVehicle(uint8_t id, double lat, double lon, double yaw) :
+    id(id), lat(lat), lon(lon), yaw(yaw)
+{
+
+    // A few parameters of each type so that the parameter editor has
+    // something to show. The speed and acceptance radius are used by the
+    // kinematic model
+    set_param("mission/default_speed", "double", avl::to_bytes(DEFAULT_SPEED));
+    set_param("mission/acceptance_radius", "double", avl::to_bytes(DEFAULT_ACCEPTANCE_RADIUS));
+    set_param("safety/max_depth", "float", avl::to_bytes(20.0f));
+    set_param("safety/timeout", "int", avl::to_bytes(60));
+    set_param("sonar/enabled", "bool", avl::to_bytes(false));
+    std::string name = "sim_" + std::to_string(id);
+    set_param("vehicle/name", "string", std::vector<uint8_t>(name.begin(), name.end()));
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        SimulatedVehicle destructor
+// Description: Default destructor.
+//------------------------------------------------------------------------------
+SimulatedVehicle::~SimulatedVehicle()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_id
+// Description: Gets the vehicle ID.
+// Returns:     Vehicle ID.
+//------------------------------------------------------------------------------
+uint8_t SimulatedVehicle::get_id() const
+{
+    return id;
+}
+
+//------------------------------------------------------------------------------
+// Name:        handle_packet
+// Description: Handles a command packet addressed to the vehicle and
+//              builds the packets to send back. Each command field is
+//              answered with a RESPONSE packet.
+// Arguments:   - packet: command packet
+//              - t: current time in seconds since epoch
+// Returns:     RESPONSE packets to send back.
+//------------------------------------------------------------------------------
+std::vector<avl::Packet> SimulatedVehicle::handle_packet(avl::Packet packet, double t)
+{
+
+    std::vector<avl::Packet> responses;
+    uint8_t packet_descriptor = packet.get_descriptor();
+
+    for (const avl::Field& field : packet.get_fields())
+    {
+
+        // The global fields describe the packet rather than command the
+        // vehicle, so they are not answered
+        uint8_t field_descriptor = field.get_descriptor();
+        if (field_descriptor == VEHICLE_ID_DESC ||
+            field_descriptor == COMMS_CHANNEL_DESC)
+            continue;
+
+        // Parameter list sizes only accompany parameter lists
+        if (packet_descriptor == PARAMETER_LIST_PACKET_DESC &&
+            field_descriptor == PARAMETER_LIST_SIZE_DESC)
+            continue;
+
+        std::vector<uint8_t> data;
+        try
+        {
+            switch (packet_descriptor)
+            {
+                case ACTION_PACKET_DESC:
+                    data = handle_action(field, t);
+                    break;
+                case MISSION_PACKET_DESC:
+                    data = handle_mission(field);
+                    break;
+                case HELM_PACKET_DESC:
+                    data = handle_helm(field);
+                    break;
+                case PARAMETER_LIST_PACKET_DESC:
+                    data = handle_parameter_list(field);
+                    break;
+                default:
+                    data = to_data("unsupported packet descriptor " +
+                                   avl::byte_to_hex(packet_descriptor));
+                    break;
+            }
+        }
+        catch (const std::exception& ex)
+        {
+            data = to_data(std::string("invalid command (") + ex.what() + ")");
+        }
+
+        responses.push_back(make_response(packet_descriptor, field_descriptor, data));
+
+    }
+
+    return responses;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        step
+// Description: Advances the vehicle state by a time step.
+// Arguments:   - dt: time step in seconds
+//------------------------------------------------------------------------------
+void SimulatedVehicle::step(double dt)
+{
+
+    if (operational_status != "READY")
+    {
+        speed = 0.0;
+        return;
+    }
+
+    if (mode == "AUTONOMOUS" && mission_running)
+    {
+        fly_task(dt);
+    }
+    else if (mode == "MANUAL")
+    {
+        // Full rudder turns at the maximum turn rate
+        speed = MAX_SPEED * std::max(0.0, std::min(helm_throttle, 100.0)) / 100.0;
+        double turn_rate = MAX_TURN_RATE * std::max(-1.0, std::min(helm_rudder / 45.0, 1.0));
+        turn_towards(yaw + turn_rate * dt, dt);
+        move(dt);
+    }
+    else
+    {
+        speed = 0.0;
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_status_packet
+// Description: Builds a STATUS packet from the current vehicle state.
+// Arguments:   - t: current time in seconds since epoch
+// Returns:     STATUS packet.
+//------------------------------------------------------------------------------
+avl::Packet SimulatedVehicle::get_status_packet(double t)
+{
+
+    double vn = speed * std::cos(yaw * DEGREES_TO_RADIANS);
+    double ve = speed * std::sin(yaw * DEGREES_TO_RADIANS);
+
+    // The task number is one based while a mission is running and zero
+    // otherwise
+    uint8_t task_num = mission_running ? static_cast<uint8_t>(current_task + 1) : 0;
+    uint8_t num_tasks = static_cast<uint8_t>(std::min<size_t>(mission.size(), 255));
+
+    avl::Packet packet = STATUS_PACKET();
+    packet.add_field(VEHICLE_ID(id));
+    packet.add_field(COMMS_CHANNEL(COMMS_CHANNEL_RADIO));
+    packet.add_field(STATUS_MODE(mode));
+    packet.add_field(STATUS_OPERATIONAL_STATUS(operational_status));
+    packet.add_field(STATUS_ATTITUDE(0.0, 0.0, yaw));
+    packet.add_field(STATUS_VELOCITY(vn, ve, 0.0));
+    packet.add_field(STATUS_POSITION(lat, lon, -depth));
+    packet.add_field(STATUS_DEPTH(depth));
+    packet.add_field(STATUS_HEIGHT(std::nan("")));
+    packet.add_field(STATUS_RPM(speed / MAX_SPEED * 2000.0));
+    packet.add_field(STATUS_VOLTAGE(16.0));
+    packet.add_field(STATUS_UMODEM_SYNCED(true));
+    packet.add_field(STATUS_GPS_SATS(depth > 0.5 ? 0 : 12));
+    packet.add_field(STATUS_IRIDIUM_STRENGTH(depth > 0.5 ? 0 : 5));
+    packet.add_field(STATUS_TASK(task_num, num_tasks, get_task_percent()));
+    packet.add_field(STATUS_TIMESTAMP(t));
+    return packet;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        handle_action
+// Description: Handles an ACTION packet field.
+// Arguments:   - field: ACTION packet field
+//              - t: current time in seconds since epoch
+// Returns:     Data for the RESPONSE packet.
+//------------------------------------------------------------------------------
+std::vector<uint8_t> SimulatedVehicle::handle_action(avl::Field field, double t)
+{
+
+    std::vector<uint8_t> data = field.get_data();
+
+    switch (field.get_descriptor())
+    {
+
+        // Timestamped pings are answered with the originate time and the
+        // receive and transmit times, which are the same here
+        case ACTION_PING_DESC:
+        {
+            if (data.size() != sizeof(double))
+                return to_data("pong");
+            std::vector<uint8_t> times = data;
+            avl::append(times, avl::to_bytes(t));
+            avl::append(times, avl::to_bytes(t));
+            return times;
+        }
+
+        case ACTION_EMERGENCY_STOP_DESC:
+            stop_mission();
+            operational_status = "EMERGENCY STOP";
+            return to_data("emergency stop");
+
+        case ACTION_RESET_SAFETY_DESC:
+            operational_status = "READY";
+            return to_data("safety reset");
+
+        case ACTION_SET_MODE_DESC:
+        {
+            std::string new_mode(data.begin(), data.end());
+            if (new_mode != "MANUAL" && new_mode != "AUTONOMOUS")
+                return to_data("unknown mode " + new_mode);
+            mode = new_mode;
+            helm_throttle = 0.0;
+            helm_rudder = 0.0;
+            return to_data("mode set to " + mode);
+        }
+
+        case ACTION_SET_GEOFENCE_DESC:
+            return to_data("geofence set");
+
+        default:
+            return to_data("action " + avl::byte_to_hex(field.get_descriptor()) + " done");
+
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        handle_mission
+// Description: Handles a MISSION packet field.
+// Arguments:   - field: MISSION packet field
+// Returns:     Data for the RESPONSE packet.
+//------------------------------------------------------------------------------
+std::vector<uint8_t> SimulatedVehicle::handle_mission(avl::Field field)
+{
+
+    switch (field.get_descriptor())
+    {
+
+        case MISSION_START_DESC:
+            if (mission.empty())
+                return to_data("mission is empty");
+            mode = "AUTONOMOUS";
+            mission_running = true;
+            current_task = 0;
+            current_point = 0;
+            task_time = 0.0;
+            return to_data("mission started");
+
+        case MISSION_STOP_DESC:
+            stop_mission();
+            return to_data("mission stopped");
+
+        case MISSION_CLEAR_DESC:
+            stop_mission();
+            mission.clear();
+            return to_data("mission cleared");
+
+        case MISSION_ADVANCE_DESC:
+            if (!mission_running)
+                return to_data("mission is not running");
+            next_task();
+            return to_data("mission advanced");
+
+        case MISSION_SET_DESC:
+            stop_mission();
+            mission.clear();
+            append_task(avl::Packet(field.get_data()));
+            return to_data("mission set");
+
+        case MISSION_APPEND_DESC:
+        {
+            std::vector<avl::Packet> tasks = avl::Packet::parse_multiple(field.get_data());
+            for (const avl::Packet& task : tasks)
+                append_task(task);
+            return to_data("appended " + std::to_string(tasks.size()) + " tasks");
+        }
+
+        case MISSION_READ_CURRENT_DESC:
+            if (!mission_running)
+                return {};
+            return mission.at(current_task).packet.get_bytes();
+
+        case MISSION_READ_ALL_DESC:
+            return get_mission_bytes();
+
+        default:
+            return to_data("unknown mission command");
+
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        handle_helm
+// Description: Handles a HELM packet field.
+// Arguments:   - field: HELM packet field
+// Returns:     Data for the RESPONSE packet.
+//------------------------------------------------------------------------------
+std::vector<uint8_t> SimulatedVehicle::handle_helm(avl::Field field)
+{
+
+    if (mode != "MANUAL")
+        return to_data("helm commands require manual mode");
+
+    double value = avl::from_bytes<double>(field.get_data());
+    if (field.get_descriptor() == HELM_THROTTLE_DESC)
+        helm_throttle = value;
+    else if (field.get_descriptor() == HELM_RUDDER_DESC)
+        helm_rudder = value;
+
+    return to_data("helm set");
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        handle_parameter_list
+// Description: Handles a PARAMETER_LIST packet field.
+// Arguments:   - field: PARAMETER_LIST packet field
+// Returns:     Data for the RESPONSE packet.
+//------------------------------------------------------------------------------
+std::vector<uint8_t> SimulatedVehicle::handle_parameter_list(avl::Field field)
+{
+
+    if (field.get_descriptor() == PARAMETER_LIST_REQUEST_DESC)
+        return get_parameter_list_bytes();
+
+    if (field.get_descriptor() != PARAMETER_LIST_DESC)
+        return to_data("unknown parameter list command");
+
+    std::vector<avl::Packet> parameter_packets = avl::Packet::parse_multiple(field.get_data());
+    for (avl::Packet& parameter : parameter_packets)
+    {
+        if (!parameter.has_field(PARAMETER_NAME_DESC) ||
+            !parameter.has_field(PARAMETER_TYPE_DESC) ||
+            !parameter.has_field(PARAMETER_VALUE_DESC))
+            continue;
+        std::vector<uint8_t> name = parameter.get_field(PARAMETER_NAME_DESC).get_data();
+        std::vector<uint8_t> type = parameter.get_field(PARAMETER_TYPE_DESC).get_data();
+        set_param(std::string(name.begin(), name.end()),
+                  std::string(type.begin(), type.end()),
+                  parameter.get_field(PARAMETER_VALUE_DESC).get_data());
+    }
+
+    return to_data("set " + std::to_string(parameter_packets.size()) + " parameters");
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        append_task
+// Description: Appends a task to the mission from a TASK packet.
+// Arguments:   - task_packet: TASK packet
+//------------------------------------------------------------------------------
+void SimulatedVehicle::append_task(avl::Packet task_packet)
+{
+
+    SimulatedTask task;
+    task.packet = task_packet;
+    task.duration = std::nan("");
+    task.speed = std::nan("");
+    task.yaw = std::nan("");
+    task.depth = std::nan("");
+
+    if (task_packet.has_field(TASK_DURATION_DESC))
+        task.duration = avl::from_bytes<double>(task_packet.get_field(TASK_DURATION_DESC).get_data());
+
+    if (task_packet.has_field(TASK_VELOCITY_DESC))
+        task.speed = avl::from_bytes_at<double>(task_packet.get_field(TASK_VELOCITY_DESC).get_data_ref(), 0);
+
+    if (task_packet.has_field(TASK_ATTITUDE_DESC))
+        task.yaw = avl::from_bytes_at<double>(task_packet.get_field(TASK_ATTITUDE_DESC).get_data_ref(), 16);
+
+    if (task_packet.has_field(TASK_DEPTH_DESC))
+        task.depth = avl::from_bytes<double>(task_packet.get_field(TASK_DEPTH_DESC).get_data());
+
+    // Points are packed as latitude, longitude, yaw and action
+    if (task_packet.has_field(TASK_POINTS_DESC))
+    {
+        std::vector<double> points = avl::vector_from_bytes<double>(task_packet.get_field(TASK_POINTS_DESC).get_data());
+        for (size_t i = 0; i + 3 < points.size(); i += 4)
+        {
+            task.lats.push_back(points[i]);
+            task.lons.push_back(points[i+1]);
+        }
+    }
+
+    mission.push_back(task);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_mission_bytes
+// Description: Gets the mission as concatenated TASK packet bytes, with
+//              each task sent back as it was uploaded.
+// Returns:     Mission bytes.
+//------------------------------------------------------------------------------
+std::vector<uint8_t> SimulatedVehicle::get_mission_bytes()
+{
+
+    std::vector<uint8_t> bytes;
+    for (SimulatedTask& task : mission)
+        avl::append(bytes, task.packet.get_bytes());
+
+    return bytes;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_parameter_list_bytes
+// Description: Gets the bytes of a PARAMETER_LIST packet holding every
+//              simulated parameter.
+// Returns:     PARAMETER_LIST packet bytes.
+//------------------------------------------------------------------------------
+std::vector<uint8_t> SimulatedVehicle::get_parameter_list_bytes()
+{
+
+    std::vector<avl::Packet> parameter_packets;
+    for (const SimulatedParam& param : params)
+    {
+        avl::Packet parameter = PARAMETER_PACKET();
+        parameter.add_field(PARAMETER_NAME(param.name));
+        parameter.add_field(avl::Field(PARAMETER_VALUE_DESC, param.value));
+        parameter.add_field(PARAMETER_TYPE(param.type));
+        parameter_packets.push_back(parameter);
+    }
+
+    avl::Packet list = PARAMETER_LIST_PACKET();
+    list.add_field(PARAMETER_LIST(parameter_packets));
+    list.add_field(PARAMETER_LIST_SIZE(static_cast<int>(parameter_packets.size())));
+    return list.get_bytes();
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        set_param
+// Description: Sets a simulated parameter, adding it if it does not
+//              exist.
+// Arguments:   - name: parameter name
+//              - type: parameter type string
+//              - value: parameter value bytes
+//------------------------------------------------------------------------------
+void SimulatedVehicle::set_param(std::string name, std::string type, std::vector<uint8_t> value)
+{
+
+    for (SimulatedParam& param : params)
+    {
+        if (param.name == name)
+        {
+            param.type = type;
+            param.value = value;
+            return;
+        }
+    }
+
+    params.push_back({name, type, value});
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_double_param
+// Description: Gets a simulated double parameter.
+// Arguments:   - name: parameter name
+//              - default_value: value returned if the parameter does not
+//                exist or is not a double
+// Returns:     Parameter value.
+//------------------------------------------------------------------------------
+double SimulatedVehicle::get_double_param(std::string name, double default_value)
+{
+
+    for (const SimulatedParam& param : params)
+        if (param.name == name && param.type == "double" && param.value.size() == sizeof(double))
+            return avl::from_bytes<double>(param.value);
+
+    return default_value;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        fly_task
+// Description: Advances the current mission task by a time step, moving
+//              on to the next task when it is complete.
+// Arguments:   - dt: time step in seconds
+//------------------------------------------------------------------------------
+void SimulatedVehicle::fly_task(double dt)
+{
+
+    SimulatedTask& task = mission.at(current_task);
+    task_time += dt;
+
+    speed = std::isnan(task.speed) ? get_double_param("mission/default_speed", DEFAULT_SPEED) : task.speed;
+    speed = std::max(0.0, std::min(speed, MAX_SPEED));
+
+    // Depth changes at a fixed rate towards the task depth
+    if (!std::isnan(task.depth))
+        depth += std::max(-0.5 * dt, std::min(task.depth - depth, 0.5 * dt));
+
+    // Tasks without points hold their heading for their duration
+    if (task.lats.empty())
+    {
+        if (!std::isnan(task.yaw))
+            turn_towards(task.yaw, dt);
+        move(dt);
+        if (std::isnan(task.duration) || task_time >= task.duration)
+            next_task();
+        return;
+    }
+
+    // The acceptance radius is at least the turning diameter, so that the
+    // vehicle cannot circle a waypoint without reaching it
+    double turn_diameter = 2.0 * speed / (MAX_TURN_RATE * DEGREES_TO_RADIANS);
+    double acceptance_radius = std::max(turn_diameter,
+        get_double_param("mission/acceptance_radius", DEFAULT_ACCEPTANCE_RADIUS));
+
+    double target_lat = task.lats[current_point];
+    double target_lon = task.lons[current_point];
+    if (avl::geo::distance(lat, lon, target_lat, target_lon) < acceptance_radius)
+    {
+        current_point++;
+        if (current_point >= task.lats.size() ||
+            (!std::isnan(task.duration) && task_time >= task.duration))
+            next_task();
+        return;
+    }
+
+    turn_towards(avl::geo::bearing(lat, lon, target_lat, target_lon), dt);
+    move(dt);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        next_task
+// Description: Moves on to the next mission task, stopping the mission
+//              after the last one.
+//------------------------------------------------------------------------------
+void SimulatedVehicle::next_task()
+{
+
+    current_point = 0;
+    task_time = 0.0;
+    current_task++;
+
+    if (current_task >= mission.size())
+        stop_mission();
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        stop_mission
+// Description: Stops the mission and the vehicle.
+//------------------------------------------------------------------------------
+void SimulatedVehicle::stop_mission()
+{
+    mission_running = false;
+    current_task = 0;
+    current_point = 0;
+    task_time = 0.0;
+    speed = 0.0;
+}
+
+//------------------------------------------------------------------------------
+// Name:        turn_towards
+// Description: Turns the vehicle towards a heading by at most the
+//              maximum turn rate.
+// Arguments:   - target_yaw: heading to turn to in degrees
+//              - dt: time step in seconds
+//------------------------------------------------------------------------------
+void SimulatedVehicle::turn_towards(double target_yaw, double dt)
+{
+
+    // Heading error wrapped to [-180, 180) so that the vehicle turns the
+    // short way round
+    double error = std::fmod(target_yaw - yaw + 540.0, 360.0) - 180.0;
+    double max_turn = MAX_TURN_RATE * dt;
+    yaw += std::max(-max_turn, std::min(error, max_turn));
+    yaw = std::fmod(yaw + 360.0, 360.0);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        move
+// Description: Moves the vehicle along its heading at its speed.
+// Arguments:   - dt: time step in seconds
+//------------------------------------------------------------------------------
+void SimulatedVehicle::move(double dt)
+{
+    avl::geo::destination(lat, lon, yaw, speed * dt, lat, lon);
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_task_percent
+// Description: Gets the completion percentage of the current task.
+// Returns:     Task completion percentage.
+//------------------------------------------------------------------------------
+double SimulatedVehicle::get_task_percent()
+{
+
+    if (!mission_running)
+        return 0.0;
+
+    const SimulatedTask& task = mission.at(current_task);
+    if (!task.lats.empty())
+        return 100.0 * current_point / task.lats.size();
+    if (!std::isnan(task.duration) && task.duration > 0.0)
+        return std::min(100.0, 100.0 * task_time / task.duration);
+    return 0.0;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        make_response
+// Description: Builds a RESPONSE packet.
+// Arguments:   - packet_descriptor: descriptor of the command packet
+//              - field_descriptor: descriptor of the command field
+//              - data: response data
+// Returns:     RESPONSE packet.
+//------------------------------------------------------------------------------
+avl::Packet SimulatedVehicle::make_response(uint8_t packet_descriptor,
+                                            uint8_t field_descriptor,
+                                            std::vector<uint8_t> data)
+{
+    avl::Packet response = RESPONSE_PACKET();
+    response.add_field(RESPONSE_PACKET_DESCRIPTOR(packet_descriptor));
+    response.add_field(RESPONSE_FIELD_DESCRIPTOR(field_descriptor));
+    response.add_field(RESPONSE_DATA(data));
+    response.add_field(VEHICLE_ID(id));
+    return response;
+}
+
+//------------------------------------------------------------------------------
+// Name:        to_data
+// Description: Converts a response message to response data bytes.
+// Arguments:   - message: response message
+// Returns:     Message bytes.
+//------------------------------------------------------------------------------
+std::vector<uint8_t> SimulatedVehicle::to_data(std::string message)
+{
+    return std::vector<uint8_t>(message.begin(), message.end());
+}
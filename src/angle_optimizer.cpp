@@ -0,0 +1,204 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Searches for the survey pass heading that covers a zone in
+//              the least time, planning the candidate headings in parallel
+//              in the background.
+//==============================================================================
+
+#include "angle_optimizer.h"
+
+// Survey path planning
+#include "survey_generator.h"
+
+// Path lengths
+#include "util/geo.h"
+
+// Parallel candidate planning
+#include <QtConcurrent>
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+constexpr double AngleOptimizer::ANGLE_STEP;
+constexpr double AngleOptimizer::DEFAULT_SPEED;
+constexpr double AngleOptimizer::DEFAULT_TURN_TIME;
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        AngleOptimizer constructor
+// Description: Constructs an optimizer for passes at a spacing.
+// Arguments:   - swath: spacing between passes in meters
+//              - speed: survey speed in meters per second
+//              - turn_time: time in seconds to turn onto a pass
+//------------------------------------------------------------------------------
+AngleOptimizer::AngleOptimizer(double swath, double speed, double turn_time) :
+    swath(swath), speed(speed), turn_time(turn_time)
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        AngleOptimizer destructor
+// Description: Default destructor.
+//------------------------------------------------------------------------------
+AngleOptimizer::~AngleOptimizer()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        evaluate
+// Description: Starts planning and scoring every candidate heading in
+//              parallel on the global thread pool. The outline and the
+//              optimizer settings are copied, so neither has to outlive
+//              the search.
+// Arguments:   - outline: zone outline with longitude as x and latitude
+//                as y
+// Returns:     Future holding the score of each candidate heading, in
+//              order of heading. It has no results if the zone cannot be
+//              surveyed.
+//------------------------------------------------------------------------------
+QFuture<AngleOptimizer::Candidate> AngleOptimizer::evaluate(
+    const std::vector<QPointF>& outline) const
+{
+
+    // A zone that cannot be surveyed maps no headings, so its future
+    // finishes straight away
+    QVector<double> angles;
+    if (outline.size() >= 3 && swath > 0.0 && speed > 0.0)
+        for (double angle = 0.0; angle < 180.0; angle += ANGLE_STEP)
+            angles.append(angle);
+
+    // Each candidate plans its own path from a shared read only copy of the
+    // outline
+    AngleOptimizer optimizer = *this;
+    std::function<Candidate(const double&)> score_angle = [optimizer, outline](const double& angle)
+    {
+        return optimizer.score(outline, angle);
+    };
+    return QtConcurrent::mapped(angles, score_angle);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_candidates
+// Description: Gets the candidate headings from a finished search that
+//              could be surveyed.
+// Arguments:   - future: finished future returned by evaluate
+// Returns:     Scored candidate headings, in order of heading.
+//------------------------------------------------------------------------------
+std::vector<AngleOptimizer::Candidate> AngleOptimizer::get_candidates(
+    const QFuture<Candidate>& future)
+{
+
+    QList<Candidate> scores = future.results();
+
+    std::vector<Candidate> candidates;
+    candidates.reserve(static_cast<size_t>(scores.size()));
+    for (const Candidate& candidate : scores)
+        if (std::isfinite(candidate.time))
+            candidates.push_back(candidate);
+
+    return candidates;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_best
+// Description: Finds the candidate heading with the least survey time.
+// Arguments:   - candidates: scored candidate headings
+// Returns:     Fastest candidate. Its time is NaN if there are no
+//              candidates.
+//------------------------------------------------------------------------------
+AngleOptimizer::Candidate AngleOptimizer::get_best(const std::vector<Candidate>& candidates)
+{
+
+    Candidate best{0.0, 0.0, 0, std::nan("")};
+    for (const Candidate& candidate : candidates)
+        if (std::isnan(best.time) || candidate.time < best.time)
+            best = candidate;
+    return best;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_pareto_set
+// Description: Finds the candidate headings that no other candidate beats
+//              on both path length and number of turns. Candidates with
+//              equal scores are kept once.
+// Arguments:   - candidates: scored candidate headings
+// Returns:     Pareto optimal candidates in order of survey time.
+//------------------------------------------------------------------------------
+std::vector<AngleOptimizer::Candidate> AngleOptimizer::get_pareto_set(
+    const std::vector<Candidate>& candidates)
+{
+
+    // In order of turns and then length, a candidate is only optimal if it
+    // is shorter than every candidate with fewer or as many turns before it
+    std::vector<Candidate> sorted = candidates;
+    std::sort(sorted.begin(), sorted.end(), [](const Candidate& a, const Candidate& b)
+    {
+        return a.turns < b.turns || (a.turns == b.turns && a.length < b.length);
+    });
+
+    std::vector<Candidate> pareto_set;
+    double shortest = std::numeric_limits<double>::infinity();
+    for (const Candidate& candidate : sorted)
+    {
+        if (candidate.length < shortest)
+        {
+            pareto_set.push_back(candidate);
+            shortest = candidate.length;
+        }
+    }
+
+    std::sort(pareto_set.begin(), pareto_set.end(), [](const Candidate& a, const Candidate& b)
+    {
+        return a.time < b.time;
+    });
+
+    return pareto_set;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        score
+// Description: Plans and scores one candidate heading.
+// Arguments:   - outline: zone outline with longitude as x and latitude
+//                as y
+//              - angle: candidate heading in degrees
+// Returns:     Score of the candidate heading.
+//------------------------------------------------------------------------------
+AngleOptimizer::Candidate AngleOptimizer::score(const std::vector<QPointF>& outline,
+                                                double angle) const
+{
+
+    Candidate candidate{angle, 0.0, 0, std::numeric_limits<double>::infinity()};
+    std::vector<QPointF> path = SurveyGenerator::generate(outline, angle, swath);
+    if (path.size() < 2)
+        return candidate;
+
+    std::vector<double> lat(path.size());
+    std::vector<double> lon(path.size());
+    for (size_t i = 0; i < path.size(); i++)
+    {
+        lat[i] = path[i].y();
+        lon[i] = path[i].x();
+    }
+    candidate.length = avl::geo::path_length(lat.data(), lon.data(), path.size());
+
+    // The path is the two ends of each pass segment, and the vehicle turns
+    // between segments
+    candidate.turns = static_cast<int>(path.size() / 2) - 1;
+    candidate.time = candidate.length / speed + candidate.turns * turn_time;
+
+    return candidate;
+
+}
@@ -7,6 +7,14 @@
 
 #include "avl_map_display.h"
 
+// Viewpoint size conversion
+#include "util/geo.h"
+
+// C++ includes
+#include <cmath>
+
+constexpr double AvlMapDisplay::PICK_TOLERANCE_PIXELS;
+
 //==============================================================================
 //                              CLASS DEFINITION
 //==============================================================================
@@ -83,8 +91,10 @@ void AvlMapDisplay::componentComplete()
             this, &AvlMapDisplay::mouse_moved);
     connect(map_view, &MapQuickView::mouseReleased,
             this, &AvlMapDisplay::mouse_released);
-    connect(map_view, &MapQuickView::identifyGraphicsOverlaysCompleted,
-            this, &AvlMapDisplay::identify_graphics_overlays_completed);
+
+    // Vehicle paths follow the map scale
+    connect(map_view, &MapQuickView::viewpointChanged,
+            this, &AvlMapDisplay::viewpoint_changed);
 
 }
 
@@ -124,6 +134,8 @@ void AvlMapDisplay::add_vehicle_graphics(Vehicle *vehicle)
 {
     map_view->graphicsOverlays()->append(vehicle->get_mission_overlay().get());
     map_view->graphicsOverlays()->append(vehicle->get_path_overlay().get());
+    path_vehicles.append(vehicle);
+    vehicle->set_path_resolution(get_meters_per_pixel());
 }
 
 //------------------------------------------------------------------------------
@@ -179,7 +191,7 @@ void AvlMapDisplay::set_viewpoint_to_location(const double lat, const double lon
 {
 
     // Calculate the side length in degrees
-    double degrees = side_length / 6371000.0 * 180.0 / 3.141592;
+    double degrees = side_length / avl::geo::EARTH_RADIUS * avl::geo::RADIANS_TO_DEGREES;
 
     // Calculate the lower left and the upper right corner positions of the area
     double x_min = lon - degrees / 2.0;
@@ -245,22 +257,10 @@ void AvlMapDisplay::enc_loaded(Esri::ArcGISRuntime::Error error)
 void AvlMapDisplay::mouse_pressed_and_held(QMouseEvent& mouse_event)
 {
 
+    // The graphic is picked from the vehicles' graphic indices rather than
+    // by an asynchronous map view identify, so the drag can start at once
     if (mouse_event.button () == Qt::LeftButton)
-    {
-        qDebug()<<"The hold slot called";
-        //        constexpr double tolerance = 5.0;
-//        constexpr bool returnPopupsOnly = false;
-//        constexpr int maximumResults = 1;
-//        const double screenX = mouse_event.x();
-//        const double screenY = mouse_event.y();
-//        map_view->identifyGraphicsOverlay(survey_zone_point_overlay, screenX, screenY, tolerance, returnPopupsOnly, maximumResults);
-        constexpr double tolerance = 5.0;
-        constexpr bool returnPopupsOnly = false;
-        constexpr int maximumResults = 1;
-
-        //m_mapView->identifyGraphicsOverlay(graphicsOverlay, mouseEvent.x(), mouseEvent.y(), tolerance, returnPopupsOnly, maximumResults);
-        map_view->identifyGraphicsOverlays(mouse_event.x(), mouse_event.y(), 0, false, 10);
-    }
+        pick_graphic(mouse_event.x(), mouse_event.y());
 
 }
 
@@ -271,16 +271,13 @@ void AvlMapDisplay::mouse_pressed_and_held(QMouseEvent& mouse_event)
 //------------------------------------------------------------------------------
 void AvlMapDisplay::mouse_moved(QMouseEvent& mouse_event)
 {
-    if (dragging)
+    if (dragging && !dragged_vehicle.isNull())
     {
 
-
+        // Mouse events arrive much faster than the display is redrawn, so
+        // the vehicle only previews the latest location on the next frame
         QPointF new_location = get_map_position(mouse_event.x(), mouse_event.y());
-        emit waypointMoved(dragged_vehicle_index, dragged_waypoint_index, new_location);
-
-//        qDebug() << "dragged vehicle" << dragged_vehicle_index
-//                 << "waypoint" << dragged_waypoint_index
-//                 << "to" << new_lat << new_lon;
+        dragged_vehicle->drag_waypoint(new_location);
 
     }
 }
@@ -295,8 +292,17 @@ void AvlMapDisplay::mouse_released(QMouseEvent& mouse_event)
     Q_UNUSED(mouse_event);
     if (dragging)
     {
+
         dragged_graphic->setSelected(false);
         dragging = false;
+
+        // The mission is only changed once, with the final location
+        if (!dragged_vehicle.isNull())
+        {
+            dragged_vehicle->end_waypoint_drag();
+            dragged_vehicle.clear();
+        }
+
     }
 }
 
@@ -310,69 +316,6 @@ void AvlMapDisplay::mouse_pressed(QMouseEvent& mouse_event)
 //    map_view->identifyGraphicsOverlays(mouse_event.x(), mouse_event.y(), 0, false, 10);
 }
 
-//------------------------------------------------------------------------------
-// Name:        identify_graphics_overlays_completed
-// Description: Called when the identify graphics overlay function finishes.
-// Arguments:   - task_id: task ID of overlay identification
-//              - identify_results: result of the overlay identification
-//------------------------------------------------------------------------------
-void AvlMapDisplay::identify_graphics_overlays_completed(QUuid task_id,
-    const QList<IdentifyGraphicsOverlayResult*> &identify_results)
-{
-
-    // Only handle the results if there are any identified overlays
-    if (identify_results.size() > 0)
-    {
-
-        // Only handle the results if the identified overlay has graphics
-        if (identify_results[0]->graphics().size() > 0)
-        {
-
-            // Find the index of the overlay and the graphic in their lists
-            int overlay_index = map_view->graphicsOverlays()->indexOf(identify_results[0]->graphicsOverlay());
-            int graphic_index = map_view->graphicsOverlays()->at(overlay_index)->graphics()->indexOf(identify_results[0]->graphics().at(0));
-
-            // Overlays are organized as <mission><vehicle><mission><vehicle>.
-            // Therefore if the overlay index is even, the overlay is a mission overlay
-            if (overlay_index % 2 == 0)
-            {
-
-                // Get the vehicle index from the overlay index. Since each vehicle
-                // has two overlays and the mission overlay is the first one for
-                // each vehicle, the vehicle index is calculated as follows
-                dragged_vehicle_index = (overlay_index + 1) / 2;
-
-                // Graphics in a mission overlay are arranged as
-                //    <wp><wp><path><wp><path><wp><path>....
-                // Note that there is no path between the first two. Therefore,
-                // the graphic is a waypoint if it is an odd index or is zero
-                if (graphic_index == 0 || graphic_index % 2 != 0)
-                {
-
-                    // Get the waypoint index from the graphic index following
-                    // logic similar to the vehicle index. This also handles
-                    // the 0 index case since 1 / 2 = 0 for integers
-                    dragged_waypoint_index = (graphic_index + 1) / 2;
-                    qDebug() << "selected vehicle" << dragged_vehicle_index
-                             << "waypoint" << dragged_waypoint_index;
-
-                    // Select the graphic to draw a selection indicator around it
-                    dragged_graphic = identify_results[0]->graphics().at(0);
-                    dragged_graphic->setSelected(true);
-                    qDebug() << dragged_graphic->property("test");
-                    qDebug() << dragged_graphic;
-                    dragging = true;
-
-                }
-
-            }
-
-        }
-
-    }
-
-}
-
 //--------------------------------------------------------------------------
 // Name:        draw_geofence_graphics
 // Description: draws geofence graphics on the map
@@ -536,4 +479,97 @@ void AvlMapDisplay::load_offline_maps_tpk(QUrl paths)
     map_view->setMap(m_map);
 }
 
+//------------------------------------------------------------------------------
+// Name:        viewpoint_changed
+// Description: Slot called when the map is panned or zoomed. Selects the
+//              level of detail of each vehicle path from the map scale.
+//------------------------------------------------------------------------------
+void AvlMapDisplay::viewpoint_changed()
+{
+    double meters_per_pixel = get_meters_per_pixel();
+    for (QPointer<Vehicle>& vehicle : path_vehicles)
+        if (!vehicle.isNull())
+            vehicle->set_path_resolution(meters_per_pixel);
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_meters_per_pixel
+// Description: Gets the ground distance covered by one pixel at the
+//              current map scale.
+// Returns:     Ground distance in meters.
+//------------------------------------------------------------------------------
+double AvlMapDisplay::get_meters_per_pixel()
+{
+
+    // Map scales assume 96 device independent pixels per inch
+    const double METERS_PER_INCH = 0.0254;
+    const double PIXELS_PER_INCH = 96.0;
+
+    if (map_view == nullptr)
+        return 0.0;
+
+    double map_scale = map_view->mapScale();
+    if (std::isnan(map_scale) || map_scale <= 0.0)
+        return 0.0;
+
+    return map_scale * METERS_PER_INCH / PIXELS_PER_INCH;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        pick_graphic
+// Description: Finds the waypoint or vehicle icon graphic nearest to a
+//              screen position in every vehicle's graphic index, and
+//              starts dragging it if it is a waypoint.
+// Arguments:   - mouse_x: screen x position in pixels
+//              - mouse_y: screen y position in pixels
+//------------------------------------------------------------------------------
+void AvlMapDisplay::pick_graphic(double mouse_x, double mouse_y)
+{
 
+    QPointF location = get_map_position(mouse_x, mouse_y);
+    double radius = PICK_TOLERANCE_PIXELS * get_meters_per_pixel();
+
+    // Find the nearest graphic over all vehicles
+    Graphic* graphic = nullptr;
+    int vehicle_index = -1;
+    for (int i = 0; i < path_vehicles.size(); i++)
+    {
+        if (path_vehicles[i].isNull())
+            continue;
+        double distance;
+        Graphic* vehicle_graphic = path_vehicles[i]->find_graphic(location, radius, &distance);
+        if (vehicle_graphic != nullptr)
+        {
+            graphic = vehicle_graphic;
+            vehicle_index = i;
+            radius = distance;
+        }
+    }
+
+    if (graphic == nullptr)
+        return;
+
+    // Waypoint graphics are the only ones with a point index attribute. A
+    // picked vehicle icon is not dragged
+    QVariant task_index = graphic->attributes()->attributeValue(
+        MissionGraphics::TASK_INDEX_ATTRIBUTE);
+    QVariant point_index = graphic->attributes()->attributeValue(
+        MissionGraphics::POINT_INDEX_ATTRIBUTE);
+    if (!point_index.isValid() || !task_index.isValid())
+        return;
+
+    Vehicle* vehicle = path_vehicles[vehicle_index];
+    if (vehicle->begin_waypoint_drag(task_index.toInt(), point_index.toInt()))
+    {
+
+        dragged_vehicle = vehicle;
+
+        // Select the graphic to draw a selection indicator around it
+        dragged_graphic = graphic;
+        dragged_graphic->setSelected(true);
+        dragging = true;
+
+    }
+
+}
@@ -0,0 +1,128 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Estimates the offset between a vehicle's clock and the local
+//              clock from ping round trips, in the same way as NTP.
+//==============================================================================
+
+#include "clock_sync.h"
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        ClockSync constructor
+// Description: Default constructor.
+//------------------------------------------------------------------------------
+ClockSync::ClockSync()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        ClockSync destructor
+// Description: Default destructor.
+//------------------------------------------------------------------------------
+ClockSync::~ClockSync()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        add_sample
+// Description: Adds a ping round trip sample. Samples with a negative
+//              delay are inconsistent and are ignored.
+// Arguments:   - t0: ping sent time in local seconds since epoch
+//              - t1: ping received time in vehicle seconds since epoch
+//              - t2: response sent time in vehicle seconds since epoch
+//              - t3: response received time in local seconds since epoch
+// Returns:     True if the sample was used, false if it was ignored.
+//------------------------------------------------------------------------------
+bool ClockSync::add_sample(double t0, double t1, double t2, double t3)
+{
+
+    Sample sample;
+    sample.offset = ((t1 - t0) + (t2 - t3)) / 2.0;
+    sample.delay = (t3 - t0) - (t2 - t1);
+
+    if (!std::isfinite(sample.offset) || !(sample.delay >= 0.0))
+        return false;
+
+    samples.push_back(sample);
+    if (samples.size() > WINDOW_SIZE)
+        samples.pop_front();
+
+    // Take the offset from the sample with the smallest delay, which is the
+    // one least affected by asymmetric queuing on the link
+    size_t best = 0;
+    for (size_t i = 1; i < samples.size(); i++)
+        if (samples[i].delay < samples[best].delay)
+            best = i;
+
+    offset = samples[best].offset;
+    delay = samples[best].delay;
+
+    return true;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        has_offset
+// Description: Checks whether any round trip samples have been added.
+// Returns:     True if an offset estimate is available.
+//------------------------------------------------------------------------------
+bool ClockSync::has_offset() const
+{
+    return !samples.empty();
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_offset
+// Description: Gets the estimated offset of the vehicle clock from the
+//              local clock. A vehicle time minus the offset is the
+//              equivalent local time.
+// Returns:     Clock offset in seconds, or NaN if no samples were added.
+//------------------------------------------------------------------------------
+double ClockSync::get_offset() const
+{
+    return offset;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_delay
+// Description: Gets the round trip delay of the sample the offset was
+//              taken from. Half of it bounds the offset error.
+// Returns:     Round trip delay in seconds, or NaN if no samples were
+//              added.
+//------------------------------------------------------------------------------
+double ClockSync::get_delay() const
+{
+    return delay;
+}
+
+//------------------------------------------------------------------------------
+// Name:        to_local_time
+// Description: Converts a vehicle timestamp to local time using the
+//              current offset estimate. The timestamp is returned as is
+//              if there is no estimate yet.
+// Arguments:   - vehicle_time: vehicle time in seconds since epoch
+// Returns:     Local time in seconds since epoch.
+//------------------------------------------------------------------------------
+double ClockSync::to_local_time(double vehicle_time) const
+{
+    if (!has_offset())
+        return vehicle_time;
+    return vehicle_time - offset;
+}
+
+//------------------------------------------------------------------------------
+// Name:        reset
+// Description: Removes all round trip samples.
+//------------------------------------------------------------------------------
+void ClockSync::reset()
+{
+    samples.clear();
+    offset = std::nan("");
+    delay = std::nan("");
+}
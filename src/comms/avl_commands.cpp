@@ -349,19 +349,30 @@ Field STATUS_IRIDIUM_STRENGTH(uint8_t strength)
     return Field(STATUS_IRIDIUM_STRENGTH_DESC, {strength});
 }
 
+//------------------------------------------------------------------------------
+// Name:        STATUS_TIMESTAMP
+// Description: Creates a STATUS packet TIMESTAMP field.
+// Arguments:   - t: time the status was sampled in seconds since epoch
+// Returns:     STATUS packet TIMESTAMP field.
+//------------------------------------------------------------------------------
+Field STATUS_TIMESTAMP(double t)
+{
+    return Field(STATUS_TIMESTAMP_DESC, avl::to_bytes(t));
+}
+
 //------------------------------------------------------------------------------
 // Name:        STATUS_TASK
 // Description: Creates a STATUS packet TASK field.
 // Arguments:   - task_num: task number current being executed
 //              - num_tasks: total number of tasks to execute
 //              - percent: task completion percentage
-// Returns:     STATUS packet TASK_PERCENT field.
+// Returns:     STATUS packet TASK field.
 //------------------------------------------------------------------------------
 Field STATUS_TASK(uint8_t task_num, uint8_t num_tasks, double percent)
 {
     std::vector<uint8_t> payload = {task_num, num_tasks};
     avl::append(payload, avl::to_bytes(percent));
-    return Field(STATUS_IRIDIUM_STRENGTH_DESC, payload);
+    return Field(STATUS_TASK_DESC, payload);
 }
 
 //------------------------------------------------------------------------------
@@ -374,6 +385,21 @@ Field ACTION_PING()
     return Field(ACTION_PING_DESC);
 }
 
+//------------------------------------------------------------------------------
+// Name:        ACTION_PING
+// Description: Creates an ACTION packet PING field carrying the time the
+//              ping was sent. A vehicle that supports clock synchronization
+//              responds with RESPONSE_DATA containing this originate time,
+//              the time it received the ping, and the time it sent the
+//              response, each as a double in seconds since epoch.
+// Arguments:   - t: ping originate time in seconds since epoch
+// Returns:     ACTION packet PING field.
+//------------------------------------------------------------------------------
+Field ACTION_PING(double t)
+{
+    return Field(ACTION_PING_DESC, avl::to_bytes(t));
+}
+
 //------------------------------------------------------------------------------
 // Name:        ACTION_EMERGENCY_STOP
 // Description: Creates an ACTION packet EMERGENCY_STOP field.
@@ -893,7 +919,7 @@ Field PARAMETER_TYPE(std::string type)
 Field PARAMETER_LIST(std::vector<Packet> parameters)
 {
     std::vector<uint8_t> payload;
-    for(size_t i = 0; i < 1; i++)
+    for(size_t i = 0; i < parameters.size(); i++)
         avl::append(payload, parameters.at(i).get_bytes());
     return Field(PARAMETER_LIST_DESC, payload);
 }
@@ -159,7 +159,7 @@ uint16_t Field::get_length()
 // Description: Gets the field descriptor.
 // Returns:     field descriptor byte.
 //------------------------------------------------------------------------------
-uint8_t Field::get_descriptor()
+uint8_t Field::get_descriptor() const
 {
     return descriptor;
 }
@@ -184,6 +184,18 @@ std::vector<uint8_t> Field::get_data()
     return data;
 }
 
+//------------------------------------------------------------------------------
+// Name:        get_data_ref
+// Description: Gets a read-only reference to the field data without
+//              copying it. The reference is only valid for the lifetime
+//              of the field.
+// Returns:     Reference to the field data bytes.
+//------------------------------------------------------------------------------
+const std::vector<uint8_t>& Field::get_data_ref() const
+{
+    return data;
+}
+
 //------------------------------------------------------------------------------
 // Name:        set_data
 // Description: Sets the field data. Also updates the field length.
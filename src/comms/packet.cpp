@@ -283,6 +283,18 @@ Field Packet::get_field(uint8_t field_descriptor)
 
 }
 
+//------------------------------------------------------------------------------
+// Name:        get_fields
+// Description: Gets a read-only reference to all of the packet's fields
+//              in order, for decoders that visit every field once
+//              instead of looking fields up by descriptor.
+// Returns:     Reference to the packet's vector of fields.
+//------------------------------------------------------------------------------
+const std::vector<Field>& Packet::get_fields() const
+{
+    return fields;
+}
+
 //------------------------------------------------------------------------------
 // Name:        add_field
 // Description: Adds a field with the given parameters to the packet.
@@ -377,7 +389,8 @@ std::vector<uint8_t> Packet::get_checksum(std::vector<uint8_t> bytes)
 // Description: Checks whether a vector of bytes is a properly formatted
 //              packet, including a header and correct checksum bytes.
 //              Throws a std::runtime_error if the bytes are not a properly
-//              formatted packet.
+//              formatted packet, or an avl::ChecksumError if only the
+//              checksum does not match.
 // Arguments:   - bytes: vector of bytes to validate
 //------------------------------------------------------------------------------
 void Packet::validate_bytes(std::vector<uint8_t> bytes)
@@ -406,7 +419,7 @@ void Packet::validate_bytes(std::vector<uint8_t> bytes)
     // Check that the given checksum matches the calculated checksum
     if (calculated_checksum != given_checksum)
     {
-        throw std::runtime_error("validate_bytes: invalid packet (checksum does not match)");
+        throw ChecksumError("validate_bytes: invalid packet (checksum does not match)");
     }
 
 }
@@ -0,0 +1,494 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Plans a lawnmower survey path that covers a polygonal zone
+//              in a local east-north plane, clipping each pass against the
+//              zone and covering the zone cell by cell, and splits a zone
+//              between vehicles in bands of whole passes.
+//==============================================================================
+
+#include "coverage_planner.h"
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        CoveragePlanner constructor
+// Description: Constructs a planner for passes at a heading and spacing.
+// Arguments:   - angle: compass heading of the passes in degrees
+//              - swath: spacing between passes in meters
+//------------------------------------------------------------------------------
+CoveragePlanner::CoveragePlanner(double angle, double swath) :
+    angle(angle), swath(swath)
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        CoveragePlanner destructor
+// Description: Default destructor.
+//------------------------------------------------------------------------------
+CoveragePlanner::~CoveragePlanner()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        plan
+// Description: Plans a survey path covering a zone. The first pass is
+//              half a swath inside the zone, and a zone narrower than
+//              one swath gets a single pass through its middle.
+// Arguments:   - outline: zone outline vertices, in order
+//              - holes: vertices of each area inside the outline that is
+//                not surveyed
+// Returns:     Ordered path waypoints, the two ends of each pass segment
+//              in the order they are driven. Empty if the outline has
+//              fewer than three vertices, the swath is not positive or the
+//              angle is not finite.
+//------------------------------------------------------------------------------
+std::vector<CoveragePlanner::Location> CoveragePlanner::plan(
+    const std::vector<Location>& outline,
+    const std::vector<std::vector<Location>>& holes) const
+{
+
+    std::vector<Location> path;
+    if (outline.size() < 3 || !(swath > 0.0) || !std::isfinite(angle))
+        return path;
+
+    Frame frame = get_frame(outline);
+    std::vector<std::vector<PlanePoint>> rings;
+    rings.reserve(holes.size() + 1);
+    rings.emplace_back();
+    for (const Location& location : outline)
+        rings.back().push_back(frame.to_plane(location));
+    for (const std::vector<Location>& hole : holes)
+    {
+        if (hole.size() < 3)
+            continue;
+        rings.emplace_back();
+        for (const Location& location : hole)
+            rings.back().push_back(frame.to_plane(location));
+    }
+
+    std::vector<PlanePoint> plane_path = order_cells(build_cells(clip_passes(rings)));
+
+    // Return to latitude and longitude
+    path.reserve(plane_path.size());
+    for (const PlanePoint& point : plane_path)
+        path.push_back(frame.to_location(point));
+
+    return path;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        partition
+// Description: Splits a zone into bands across the passes that take
+//              equal time to survey at the same speed. Each pass is
+//              costed by its length plus one swath for the turn to each
+//              of its segments, and bands are bounded halfway between
+//              passes.
+// Arguments:   - outline: zone outline vertices, in order
+//              - num_parts: number of bands to split the zone into
+// Returns:     Outline vertices of each band, in order across the passes.
+//              Fewer bands are returned if the zone has fewer passes than
+//              bands, and none under the same conditions as plan.
+//------------------------------------------------------------------------------
+std::vector<std::vector<CoveragePlanner::Location>> CoveragePlanner::partition(
+    const std::vector<Location>& outline, int num_parts) const
+{
+
+    std::vector<std::vector<Location>> parts;
+    if (outline.size() < 3 || !(swath > 0.0) || !std::isfinite(angle) || num_parts < 1)
+        return parts;
+
+    Frame frame = get_frame(outline);
+    std::vector<std::vector<PlanePoint>> rings(1);
+    for (const Location& location : outline)
+        rings[0].push_back(frame.to_plane(location));
+    std::vector<std::vector<Segment>> passes = clip_passes(rings);
+
+    size_t num_bands = std::min(static_cast<size_t>(num_parts), passes.size());
+    if (num_bands < 2)
+    {
+        parts.push_back(outline);
+        return parts;
+    }
+
+    // Cumulative survey cost up to the end of each pass
+    std::vector<double> costs(passes.size());
+    double cost = 0.0;
+    for (size_t i = 0; i < passes.size(); i++)
+    {
+        for (const Segment& segment : passes[i])
+            cost += segment.u1 - segment.u0 + swath;
+        costs[i] = cost;
+    }
+
+    // Band j ends after the pass whose cumulative cost is nearest to j
+    // shares of the total, leaving at least one pass for every band
+    std::vector<size_t> band_ends;
+    size_t previous_end = 0;
+    for (size_t j = 1; j < num_bands; j++)
+    {
+        double target = cost * j / num_bands;
+        size_t end = std::lower_bound(costs.begin(), costs.end(), target) - costs.begin();
+        if (end > 0 && target - costs[end-1] < costs[end] - target)
+            end--;
+        end = std::max(end + 1, previous_end + 1);
+        end = std::min(end, passes.size() - (num_bands - j));
+        band_ends.push_back(end);
+        previous_end = end;
+    }
+
+    // Bands are bounded halfway between the last pass of one band and the
+    // first pass of the next
+    double min_v = rings[0][0].v;
+    for (const PlanePoint& point : rings[0])
+        min_v = std::min(min_v, point.v);
+    double v0 = -std::numeric_limits<double>::infinity();
+    for (size_t j = 0; j < num_bands; j++)
+    {
+        double v1 = j + 1 < num_bands ? min_v + band_ends[j] * swath :
+                                        std::numeric_limits<double>::infinity();
+        std::vector<PlanePoint> band = clip_band(rings[0], v0, v1);
+        if (band.size() > 2)
+        {
+            parts.emplace_back();
+            parts.back().reserve(band.size());
+            for (const PlanePoint& point : band)
+                parts.back().push_back(frame.to_location(point));
+        }
+        v0 = v1;
+    }
+
+    return parts;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_frame
+// Description: Gets the planning plane of a zone.
+// Arguments:   - outline: zone outline vertices
+// Returns:     Planning plane tangent at the center of the outline's
+//              bounding box.
+//------------------------------------------------------------------------------
+CoveragePlanner::Frame CoveragePlanner::get_frame(const std::vector<Location>& outline) const
+{
+
+    // The plane is tangent at the center of the outline's bounding box, which
+    // keeps the flat earth error small across the zone
+    double min_lat = outline[0].lat, max_lat = outline[0].lat;
+    double min_lon = outline[0].lon, max_lon = outline[0].lon;
+    for (const Location& location : outline)
+    {
+        min_lat = std::min(min_lat, location.lat);
+        max_lat = std::max(max_lat, location.lat);
+        min_lon = std::min(min_lon, location.lon);
+        max_lon = std::max(max_lon, location.lon);
+    }
+
+    // Passes run along the compass heading, so u is measured along the
+    // heading and v to its left
+    double heading = angle * avl::geo::DEGREES_TO_RADIANS;
+    return Frame{avl::geo::EnuFrame((min_lat + max_lat) / 2.0, (min_lon + max_lon) / 2.0),
+                 std::sin(heading), std::cos(heading)};
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        Frame::to_plane
+// Description: Converts a location to the planning plane.
+// Arguments:   - location: location in degrees
+// Returns:     Point in the planning plane.
+//------------------------------------------------------------------------------
+CoveragePlanner::PlanePoint CoveragePlanner::Frame::to_plane(const Location& location) const
+{
+    double east, north;
+    enu.to_enu(location.lat, location.lon, east, north);
+    return PlanePoint{east * along_east + north * along_north,
+                      -east * along_north + north * along_east};
+}
+
+//------------------------------------------------------------------------------
+// Name:        Frame::to_location
+// Description: Converts a point in the planning plane to a location.
+// Arguments:   - point: point in the planning plane
+// Returns:     Location in degrees.
+//------------------------------------------------------------------------------
+CoveragePlanner::Location CoveragePlanner::Frame::to_location(const PlanePoint& point) const
+{
+    double east = point.u * along_east - point.v * along_north;
+    double north = point.u * along_north + point.v * along_east;
+    Location location;
+    enu.to_wgs84(east, north, location.lat, location.lon);
+    return location;
+}
+
+//------------------------------------------------------------------------------
+// Name:        clip_passes
+// Description: Finds the segments of every pass across a zone. Pass i
+//              is at i and a half swaths above the lowest v of the
+//              outline, unless the zone is narrower than one swath.
+// Arguments:   - rings: zone outline and holes in the planning plane
+// Returns:     Segments of each pass, in order of increasing v.
+//------------------------------------------------------------------------------
+std::vector<std::vector<CoveragePlanner::Segment>> CoveragePlanner::clip_passes(
+    const std::vector<std::vector<PlanePoint>>& rings) const
+{
+
+    double min_v = std::numeric_limits<double>::infinity();
+    double max_v = -std::numeric_limits<double>::infinity();
+    for (const PlanePoint& point : rings[0])
+    {
+        min_v = std::min(min_v, point.v);
+        max_v = std::max(max_v, point.v);
+    }
+
+    std::vector<std::vector<Segment>> passes;
+    if (max_v - min_v <= swath)
+    {
+        passes.push_back(clip_pass(rings, (min_v + max_v) / 2.0));
+    }
+    else
+    {
+        size_t num_passes = static_cast<size_t>(std::ceil((max_v - min_v) / swath - 0.5));
+        passes.reserve(num_passes);
+        for (size_t i = 0; i < num_passes; i++)
+            passes.push_back(clip_pass(rings, min_v + (i + 0.5) * swath));
+    }
+
+    return passes;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        clip_band
+// Description: Clips a ring to the band between two values of v.
+// Arguments:   - ring: ring in the planning plane
+//              - v0: lower bound of the band
+//              - v1: upper bound of the band
+// Returns:     Vertices of the part of the ring inside the band. Parts of
+//              a concave ring are joined along the band's bounds.
+//------------------------------------------------------------------------------
+std::vector<CoveragePlanner::PlanePoint> CoveragePlanner::clip_band(
+    const std::vector<PlanePoint>& ring, double v0, double v1)
+{
+
+    // Clips against one bound at a time, keeping the side where the sign
+    // times v is at most the sign times the bound
+    auto clip = [](const std::vector<PlanePoint>& input, double bound, double sign)
+    {
+        std::vector<PlanePoint> output;
+        if (!std::isfinite(bound))
+            return input;
+        for (size_t i = 0; i < input.size(); i++)
+        {
+            const PlanePoint& a = input[i];
+            const PlanePoint& b = input[(i + 1) % input.size()];
+            bool a_inside = sign * a.v <= sign * bound;
+            bool b_inside = sign * b.v <= sign * bound;
+            if (a_inside)
+                output.push_back(a);
+            if (a_inside != b_inside)
+                output.push_back(PlanePoint{a.u + (bound - a.v) * (b.u - a.u) / (b.v - a.v),
+                                            bound});
+        }
+        return output;
+    };
+
+    return clip(clip(ring, v0, -1.0), v1, 1.0);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        clip_pass
+// Description: Finds the segments of a pass that are inside the zone.
+// Arguments:   - rings: zone outline and holes in the planning plane
+//              - v: position of the pass across the passes
+// Returns:     Segments in order of increasing u.
+//------------------------------------------------------------------------------
+std::vector<CoveragePlanner::Segment> CoveragePlanner::clip_pass(
+    const std::vector<std::vector<PlanePoint>>& rings, double v)
+{
+
+    // Each edge is treated as closed at its lower end and open at its upper
+    // end, so a pass through a vertex crosses exactly the edges that change
+    // sides there and horizontal edges are never crossed
+    std::vector<double> crossings;
+    for (const std::vector<PlanePoint>& ring : rings)
+    {
+        for (size_t i = 0; i < ring.size(); i++)
+        {
+            const PlanePoint& a = ring[i];
+            const PlanePoint& b = ring[(i + 1) % ring.size()];
+            if ((a.v <= v && v < b.v) || (b.v <= v && v < a.v))
+                crossings.push_back(a.u + (v - a.v) * (b.u - a.u) / (b.v - a.v));
+        }
+    }
+
+    // Crossings alternate between entering and leaving the zone
+    std::sort(crossings.begin(), crossings.end());
+    std::vector<Segment> segments;
+    for (size_t i = 0; i + 1 < crossings.size(); i += 2)
+        if (crossings[i + 1] > crossings[i])
+            segments.push_back(Segment{v, crossings[i], crossings[i + 1]});
+
+    return segments;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        build_cells
+// Description: Groups the segments of every pass into cells of
+//              segments on consecutive passes that overlap one to one.
+// Arguments:   - passes: segments of each pass, in pass order
+// Returns:     Segments of each cell, in pass order.
+//------------------------------------------------------------------------------
+std::vector<std::vector<CoveragePlanner::Segment>> CoveragePlanner::build_cells(
+    const std::vector<std::vector<Segment>>& passes)
+{
+
+    std::vector<std::vector<Segment>> cells;
+
+    // Cells that the previous pass's segments belong to
+    std::vector<size_t> previous_cells;
+    const std::vector<Segment>* previous = nullptr;
+
+    for (const std::vector<Segment>& pass : passes)
+    {
+
+        // Count how many segments each segment overlaps on the other pass.
+        // A segment only continues a cell if the two overlap each other
+        // and nothing else, otherwise the zone splits or merges there
+        size_t num_previous = previous == nullptr ? 0 : previous->size();
+        std::vector<int> previous_overlaps(num_previous, 0);
+        std::vector<int> overlaps(pass.size(), 0);
+        std::vector<size_t> overlapped(pass.size(), 0);
+        for (size_t i = 0; i < pass.size(); i++)
+        {
+            for (size_t j = 0; j < num_previous; j++)
+            {
+                const Segment& other = (*previous)[j];
+                if (pass[i].u0 < other.u1 && other.u0 < pass[i].u1)
+                {
+                    overlaps[i]++;
+                    overlapped[i] = j;
+                    previous_overlaps[j]++;
+                }
+            }
+        }
+
+        std::vector<size_t> pass_cells(pass.size());
+        for (size_t i = 0; i < pass.size(); i++)
+        {
+            if (overlaps[i] == 1 && previous_overlaps[overlapped[i]] == 1)
+            {
+                pass_cells[i] = previous_cells[overlapped[i]];
+            }
+            else
+            {
+                pass_cells[i] = cells.size();
+                cells.emplace_back();
+            }
+            cells[pass_cells[i]].push_back(pass[i]);
+        }
+
+        previous_cells.swap(pass_cells);
+        previous = &pass;
+
+    }
+
+    return cells;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        order_cells
+// Description: Drives every cell back and forth, visiting next the cell
+//              with the nearest starting corner.
+// Arguments:   - cells: segments of each cell, in pass order
+// Returns:     Path waypoints in the planning plane.
+//------------------------------------------------------------------------------
+std::vector<CoveragePlanner::PlanePoint> CoveragePlanner::order_cells(
+    const std::vector<std::vector<Segment>>& cells)
+{
+
+    std::vector<PlanePoint> path;
+    std::vector<bool> visited(cells.size(), false);
+
+    // The path starts at the beginning of the first pass
+    PlanePoint position{0.0, 0.0};
+    bool has_position = false;
+
+    for (size_t n = 0; n < cells.size(); n++)
+    {
+
+        // A cell can be entered at either end of its first or last pass
+        size_t best_cell = 0;
+        bool best_reversed = false;
+        bool best_backward = false;
+        double best_distance = std::numeric_limits<double>::infinity();
+        for (size_t c = 0; c < cells.size(); c++)
+        {
+
+            if (visited[c] || cells[c].empty())
+                continue;
+
+            if (!has_position)
+            {
+                best_cell = c;
+                best_distance = 0.0;
+                break;
+            }
+
+            for (int option = 0; option < 4; option++)
+            {
+                bool reversed = option & 1;
+                bool backward = option & 2;
+                const Segment& first = reversed ? cells[c].back() : cells[c].front();
+                double du = (backward ? first.u1 : first.u0) - position.u;
+                double dv = first.v - position.v;
+                double distance = du*du + dv*dv;
+                if (distance < best_distance)
+                {
+                    best_cell = c;
+                    best_reversed = reversed;
+                    best_backward = backward;
+                    best_distance = distance;
+                }
+            }
+
+        }
+
+        if (best_distance == std::numeric_limits<double>::infinity())
+            break;
+        visited[best_cell] = true;
+
+        // Drive each pass of the cell, turning around between passes
+        const std::vector<Segment>& cell = cells[best_cell];
+        bool backward = best_backward;
+        for (size_t i = 0; i < cell.size(); i++)
+        {
+            const Segment& segment = best_reversed ? cell[cell.size() - 1 - i] : cell[i];
+            double start = backward ? segment.u1 : segment.u0;
+            double end = backward ? segment.u0 : segment.u1;
+            path.push_back(PlanePoint{start, segment.v});
+            path.push_back(PlanePoint{end, segment.v});
+            backward = !backward;
+        }
+
+        position = path.back();
+        has_position = true;
+
+    }
+
+    return path;
+
+}
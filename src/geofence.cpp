@@ -46,7 +46,7 @@ int Geofence::size()
 //--------------------------------------------------------------------------
 void Geofence::append(double lat, double lon)
 {
-    geofence_points->append(QPointF(lat, lon));
+    append(QPointF(lat, lon));
 }
 
 
@@ -56,7 +56,10 @@ void Geofence::append(double lat, double lon)
 //--------------------------------------------------------------------------
 void Geofence::append(QPointF point)
 {
+    int index = geofence_points->size();
+    emit pointsAboutToBeInserted(index, index);
     geofence_points->append(point);
+    emit pointsInserted(index, index);
 }
 
 //--------------------------------------------------------------------------
@@ -65,7 +68,24 @@ void Geofence::append(QPointF point)
 //--------------------------------------------------------------------------
 void Geofence::clear()
 {
+    if (geofence_points->isEmpty())
+        return;
+    int last = geofence_points->size() - 1;
+    emit pointsAboutToBeRemoved(0, last);
     geofence_points->clear();
+    emit pointsRemoved(0, last);
+}
+
+//--------------------------------------------------------------------------
+// Name:        remove
+// Description: Removes the point at the specified index from the geofence.
+// Arguments:   - index: index of the point to remove
+//--------------------------------------------------------------------------
+void Geofence::remove(int index)
+{
+    emit pointsAboutToBeRemoved(index, index);
+    geofence_points->remove(index);
+    emit pointsRemoved(index, index);
 }
 
 //--------------------------------------------------------------------------
@@ -87,3 +107,28 @@ QPointF Geofence::get(int index)
 {
     return geofence_points->at(index);
 }
+
+//--------------------------------------------------------------------------
+// Name:        set
+// Description: Sets the location of the point at the given index.
+// Arguments:   - index: index of the point to set
+//              - point: new location with longitude as x and latitude as y
+//--------------------------------------------------------------------------
+void Geofence::set(int index, QPointF point)
+{
+    (*geofence_points)[index] = point;
+    emit pointChanged(index);
+}
+
+//--------------------------------------------------------------------------
+// Name:        move
+// Description: Moves the point at the given index to another index.
+// Arguments:   - from: index of the point to move
+//              - to: index to move the point to
+//--------------------------------------------------------------------------
+void Geofence::move(int from, int to)
+{
+    emit pointAboutToBeMoved(from, to);
+    geofence_points->move(from, to);
+    emit pointMoved(from, to);
+}
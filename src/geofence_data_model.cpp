@@ -6,6 +6,9 @@
 //==============================================================================
 #include "geofence_data_model.h"
 
+// C++ includes
+#include <algorithm>
+
 //==============================================================================
 //                              CLASS DEFINITION
 //==============================================================================
@@ -127,6 +130,71 @@ void GeofenceDataModel::set_task(Task* task_ptr)
     redraw();
 }
 
+//------------------------------------------------------------------------------
+// Name:        set_geofence
+// Description: Sets the geofence whose points should be displayed.
+// Arguments:   - geofence: pointer to the geofence to display
+//------------------------------------------------------------------------------
+void GeofenceDataModel::set_geofence(Geofence* geofence)
+{
+
+    beginResetModel();
+
+    if (current_geofence != nullptr)
+        disconnect(current_geofence, nullptr, this, nullptr);
+    current_geofence = geofence;
+
+    // Forward each change to the geofence as a change to only the rows it
+    // affects, so that the view keeps the delegates of the other rows
+    if (current_geofence != nullptr)
+    {
+
+        connect(current_geofence, &Geofence::pointsAboutToBeInserted, this,
+                [this](int first, int last)
+        {
+            beginInsertRows(QModelIndex(), first, last);
+        });
+        connect(current_geofence, &Geofence::pointsInserted, this, [this](int first, int)
+        {
+            endInsertRows();
+            number_rows(first);
+        });
+
+        connect(current_geofence, &Geofence::pointsAboutToBeRemoved, this,
+                [this](int first, int last)
+        {
+            beginRemoveRows(QModelIndex(), first, last);
+        });
+        connect(current_geofence, &Geofence::pointsRemoved, this, [this](int first, int)
+        {
+            endRemoveRows();
+            number_rows(first);
+        });
+
+        // A row moving down is inserted before the row after its new index
+        connect(current_geofence, &Geofence::pointAboutToBeMoved, this, [this](int from, int to)
+        {
+            beginMoveRows(QModelIndex(), from, from, QModelIndex(), to > from ? to + 1 : to);
+        });
+        connect(current_geofence, &Geofence::pointMoved, this, [this](int from, int to)
+        {
+            endMoveRows();
+            number_rows(std::min(from, to), std::max(from, to));
+        });
+
+        connect(current_geofence, &Geofence::pointChanged, this, [this](int index)
+        {
+            emit dataChanged(this->index(index, 0), this->index(index, columnCount() - 1));
+        });
+
+    }
+
+    endResetModel();
+    if (current_geofence != nullptr)
+        emit geofencepointsChanged(current_geofence->get_all());
+
+}
+
 //------------------------------------------------------------------------------
 // Name:        redraw
 // Description: Redraws the mission data model.
@@ -147,9 +215,7 @@ void GeofenceDataModel::move_point_up(const int row)
 {
     if (row > 0)
     {
-        beginResetModel();
-        task->move_point_up(row);
-        endResetModel();
+        current_geofence->move(row, row - 1);
         emit pointsChanged();
     }
 }
@@ -163,9 +229,7 @@ void GeofenceDataModel::move_point_down(const int row)
 {
     if (row < rowCount() - 1)
     {
-        beginResetModel();
-        task->move_point_down(row);
-        endResetModel();
+        current_geofence->move(row, row + 1);
         emit pointsChanged();
     }
 }
@@ -177,9 +241,7 @@ void GeofenceDataModel::move_point_down(const int row)
 //------------------------------------------------------------------------------
 void GeofenceDataModel::delete_point(const int row)
 {
-    beginResetModel();
-    task->remove_point(row);
-    endResetModel();
+    current_geofence->remove(row);
     emit pointsChanged();
 }
 
@@ -189,9 +251,7 @@ void GeofenceDataModel::delete_point(const int row)
 //------------------------------------------------------------------------------
 void GeofenceDataModel::clear_points()
 {
-    beginResetModel();
     current_geofence->clear();
-    endResetModel();
     emit geofencepointsChanged(current_geofence->get_all());
 }
 
@@ -209,15 +269,15 @@ void GeofenceDataModel::edit_point(const int row, const int column, const QVaria
     if(row < rowCount())
     {
 
+        QPointF point = current_geofence->get(row);
         switch (column)
         {
             // case 0: point number
-            case 1:  task->set_point_lat(row, value.toDouble()); break;
-            case 2:  task->set_point_lon(row, value.toDouble()); break;
+            case 1:  point.setY(value.toDouble()); break;
+            case 2:  point.setX(value.toDouble()); break;
         }
 
-        emit dataChanged(this->index(row, column),
-                         this->index(row, column));
+        current_geofence->set(row, point);
         emit pointsChanged();
 
     }
@@ -237,16 +297,15 @@ void GeofenceDataModel::reset_value(const int row, const int column)
     if(row < rowCount())
     {
 
+        QPointF point = current_geofence->get(row);
         switch (column)
         {
             // case 0: task number
-            case 1:  task->set_point_lat(row, std::nan("")); break;
-            case 2:  task->set_point_lat(row, std::nan("")); break;
+            case 1:  point.setY(std::nan("")); break;
+            case 2:  point.setX(std::nan("")); break;
         }
 
-        emit dataChanged(this->index(row, column),
-                         this->index(row, column));
-
+        current_geofence->set(row, point);
         emit pointsChanged();
     }
 
@@ -260,12 +319,7 @@ void GeofenceDataModel::reset_value(const int row, const int column)
 //------------------------------------------------------------------------------
 void GeofenceDataModel::append_point(double lat, double lon)
 {
-    int new_row_number = rowCount();
-    beginInsertRows(QModelIndex(), new_row_number, new_row_number);
     current_geofence->append(lon, lat);
-    endInsertRows();
-    emit dataChanged(this->index(rowCount(), 0),
-                     this->index(rowCount(), 3));
     qDebug()<<"Emitted the signal"<<endl;
     emit geofencepointsChanged(current_geofence->get_all());
  }
@@ -281,6 +335,23 @@ QVector<QPointF> GeofenceDataModel::get_points()
     return current_geofence->get_all();
 }
 
+//------------------------------------------------------------------------------
+// Name:        number_rows
+// Description: Updates the point number column of a range of rows, whose
+//              numbers change when rows are inserted, removed or moved
+//              before them.
+// Arguments:   - first: first row whose number changed
+//              - last: last row whose number changed, or -1 for the last
+//                row in the table
+//------------------------------------------------------------------------------
+void GeofenceDataModel::number_rows(int first, int last)
+{
+    if (last < 0 || last >= rowCount())
+        last = rowCount() - 1;
+    if (first <= last)
+        emit dataChanged(this->index(first, 0), this->index(last, 0));
+}
+
 //--------------------------------------------------------------------------
 // Name:        save_geofence
 // Description: save geofence points in xml format.
@@ -0,0 +1,231 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Spatial index of point graphics on the map, kept in a uniform
+//              grid of WGS84 cells for picking graphics under the mouse.
+//==============================================================================
+
+#include "graphic_index.h"
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+
+constexpr double GraphicIndex::DEFAULT_CELL_SIZE;
+constexpr double GraphicIndex::METERS_PER_DEGREE;
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        GraphicIndex constructor
+// Description: Constructs an empty index.
+// Arguments:   - cell_size: cell side length in degrees
+//------------------------------------------------------------------------------
+GraphicIndex::GraphicIndex(double cell_size) : cell_size(cell_size)
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        GraphicIndex destructor
+// Description: Default destructor.
+//------------------------------------------------------------------------------
+GraphicIndex::~GraphicIndex()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        insert
+// Description: Adds a graphic at a location, or moves it there if it is
+//              already in the index.
+// Arguments:   - graphic: graphic to add
+//              - location: graphic location with longitude as x and
+//                latitude as y
+//------------------------------------------------------------------------------
+void GraphicIndex::insert(Graphic* graphic, QPointF location)
+{
+
+    qint64 cell = get_cell(get_coordinate(location.x()), get_coordinate(location.y()));
+
+    // A graphic that stays in its cell only needs its location updated,
+    // which is the usual case for a dragged waypoint or a moving vehicle
+    auto it = entries.find(graphic);
+    if (it != entries.end())
+    {
+        it->location = location;
+        if (it->cell == cell)
+            return;
+        remove_from_cell(graphic, it->cell);
+        it->cell = cell;
+    }
+    else
+    {
+        entries.insert(graphic, Entry{location, cell});
+    }
+
+    cells[cell].push_back(graphic);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        remove
+// Description: Removes a graphic. Does nothing if it is not in the index.
+// Arguments:   - graphic: graphic to remove
+//------------------------------------------------------------------------------
+void GraphicIndex::remove(Graphic* graphic)
+{
+    auto it = entries.find(graphic);
+    if (it == entries.end())
+        return;
+    remove_from_cell(graphic, it->cell);
+    entries.erase(it);
+}
+
+//------------------------------------------------------------------------------
+// Name:        clear
+// Description: Removes every graphic.
+//------------------------------------------------------------------------------
+void GraphicIndex::clear()
+{
+    entries.clear();
+    cells.clear();
+}
+
+//------------------------------------------------------------------------------
+// Name:        size
+// Description: Gets the number of graphics in the index.
+// Returns:     Number of graphics.
+//------------------------------------------------------------------------------
+int GraphicIndex::size() const
+{
+    return entries.size();
+}
+
+//------------------------------------------------------------------------------
+// Name:        find_nearest
+// Description: Finds the graphic nearest to a location within a radius.
+// Arguments:   - location: location to search around with longitude as x
+//                and latitude as y
+//              - radius: search radius in meters
+//              - distance: set to the distance in meters to the graphic
+//                that is found, if not null
+// Returns:     Nearest graphic, or null if none is within the radius.
+//------------------------------------------------------------------------------
+Graphic* GraphicIndex::find_nearest(QPointF location, double radius, double* distance) const
+{
+
+    if (entries.isEmpty() || radius < 0.0)
+        return nullptr;
+
+    // A degree of longitude shrinks towards the poles, so the search box is
+    // wider in degrees than it is tall
+    double meters_per_lon = METERS_PER_DEGREE *
+        std::max(std::cos(location.y() * avl::geo::DEGREES_TO_RADIANS), 1.0e-6);
+    double radius_lon = radius / meters_per_lon;
+    double radius_lat = radius / METERS_PER_DEGREE;
+
+    Graphic* nearest = nullptr;
+    double nearest_distance_sq = radius * radius;
+    auto check = [&](Graphic* graphic, const QPointF& point)
+    {
+        double dx = (point.x() - location.x()) * meters_per_lon;
+        double dy = (point.y() - location.y()) * METERS_PER_DEGREE;
+        double distance_sq = dx * dx + dy * dy;
+        if (distance_sq <= nearest_distance_sq)
+        {
+            nearest = graphic;
+            nearest_distance_sq = distance_sq;
+        }
+    };
+
+    qint64 first_column = get_coordinate(location.x() - radius_lon);
+    qint64 last_column = get_coordinate(location.x() + radius_lon);
+    qint64 first_row = get_coordinate(location.y() - radius_lat);
+    qint64 last_row = get_coordinate(location.y() + radius_lat);
+
+    // When zoomed far out the radius can cover more cells than there are
+    // graphics, and checking every graphic is then cheaper
+    double num_cells = static_cast<double>(last_column - first_column + 1) *
+                       static_cast<double>(last_row - first_row + 1);
+    if (num_cells > entries.size())
+    {
+        for (auto it = entries.begin(); it != entries.end(); ++it)
+            check(it.key(), it->location);
+    }
+    else
+    {
+        for (qint64 column = first_column; column <= last_column; column++)
+        {
+            for (qint64 row = first_row; row <= last_row; row++)
+            {
+                auto cell = cells.find(get_cell(column, row));
+                if (cell == cells.end())
+                    continue;
+                for (Graphic* graphic : *cell)
+                    check(graphic, entries.value(graphic).location);
+            }
+        }
+    }
+
+    if (nearest != nullptr && distance != nullptr)
+        *distance = std::sqrt(nearest_distance_sq);
+
+    return nearest;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_cell
+// Description: Gets the key of the cell at a pair of cell coordinates.
+// Arguments:   - column: cell column, counted east from longitude 0
+//              - row: cell row, counted north from latitude 0
+// Returns:     Cell key.
+//------------------------------------------------------------------------------
+qint64 GraphicIndex::get_cell(qint64 column, qint64 row)
+{
+    return static_cast<qint64>((static_cast<quint64>(column) << 32) ^
+                               (static_cast<quint64>(row) & 0xFFFFFFFFu));
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_coordinate
+// Description: Gets the cell coordinate that a longitude or latitude
+//              falls in.
+// Arguments:   - degrees: longitude or latitude in degrees
+// Returns:     Cell column or row.
+//------------------------------------------------------------------------------
+qint64 GraphicIndex::get_coordinate(double degrees) const
+{
+    return static_cast<qint64>(std::floor(degrees / cell_size));
+}
+
+//------------------------------------------------------------------------------
+// Name:        remove_from_cell
+// Description: Removes a graphic from the list of graphics in a cell,
+//              dropping the cell if it becomes empty.
+// Arguments:   - graphic: graphic to remove
+//              - cell: key of the graphic's cell
+//------------------------------------------------------------------------------
+void GraphicIndex::remove_from_cell(Graphic* graphic, qint64 cell)
+{
+
+    auto it = cells.find(cell);
+    if (it == cells.end())
+        return;
+
+    // Cells hold few graphics, so the graphic is found by a linear search
+    // and swapped with the last one to remove it
+    std::vector<Graphic*>& graphics = *it;
+    auto position = std::find(graphics.begin(), graphics.end(), graphic);
+    if (position != graphics.end())
+    {
+        *position = graphics.back();
+        graphics.pop_back();
+    }
+    if (graphics.empty())
+        cells.erase(it);
+
+}
@@ -0,0 +1,265 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Link statistics for a single vehicle communication channel.
+//              Counts packets and bytes in each direction, invalid packets,
+//              and builds a histogram of status packet inter-arrival times
+//              that is used to estimate the number of lost status packets.
+//              Also keeps a histogram of status latency, the age of the
+//              status data when it arrives, for timestamped statuses.
+//==============================================================================
+
+#include "link_stats.h"
+
+// Vehicle command packets
+#include "comms/avl_commands.h"
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+// Inter-arrival and latency histogram bin upper edges in seconds
+const double LinkStats::INTERARRIVAL_BIN_EDGES[LinkStats::NUM_INTERARRIVAL_BINS - 1] =
+    {0.05, 0.1, 0.2, 0.5, 1.0, 2.0, 5.0, 10.0, 30.0};
+
+//------------------------------------------------------------------------------
+// Name:        LinkStats constructor
+// Description: Default constructor.
+//------------------------------------------------------------------------------
+LinkStats::LinkStats()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        LinkStats constructor
+// Description: Constructs empty link statistics for a comms channel.
+// Arguments:   - channel: comms channel the statistics describe
+//------------------------------------------------------------------------------
+LinkStats::LinkStats(CommsChannel::Value channel)
+{
+    switch (channel)
+    {
+        case CommsChannel::Value::COMMS_RADIO:    comms_channel = "RADIO"; break;
+        case CommsChannel::Value::COMMS_ACOUSTIC: comms_channel = "ACOMMS"; break;
+        case CommsChannel::Value::COMMS_IRIDIUM:  comms_channel = "IRIDIUM"; break;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Name:        LinkStats destructor
+// Description: Default destructor.
+//------------------------------------------------------------------------------
+LinkStats::~LinkStats()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_packet_channel
+// Description: Gets the comms channel a packet was sent over from its
+//              comms channel field. Packets without the field are
+//              assumed to have been sent over the radio.
+// Arguments:   - packet: packet to get the comms channel of
+// Returns:     Comms channel the packet was sent over.
+//------------------------------------------------------------------------------
+CommsChannel::Value LinkStats::get_packet_channel(avl::Packet& packet)
+{
+
+    if (!packet.has_field(COMMS_CHANNEL_DESC))
+        return CommsChannel::Value::COMMS_RADIO;
+
+    std::vector<uint8_t> field_data = packet.get_field(COMMS_CHANNEL_DESC).get_data();
+    if (field_data.empty())
+        return CommsChannel::Value::COMMS_RADIO;
+
+    switch (field_data.at(0))
+    {
+        case COMMS_CHANNEL_ACOMMS:  return CommsChannel::Value::COMMS_ACOUSTIC;
+        case COMMS_CHANNEL_IRIDIUM: return CommsChannel::Value::COMMS_IRIDIUM;
+        default:                    return CommsChannel::Value::COMMS_RADIO;
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        record_packet_in
+// Description: Records a valid packet received over the channel. Status
+//              packets also update the inter-arrival histogram and the
+//              lost packet estimate.
+// Arguments:   - num_bytes: total number of bytes in the packet
+//              - is_status: true if the packet is a status packet
+//              - time_ms: receive time in milliseconds since epoch
+//------------------------------------------------------------------------------
+void LinkStats::record_packet_in(int num_bytes, bool is_status, qint64 time_ms)
+{
+
+    packets_in++;
+    bytes_in += num_bytes;
+
+    if (!is_status)
+        return;
+
+    status_packets++;
+
+    // The inter-arrival time needs a previous status packet to compare to
+    if (last_status_ms >= 0 && time_ms >= last_status_ms)
+    {
+
+        double interarrival = (time_ms - last_status_ms) / 1000.0;
+
+        interarrival_counts[get_bin(interarrival)]++;
+
+        // A gap of several expected periods means the packets in between
+        // were lost. Otherwise the gap is a normal period and is used to
+        // refine the expected period
+        if (std::isnan(expected_period))
+        {
+            expected_period = interarrival;
+        }
+        else if (expected_period > 0.0 &&
+                 interarrival > LOSS_GAP_FACTOR * expected_period)
+        {
+            packets_lost += static_cast<int>(std::round(interarrival / expected_period)) - 1;
+        }
+        else
+        {
+            expected_period += PERIOD_SMOOTHING * (interarrival - expected_period);
+        }
+
+        loss_percent = 100.0 * packets_lost / (status_packets + packets_lost);
+
+    }
+
+    last_status_ms = time_ms;
+    status_age = 0.0;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        record_packet_out
+// Description: Records a packet sent over the channel.
+// Arguments:   - num_bytes: total number of bytes in the packet
+//------------------------------------------------------------------------------
+void LinkStats::record_packet_out(int num_bytes)
+{
+    packets_out++;
+    bytes_out += num_bytes;
+}
+
+//------------------------------------------------------------------------------
+// Name:        record_checksum_failure
+// Description: Records received bytes that failed checksum validation.
+// Arguments:   - num_bytes: number of bytes that were discarded
+//------------------------------------------------------------------------------
+void LinkStats::record_checksum_failure(int num_bytes)
+{
+    checksum_failures++;
+    bytes_in += num_bytes;
+}
+
+//------------------------------------------------------------------------------
+// Name:        record_parse_error
+// Description: Records received bytes that could not be parsed into a
+//              packet for reasons other than a checksum failure.
+// Arguments:   - num_bytes: number of bytes that were discarded
+//------------------------------------------------------------------------------
+void LinkStats::record_parse_error(int num_bytes)
+{
+    parse_errors++;
+    bytes_in += num_bytes;
+}
+
+//------------------------------------------------------------------------------
+// Name:        record_latency
+// Description: Records the latency of a timestamped status packet.
+// Arguments:   - seconds: time from the status being sampled on the
+//                vehicle to it being received, in local clock time
+//------------------------------------------------------------------------------
+void LinkStats::record_latency(double seconds)
+{
+
+    if (!std::isfinite(seconds))
+        return;
+
+    // Residual clock offset error can make very short links appear to
+    // deliver data from the future, which is shown as no latency
+    if (seconds < 0.0)
+        seconds = 0.0;
+
+    latency = seconds;
+    latency_samples++;
+    latency_sum += seconds;
+    mean_latency = latency_sum / latency_samples;
+    latency_counts[get_bin(seconds)]++;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        update_status_age
+// Description: Updates the status age from the time of the last status
+//              packet. The age is NaN if no status has been received.
+// Arguments:   - time_ms: current time in milliseconds since epoch
+//------------------------------------------------------------------------------
+void LinkStats::update_status_age(qint64 time_ms)
+{
+    if (last_status_ms < 0)
+        status_age = std::nan("");
+    else
+        status_age = (time_ms - last_status_ms) / 1000.0;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_interarrival_bins
+// Description: Gets the upper edges of the inter-arrival histogram bins.
+// Returns:     List of bin upper edges in seconds.
+//------------------------------------------------------------------------------
+QVariantList LinkStats::get_interarrival_bins() const
+{
+    QVariantList bins;
+    for (int i = 0; i < NUM_INTERARRIVAL_BINS - 1; i++)
+        bins.append(INTERARRIVAL_BIN_EDGES[i]);
+    return bins;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_interarrival_histogram
+// Description: Gets the status inter-arrival histogram counts.
+// Returns:     List of counts, one per histogram bin.
+//------------------------------------------------------------------------------
+QVariantList LinkStats::get_interarrival_histogram() const
+{
+    QVariantList histogram;
+    for (int i = 0; i < NUM_INTERARRIVAL_BINS; i++)
+        histogram.append(interarrival_counts[i]);
+    return histogram;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_latency_histogram
+// Description: Gets the status latency histogram counts. The histogram
+//              uses the same bins as the inter-arrival histogram.
+// Returns:     List of counts, one per histogram bin.
+//------------------------------------------------------------------------------
+QVariantList LinkStats::get_latency_histogram() const
+{
+    QVariantList histogram;
+    for (int i = 0; i < NUM_INTERARRIVAL_BINS; i++)
+        histogram.append(latency_counts[i]);
+    return histogram;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_bin
+// Description: Gets the histogram bin for a time in seconds.
+// Arguments:   - seconds: time to get the bin of
+// Returns:     Index of the first bin whose upper edge is above the
+//              time, or the last bin if the time is above every edge.
+//------------------------------------------------------------------------------
+int LinkStats::get_bin(double seconds)
+{
+    int bin = 0;
+    while (bin < NUM_INTERARRIVAL_BINS - 1 && seconds > INTERARRIVAL_BIN_EDGES[bin])
+        bin++;
+    return bin;
+}
@@ -30,6 +30,8 @@
 #include "geofence_data_model.h"
 #include "param_data_model.h"
 #include "action_type.h"
+#include "telemetry_channel.h"
+#include "replay_engine.h"
 
 using namespace Esri::ArcGISRuntime;
 
@@ -66,6 +68,7 @@ int main(int argc, char *argv[])
     TaskType::declare_qml();
     Task::declare_qml();
     ActionType::declare_qml();
+    TelemetryChannel::declare_qml();
 
     // Configure the QML engine
     QQmlApplicationEngine engine;
@@ -84,12 +87,16 @@ int main(int argc, char *argv[])
                                    param_data_model, geofence_data_model);
     QVector<QPointF> geofence_points;
 
+    // Replays recorded traffic into the vehicle manager
+    ReplayEngine replay_engine(&vehicle_manager);
+
     engine.rootContext()->setContextProperty("vehicle_data_model", vehicle_list_model);
     engine.rootContext()->setContextProperty("mission_data_model", mission_data_model);
     engine.rootContext()->setContextProperty("points_data_model", points_data_model);
     engine.rootContext()->setContextProperty("vehicle_manager", &vehicle_manager);
     engine.rootContext()->setContextProperty("geofence_data_model", geofence_data_model);
     engine.rootContext()->setContextProperty("param_data_model", param_data_model);
+    engine.rootContext()->setContextProperty("replay_engine", &replay_engine);
     // Load the main QML file
     engine.load(QUrl("qrc:///qml/main.qml"));
 
@@ -47,16 +47,16 @@ int Mission::size()
 //------------------------------------------------------------------------------
 void Mission::append()
 {
-    Task* new_task = new Task(this);
-    task_list.append(new_task);
-    connect(new_task, SIGNAL(taskChanged()), this, SLOT(task_changed()));
-    emit missionChanged();
+    append(new Task(this));
 }
 
 void Mission::append(Task* task)
 {
+    int index = task_list.size();
+    emit tasksAboutToBeInserted(index, index);
     task_list.append(task);
     connect(task, SIGNAL(taskChanged()), this, SLOT(task_changed()));
+    emit tasksInserted(index, index);
     emit missionChanged();
 }
 //------------------------------------------------------------------------------
@@ -89,7 +89,9 @@ QVector<Task*> Mission::get_all()
 //------------------------------------------------------------------------------
 void Mission::remove(int index)
 {
+    emit tasksAboutToBeRemoved(index, index);
     task_list.remove(index);
+    emit tasksRemoved(index, index);
     emit missionChanged();
 }
 
@@ -101,7 +103,9 @@ void Mission::remove(int index)
 //------------------------------------------------------------------------------
 void Mission::move_up(int index)
 {
+    emit taskAboutToBeMoved(index, index - 1);
     task_list.move(index, index - 1);
+    emit taskMoved(index, index - 1);
     emit missionChanged();
 }
 
@@ -113,7 +117,9 @@ void Mission::move_up(int index)
 //------------------------------------------------------------------------------
 void Mission::move_down(int index)
 {
+    emit taskAboutToBeMoved(index, index + 1);
     task_list.move(index, index + 1);
+    emit taskMoved(index, index + 1);
     emit missionChanged();
 }
 
@@ -123,7 +129,13 @@ void Mission::move_down(int index)
 //------------------------------------------------------------------------------
 void Mission::clear()
 {
-    task_list.clear();
+    if (!task_list.isEmpty())
+    {
+        int last = task_list.size() - 1;
+        emit tasksAboutToBeRemoved(0, last);
+        task_list.clear();
+        emit tasksRemoved(0, last);
+    }
     emit missionChanged();
 }
 
@@ -147,9 +159,16 @@ std::vector<avl::Packet> Mission::get_task_packets()
 //------------------------------------------------------------------------------
 // Name:        task_changed
 // Description: Slot called when one of the tasks in a mission changes.
-//              Simply emits a missionChanged signal.
+//              Emits taskEdited for the task and missionChanged.
 //------------------------------------------------------------------------------
 void Mission::task_changed()
 {
+
+    // Tasks that were removed from the mission may still signal
+    int index = task_list.indexOf(qobject_cast<Task*>(sender()));
+    if (index >= 0)
+        emit taskEdited(index);
+
     emit missionChanged();
+
 }
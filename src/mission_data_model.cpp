@@ -7,6 +7,9 @@
 
 #include "mission_data_model.h"
 
+// C++ includes
+#include <algorithm>
+
 //==============================================================================
 //                              CLASS DEFINITION
 //==============================================================================
@@ -66,7 +69,7 @@ QVariant MissionDataModel::data(const QModelIndex &index, int role) const
                     case 0: return index.row();
                     case 1: return task->get_duration();
                     case 2: return QString::fromStdString(TaskType::to_string(task->get_type()));
-                    case 3: return task->get_points().size();
+                    case 3: return task->get_num_points();
                     case 4: return task->get_roll();
                     case 5: return task->get_pitch();
                     case 6: return task->get_yaw();
@@ -133,6 +136,70 @@ QHash<int, QByteArray> MissionDataModel::roleNames() const
     return { {Qt::DisplayRole, "display"} };
 }
 
+//------------------------------------------------------------------------------
+// Name:        set_mission
+// Description: Sets the mission whose tasks should be displayed.
+// Arguments:   - mission_ptr: pointer to the mission to display
+//------------------------------------------------------------------------------
+void MissionDataModel::set_mission(Mission* mission_ptr)
+{
+
+    beginResetModel();
+
+    if (mission != nullptr)
+        disconnect(mission, nullptr, this, nullptr);
+    mission = mission_ptr;
+
+    // Forward each change to the mission as a change to only the rows it
+    // affects, so that the view keeps the delegates of the other rows
+    if (mission != nullptr)
+    {
+
+        connect(mission, &Mission::tasksAboutToBeInserted, this, [this](int first, int last)
+        {
+            beginInsertRows(QModelIndex(), first, last);
+        });
+        connect(mission, &Mission::tasksInserted, this, [this](int first, int)
+        {
+            endInsertRows();
+            number_rows(first);
+        });
+
+        connect(mission, &Mission::tasksAboutToBeRemoved, this, [this](int first, int last)
+        {
+            beginRemoveRows(QModelIndex(), first, last);
+        });
+        connect(mission, &Mission::tasksRemoved, this, [this](int first, int)
+        {
+            endRemoveRows();
+            number_rows(first);
+        });
+
+        // A row moving down is inserted before the row after its new index
+        connect(mission, &Mission::taskAboutToBeMoved, this, [this](int from, int to)
+        {
+            beginMoveRows(QModelIndex(), from, from, QModelIndex(), to > from ? to + 1 : to);
+        });
+        connect(mission, &Mission::taskMoved, this, [this](int from, int to)
+        {
+            endMoveRows();
+            number_rows(std::min(from, to), std::max(from, to));
+        });
+
+        // Any value of a task may have changed, including its number of
+        // points
+        connect(mission, &Mission::taskEdited, this, [this](int index)
+        {
+            emit dataChanged(this->index(index, 0), this->index(index, columnCount() - 1));
+        });
+
+    }
+
+    endResetModel();
+    points_data_model->redraw();
+
+}
+
 //------------------------------------------------------------------------------
 // Name:        redraw
 // Description: Redraws the mission data model.
@@ -150,12 +217,7 @@ void MissionDataModel::redraw()
 //------------------------------------------------------------------------------
 void MissionDataModel::append_task()
 {
-
-    int new_row_number = rowCount();
-    beginInsertRows(QModelIndex(), new_row_number, new_row_number);
     mission->append();
-    endInsertRows();
-
 }
 
 //--------------------------------------------------------------------------
@@ -164,14 +226,9 @@ void MissionDataModel::append_task()
 //--------------------------------------------------------------------------
 void MissionDataModel::append_path_task()
 {
-
-    int new_row_number = rowCount();
-    beginInsertRows(QModelIndex(), new_row_number, new_row_number);
     Task* path_task = new Task();
     path_task->set_type(TaskType::TASK_PATH);
     mission->append(path_task);
-    endInsertRows();
-
 }
 
 //------------------------------------------------------------------------------
@@ -183,8 +240,6 @@ void MissionDataModel::select_task(int index)
 {
     selected_task = index;
     points_data_model->set_task(get_selected_task());
-    connect(points_data_model, SIGNAL(pointsChanged()),
-            this,              SLOT(points_changed()));
 }
 
 //------------------------------------------------------------------------------
@@ -226,11 +281,7 @@ int MissionDataModel::get_selected_task_index()
 void MissionDataModel::move_task_up(const int row)
 {
     if (row > 0)
-    {
-        beginResetModel();
         mission->move_up(row);
-        endResetModel();
-    }
 }
 
 //------------------------------------------------------------------------------
@@ -241,11 +292,7 @@ void MissionDataModel::move_task_up(const int row)
 void MissionDataModel::move_task_down(const int row)
 {
     if (row < rowCount() - 1)
-    {
-        beginResetModel();
         mission->move_down(row);
-        endResetModel();
-    }
 }
 
 //------------------------------------------------------------------------------
@@ -255,9 +302,7 @@ void MissionDataModel::move_task_down(const int row)
 //------------------------------------------------------------------------------
 void MissionDataModel::delete_task(const int row)
 {
-    beginResetModel();
     mission->remove(row);
-    endResetModel();
 }
 
 //------------------------------------------------------------------------------
@@ -266,9 +311,7 @@ void MissionDataModel::delete_task(const int row)
 //------------------------------------------------------------------------------
 void MissionDataModel::clear_mission()
 {
-    beginResetModel();
     mission->clear();
-    endResetModel();
 }
 
 //------------------------------------------------------------------------------
@@ -316,8 +359,6 @@ void MissionDataModel::edit_mission(const int row, const int column, const QVari
             case 16: task->set_angle(value.toDouble()); break;
         }
 
-        emit dataChanged(this->index(row, column),
-                         this->index(row, column));
     }
 
 }
@@ -359,8 +400,6 @@ void MissionDataModel::reset_value(const int row, const int column)
             case 16:  task->set_angle(std::nan("")); break;
         }
 
-        emit dataChanged(this->index(row, column),
-                         this->index(row, column));
     }
 
 }
@@ -373,21 +412,22 @@ void MissionDataModel::reset_value(const int row, const int column)
 //------------------------------------------------------------------------------
 void MissionDataModel::append_point(double lat, double lon)
 {
-        points_data_model->append_point(lat, lon);
-        points_data_model->redraw();
-        emit dataChanged(this->index(selected_task, 3),
-                         this->index(selected_task, 3));
-
+    points_data_model->append_point(lat, lon);
 }
 
 //------------------------------------------------------------------------------
-// Name:        points_changed
-// Description: Slot that is called when the points in a task change. Emits
-//              a dataChanged signal to update column indicating the number
-//              of points in a task.
+// Name:        number_rows
+// Description: Updates the task number column of a range of rows, whose
+//              numbers change when rows are inserted, removed or moved
+//              before them.
+// Arguments:   - first: first row whose number changed
+//              - last: last row whose number changed, or -1 for the last
+//                row in the table
 //------------------------------------------------------------------------------
-void MissionDataModel::points_changed()
+void MissionDataModel::number_rows(int first, int last)
 {
-    emit dataChanged(this->index(selected_task, 3),
-                     this->index(selected_task, 3));
+    if (last < 0 || last >= rowCount())
+        last = rowCount() - 1;
+    if (first <= last)
+        emit dataChanged(this->index(first, 0), this->index(last, 0));
 }
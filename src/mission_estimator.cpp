@@ -0,0 +1,826 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Estimates the time and distance to run a mission by stepping
+//              a simple vehicle model through its tasks, simulating only the
+//              tasks and legs affected by a change.
+//==============================================================================
+
+#include "mission_estimator.h"
+
+// Leg distances and bearings
+#include "util/geo.h"
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+constexpr double MissionEstimator::DEFAULT_SPEED;
+constexpr double MissionEstimator::DEFAULT_TURN_RADIUS;
+constexpr double MissionEstimator::DEFAULT_VERTICAL_SPEED;
+
+// Rounding error in radians below which a turn is treated as no turn
+static const double ANGLE_TOLERANCE = 1e-9;
+
+//==============================================================================
+//                              HELPER FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        same_value
+// Description: Checks if two values are equal, treating NaNs as equal.
+// Arguments:   - a: first value
+//              - b: second value
+// Returns:     True if the values are equal.
+//------------------------------------------------------------------------------
+static bool same_value(double a, double b)
+{
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+//------------------------------------------------------------------------------
+// Name:        is_valid
+// Description: Checks if a point is a valid location.
+// Arguments:   - point: point with longitude as x and latitude as y
+// Returns:     True if both coordinates are finite.
+//------------------------------------------------------------------------------
+static bool is_valid(const QPointF& point)
+{
+    return std::isfinite(point.x()) && std::isfinite(point.y());
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_end_depth
+// Description: Gets the depth of the vehicle at the end of a leg of a task.
+//              Legs after the first in a task all end at the same depth.
+// Arguments:   - input: task values
+//              - depth: depth at the start of the leg
+// Returns:     Depth in meters.
+//------------------------------------------------------------------------------
+static double get_end_depth(const MissionEstimator::TaskInput& input, double depth)
+{
+    if (input.dive)
+        return 0.0;
+    return std::isfinite(input.depth) ? input.depth : depth;
+}
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        TaskInput::get_num_points
+// Description: Gets the number of points in the task.
+// Returns:     Number of points.
+//------------------------------------------------------------------------------
+int MissionEstimator::TaskInput::get_num_points() const
+{
+    return static_cast<int>(lats.size());
+}
+
+//------------------------------------------------------------------------------
+// Name:        TaskInput::get_point
+// Description: Gets the location of a point in the task.
+// Arguments:   - index: index of the point
+// Returns:     Point location with longitude as x and latitude as y.
+//------------------------------------------------------------------------------
+QPointF MissionEstimator::TaskInput::get_point(int index) const
+{
+    if (index == moved_index)
+        return moved_point;
+    return QPointF(lons[static_cast<size_t>(index)], lats[static_cast<size_t>(index)]);
+}
+
+//------------------------------------------------------------------------------
+// Name:        TaskInput::same_parameters
+// Description: Checks if two tasks have the same values other than their
+//              points.
+// Arguments:   - other: task values to compare to
+// Returns:     True if the task values other than the points are equal.
+//------------------------------------------------------------------------------
+bool MissionEstimator::TaskInput::same_parameters(const TaskInput& other) const
+{
+    return type == other.type && same_value(duration, other.duration) &&
+           speed == other.speed && same_value(depth, other.depth) &&
+           dive == other.dive;
+}
+
+//------------------------------------------------------------------------------
+// Name:        State::operator==
+// Description: Checks if two vehicle states are equal.
+// Arguments:   - other: state to compare to
+// Returns:     True if the states are equal.
+//------------------------------------------------------------------------------
+bool MissionEstimator::State::operator==(const State& other) const
+{
+    return has_location == other.has_location && location == other.location &&
+           has_heading == other.has_heading && heading == other.heading &&
+           depth == other.depth;
+}
+
+//------------------------------------------------------------------------------
+// Name:        MissionEstimator constructor
+// Description: Constructs an estimator for an empty mission.
+// Arguments:   - turn_radius: vehicle turn radius in meters
+//              - vertical_speed: vehicle vertical speed in meters per
+//                second
+//------------------------------------------------------------------------------
+MissionEstimator::MissionEstimator(double turn_radius, double vertical_speed) :
+    turn_radius(turn_radius), vertical_speed(vertical_speed)
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        MissionEstimator destructor
+// Description: Disconnects from the tasks of the mission.
+//------------------------------------------------------------------------------
+MissionEstimator::~MissionEstimator()
+{
+    for (TaskResult& result : results)
+        for (const QMetaObject::Connection& connection : result.connections)
+            QObject::disconnect(connection);
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_input
+// Description: Gets the values of a task that the simulation depends on.
+//              The task's x velocity is its speed if it is positive.
+// Arguments:   - task: task to get the values of
+// Returns:     Task values.
+//------------------------------------------------------------------------------
+MissionEstimator::TaskInput MissionEstimator::get_input(Task* task)
+{
+
+    TaskInput input;
+    input.type = task->get_type();
+    input.duration = task->get_duration();
+    input.speed = task->get_vx() > 0.0 ? task->get_vx() : DEFAULT_SPEED;
+    input.depth = task->get_depth();
+    input.dive = task->get_dive();
+    input.lats = task->get_lats();
+    input.lons = task->get_lons();
+    return input;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        update
+// Description: Updates the estimate to a mission, simulating only the
+//              tasks whose starting state or values changed, and only
+//              the legs of an edited task next to its changed points.
+//              Tasks are matched to their previous results by identity,
+//              and new tasks are connected to so that their point edits
+//              are followed.
+// Arguments:   - tasks: tasks in the mission
+// Returns:     Number of legs that were driven.
+//------------------------------------------------------------------------------
+size_t MissionEstimator::update(const QVector<Task*>& tasks)
+{
+
+    // Results follow their task as tasks are added, removed and reordered
+    std::vector<TaskResult> old_results;
+    old_results.swap(results);
+    std::unordered_map<Task*, size_t> old_indices;
+    for (size_t i = 0; i < old_results.size(); i++)
+        old_indices[old_results[i].task] = i;
+
+    // A task that is not edited and starts in the same state as before is
+    // not simulated again. Tasks are timed from their own start, so a task
+    // that takes longer does not change the tasks after it
+    results.reserve(static_cast<size_t>(tasks.size()));
+    State state;
+    size_t num_legs = 0;
+    for (Task* task : tasks)
+    {
+
+        TaskResult result;
+        auto it = old_indices.find(task);
+        if (it != old_indices.end())
+        {
+            result = std::move(old_results[it->second]);
+            old_results[it->second].task = nullptr;
+            old_indices.erase(it);
+        }
+        else
+        {
+            result.task = task;
+            connect_task(result);
+        }
+
+        num_legs += simulate(get_input(task), state, result);
+        result.edited_begin = 0;
+        result.edited_end = 0;
+        result.reset = false;
+        state = result.end;
+        results.push_back(std::move(result));
+
+    }
+
+    // Tasks that left the mission are no longer followed
+    for (TaskResult& result : old_results)
+        if (result.task != nullptr)
+            for (const QMetaObject::Connection& connection : result.connections)
+                QObject::disconnect(connection);
+
+    // Count each task from the end of the one before it
+    double time = 0.0;
+    double distance = 0.0;
+    for (TaskResult& result : results)
+    {
+        result.start_time = time;
+        result.start_distance = distance;
+        time += result.time;
+        distance += result.distance;
+    }
+
+    return num_legs;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_time
+// Description: Gets the estimated time to run the mission.
+// Returns:     Mission time in seconds.
+//------------------------------------------------------------------------------
+double MissionEstimator::get_time() const
+{
+    return results.empty() ? 0.0 : results.back().start_time + results.back().time;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_distance
+// Description: Gets the estimated horizontal distance driven in the
+//              mission, including turns.
+// Returns:     Mission distance in meters.
+//------------------------------------------------------------------------------
+double MissionEstimator::get_distance() const
+{
+    return results.empty() ? 0.0 : results.back().start_distance + results.back().distance;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_eta
+// Description: Gets the estimated time from the start of the mission
+//              that a waypoint is reached.
+// Arguments:   - task_index: index of the task in the mission
+//              - point_index: index of the waypoint in the task
+// Returns:     Time in seconds, or NaN if there is no such waypoint.
+//------------------------------------------------------------------------------
+double MissionEstimator::get_eta(int task_index, int point_index) const
+{
+
+    if (task_index < 0 || static_cast<size_t>(task_index) >= results.size())
+        return std::nan("");
+    const TaskResult& result = results[static_cast<size_t>(task_index)];
+    if (point_index < 0 || static_cast<size_t>(point_index) >= result.legs.size() ||
+        !result.legs[static_cast<size_t>(point_index)].driven)
+        return std::nan("");
+
+    double eta = result.start_time;
+    for (size_t i = 0; i <= static_cast<size_t>(point_index); i++)
+        eta += result.legs[i].time;
+    return eta;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        preview_point
+// Description: Estimates the mission with a waypoint moved, without
+//              changing the estimate. Only the legs to the waypoint and
+//              the two after it are driven, along with the first legs of
+//              the tasks after it whose starting state changes.
+// Arguments:   - task: task that the waypoint belongs to
+//              - index: index of the waypoint in the task
+//              - location: location to move the waypoint to with
+//                longitude as x and latitude as y
+//              - time: set to the mission time in seconds
+//              - distance: set to the mission distance in meters
+// Returns:     True if the legs could be previewed, or false if a task
+//              has edits that were not simulated yet or points that are
+//              not valid locations.
+//------------------------------------------------------------------------------
+bool MissionEstimator::preview_point(Task* task, int index, QPointF location,
+                                     double& time, double& distance) const
+{
+
+    auto it = std::find_if(results.begin(), results.end(),
+                           [task](const TaskResult& result) { return result.task == task; });
+    if (it == results.end() || index < 0 || static_cast<size_t>(index) >= it->legs.size() ||
+        !is_valid(location))
+        return false;
+
+    time = get_time();
+    distance = get_distance();
+
+    // The moved waypoint's task starts as before, and each task after it is
+    // started from where the one before it now ends until a task ends as
+    // before. Primitives and zones pass the vehicle's location on
+    State start = it->start;
+    for (; it != results.end(); ++it)
+    {
+
+        const TaskResult& result = *it;
+        TaskInput input = get_input(result.task);
+        if (result.task == task)
+        {
+            input.moved_index = index;
+            input.moved_point = location;
+        }
+        size_t num_points = static_cast<size_t>(input.get_num_points());
+
+        State end = start;
+        if (input.type == TaskType::TASK_PRIMITIVE && std::isfinite(input.depth))
+            end.depth = input.depth;
+
+        if (input.type == TaskType::TASK_WAYPOINT || input.type == TaskType::TASK_PATH)
+        {
+
+            if (result.reset || result.edited_begin < result.edited_end ||
+                !result.valid_points || result.legs.size() != num_points ||
+                get_end_depth(input, result.start.depth) != get_end_depth(input, start.depth))
+                return false;
+
+            // Only the first three legs depend on where the task starts
+            size_t begin = result.task == task ? static_cast<size_t>(index) : 0;
+            size_t end_leg = std::min(num_points, begin + 3);
+            for (size_t i = begin; i < end_leg; i++)
+            {
+                Leg leg = drive_leg(input, get_leg_start(input, start, i),
+                                    input.get_point(static_cast<int>(i)));
+                time += leg.time - result.legs[i].time;
+                distance += leg.distance - result.legs[i].distance;
+            }
+            end = get_leg_start(input, start, num_points);
+
+        }
+
+        if (end == result.end)
+            break;
+        start = end;
+
+    }
+
+    return true;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        connect_task
+// Description: Connects to the point edit signals of a task so that the
+//              legs of its result follow its points.
+// Arguments:   - result: result of the task to connect to
+//------------------------------------------------------------------------------
+void MissionEstimator::connect_task(TaskResult& result)
+{
+
+    // Only the task is captured, since its result moves as the mission is
+    // updated
+    Task* task = result.task;
+    result.connections.push_back(QObject::connect(task, &Task::pointsInserted,
+        [this, task](int first, int last) { points_inserted(task, first, last); }));
+    result.connections.push_back(QObject::connect(task, &Task::pointsRemoved,
+        [this, task](int first, int last) { points_removed(task, first, last); }));
+    result.connections.push_back(QObject::connect(task, &Task::pointMoved,
+        [this, task](int from, int to) { point_moved(task, from, to); }));
+    result.connections.push_back(QObject::connect(task, &Task::pointChanged,
+        [this, task](int index) { point_changed(task, index); }));
+    result.connections.push_back(QObject::connect(task, &Task::pointsReset,
+        [this, task]() { points_reset(task); }));
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        find_result
+// Description: Finds the result of a task in the mission.
+// Arguments:   - task: task to find the result of
+// Returns:     Result of the task, or null if it has not been simulated.
+//------------------------------------------------------------------------------
+MissionEstimator::TaskResult* MissionEstimator::find_result(Task* task)
+{
+    auto it = std::find_if(results.begin(), results.end(),
+                           [task](const TaskResult& result) { return result.task == task; });
+    return it == results.end() ? nullptr : &*it;
+}
+
+//------------------------------------------------------------------------------
+// Name:        points_inserted, points_removed, point_moved,
+//              point_changed, points_reset
+// Description: Slots called when points of a task are edited. The legs
+//              are shifted to line up with the points, and the legs to
+//              the edited points and the two points after them are
+//              marked to be driven. If the legs no longer line up with
+//              the points, every leg is driven on the next update.
+// Arguments:   - task: task whose points were edited
+//              - first: index of the first inserted or removed point
+//              - last: index of the last inserted or removed point
+//              - from: index of the point before it moves
+//              - to: index of the point after it moves
+//              - index: index of the changed point
+//------------------------------------------------------------------------------
+void MissionEstimator::points_inserted(Task* task, int first, int last)
+{
+    TaskResult* result = find_result(task);
+    size_t count = static_cast<size_t>(last - first + 1);
+    if (result == nullptr || result->reset)
+        return;
+    if (static_cast<size_t>(first) > result->legs.size() ||
+        result->legs.size() + count != static_cast<size_t>(task->get_num_points()))
+        result->reset = true;
+    else
+        insert_legs(*result, static_cast<size_t>(first), count);
+}
+
+void MissionEstimator::points_removed(Task* task, int first, int last)
+{
+    TaskResult* result = find_result(task);
+    size_t count = static_cast<size_t>(last - first + 1);
+    if (result == nullptr || result->reset)
+        return;
+    if (static_cast<size_t>(first) + count > result->legs.size() ||
+        result->legs.size() != static_cast<size_t>(task->get_num_points()) + count)
+        result->reset = true;
+    else
+        remove_legs(*result, static_cast<size_t>(first), count);
+}
+
+void MissionEstimator::point_moved(Task* task, int from, int to)
+{
+    TaskResult* result = find_result(task);
+    if (result == nullptr || result->reset)
+        return;
+    if (static_cast<size_t>(std::max(from, to)) >= result->legs.size() ||
+        result->legs.size() != static_cast<size_t>(task->get_num_points()))
+    {
+        result->reset = true;
+        return;
+    }
+    remove_legs(*result, static_cast<size_t>(from), 1);
+    insert_legs(*result, static_cast<size_t>(to), 1);
+}
+
+void MissionEstimator::point_changed(Task* task, int index)
+{
+    TaskResult* result = find_result(task);
+    if (result == nullptr || result->reset)
+        return;
+    if (static_cast<size_t>(index) >= result->legs.size() ||
+        result->legs.size() != static_cast<size_t>(task->get_num_points()))
+        result->reset = true;
+    else
+        mark_legs(*result, static_cast<size_t>(index), static_cast<size_t>(index) + 3);
+}
+
+void MissionEstimator::points_reset(Task* task)
+{
+    TaskResult* result = find_result(task);
+    if (result != nullptr)
+        result->reset = true;
+}
+
+//------------------------------------------------------------------------------
+// Name:        insert_legs, remove_legs
+// Description: Inserts or removes the legs to a range of points of a
+//              task, shifting its edited legs and marking the legs that
+//              now follow different points.
+// Arguments:   - result: result of the task
+//              - first: index of the first inserted or removed leg
+//              - count: number of legs to insert or remove
+//------------------------------------------------------------------------------
+void MissionEstimator::insert_legs(TaskResult& result, size_t first, size_t count)
+{
+
+    if (result.edited_begin < result.edited_end)
+    {
+        if (result.edited_begin >= first)
+            result.edited_begin += count;
+        if (result.edited_end > first)
+            result.edited_end += count;
+    }
+
+    // The new legs and the two after them are driven
+    result.legs.insert(result.legs.begin() + static_cast<long>(first), count, Leg());
+    mark_legs(result, first, first + count + 2);
+
+}
+
+void MissionEstimator::remove_legs(TaskResult& result, size_t first, size_t count)
+{
+
+    if (result.edited_begin < result.edited_end)
+    {
+        if (result.edited_begin >= first + count)
+            result.edited_begin -= count;
+        else if (result.edited_begin > first)
+            result.edited_begin = first;
+        if (result.edited_end >= first + count)
+            result.edited_end -= count;
+        else if (result.edited_end > first)
+            result.edited_end = first;
+    }
+
+    // The removed legs are taken out of the running sums, and the two legs
+    // after them are driven
+    for (size_t i = first; i < first + count; i++)
+    {
+        result.time -= result.legs[i].time;
+        result.distance -= result.legs[i].distance;
+    }
+    result.legs.erase(result.legs.begin() + static_cast<long>(first),
+                      result.legs.begin() + static_cast<long>(first + count));
+    mark_legs(result, first, first + 2);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        mark_legs
+// Description: Marks a range of legs of a task to be driven on the next
+//              update, along with the legs already marked.
+// Arguments:   - result: result of the task
+//              - begin: index of the first leg to mark
+//              - end: index after the last leg to mark
+//------------------------------------------------------------------------------
+void MissionEstimator::mark_legs(TaskResult& result, size_t begin, size_t end)
+{
+    end = std::min(end, result.legs.size());
+    if (begin >= end)
+        return;
+    if (result.edited_begin < result.edited_end)
+    {
+        begin = std::min(begin, result.edited_begin);
+        end = std::max(end, result.edited_end);
+    }
+    result.edited_begin = begin;
+    result.edited_end = end;
+}
+
+//------------------------------------------------------------------------------
+// Name:        simulate
+// Description: Simulates one task, reusing the legs of its previous
+//              result that were not marked as edited.
+// Arguments:   - input: task values
+//              - start: vehicle state at the start of the task
+//              - result: previous result of the task, which is updated
+// Returns:     Number of legs that were driven.
+//------------------------------------------------------------------------------
+size_t MissionEstimator::simulate(const TaskInput& input, const State& start,
+                                  TaskResult& result) const
+{
+
+    // An edit to some of the points of a task, or to where it starts, only
+    // drives the legs next to them as long as the task's other values did
+    // not change
+    bool keep_legs = !result.reset && result.valid_points &&
+                     result.input.same_parameters(input);
+    result.input = input;
+    switch (input.type)
+    {
+
+        // A primitive holds its guidance values for its duration
+        case TaskType::TASK_PRIMITIVE:
+            result.start = start;
+            result.end = start;
+            result.legs.clear();
+            result.time = 0.0;
+            result.distance = 0.0;
+            if (std::isfinite(input.duration) && input.duration > 0.0)
+                result.time = input.duration;
+            if (std::isfinite(input.depth))
+                result.end.depth = input.depth;
+            return 0;
+
+        case TaskType::TASK_WAYPOINT:
+        case TaskType::TASK_PATH:
+            break;
+
+        // Zones are not sent to the vehicle, their path task is
+        case TaskType::TASK_ZONE:
+            result.start = start;
+            result.end = start;
+            result.legs.clear();
+            result.time = 0.0;
+            result.distance = 0.0;
+            return 0;
+
+    }
+
+    if (keep_legs)
+    {
+        int num_legs = simulate_edit(input, start, result);
+        if (num_legs >= 0)
+            return static_cast<size_t>(num_legs);
+    }
+
+    // Otherwise drive every leg, skipping points that are not locations
+    size_t num_points = static_cast<size_t>(input.get_num_points());
+    result.start = start;
+    result.legs.assign(num_points, Leg());
+    result.valid_points = true;
+    result.time = 0.0;
+    result.distance = 0.0;
+    State state = start;
+    for (size_t i = 0; i < num_points; i++)
+    {
+        QPointF point = input.get_point(static_cast<int>(i));
+        if (!is_valid(point))
+        {
+            result.valid_points = false;
+            continue;
+        }
+        result.legs[i] = drive_leg(input, state, point);
+        advance(input, point, state);
+        result.time += result.legs[i].time;
+        result.distance += result.legs[i].distance;
+    }
+    result.end = state;
+    return num_points;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        simulate_edit
+// Description: Simulates a task whose points or start state were edited by
+//              driving only the legs that depend on the changes. The leg to
+//              a waypoint depends on it and the two waypoints before it, and
+//              only the first three legs depend on more of the start state
+//              than the depth that the task's legs end at.
+// Arguments:   - input: task values
+//              - start: vehicle state at the start of the task
+//              - result: previous result of the task, with the same values
+//                other than the points, which is updated
+// Returns:     Number of legs that were driven, or -1 if the legs that were
+//              kept would change or the edit added points that are not
+//              valid locations.
+//------------------------------------------------------------------------------
+int MissionEstimator::simulate_edit(const TaskInput& input, const State& start,
+                                    TaskResult& result) const
+{
+
+    size_t num_points = static_cast<size_t>(input.get_num_points());
+    if (result.legs.size() != num_points)
+        return -1;
+
+    bool same_start = result.start == start;
+    if (!same_start && get_end_depth(input, result.start.depth) != get_end_depth(input, start.depth))
+        return -1;
+
+    size_t begin = result.edited_begin;
+    size_t end = std::max(result.edited_begin, result.edited_end);
+    if (!same_start)
+    {
+        end = std::max(end, std::min(num_points, size_t(3)));
+        begin = 0;
+    }
+
+    for (size_t i = begin; i < end; i++)
+        if (!is_valid(input.get_point(static_cast<int>(i))))
+            return -1;
+
+    // The edited legs are driven again and the running sums are updated by
+    // the difference
+    result.start = start;
+    for (size_t i = begin; i < end; i++)
+    {
+        result.time -= result.legs[i].time;
+        result.distance -= result.legs[i].distance;
+        result.legs[i] = drive_leg(input, get_leg_start(input, start, i),
+                                   input.get_point(static_cast<int>(i)));
+        result.time += result.legs[i].time;
+        result.distance += result.legs[i].distance;
+    }
+
+    result.end = get_leg_start(input, start, num_points);
+    return static_cast<int>(end - begin);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_leg_start
+// Description: Gets the state of the vehicle before the leg to a point of
+//              a task whose points are all valid locations.
+// Arguments:   - input: task values
+//              - start: vehicle state at the start of the task
+//              - index: index of the point, or the number of points to
+//                get the state at the end of the task
+// Returns:     Vehicle state.
+//------------------------------------------------------------------------------
+MissionEstimator::State MissionEstimator::get_leg_start(const TaskInput& input,
+    const State& start, size_t index) const
+{
+
+    if (index == 0)
+        return start;
+
+    // The state after the leg before the last one only needs its location
+    // and depth for the last leg to set the heading. The vehicle only keeps
+    // its depth at a point it starts the mission at
+    State state = start;
+    if (index >= 2)
+    {
+        if (start.has_location || index > 2)
+            state.depth = get_end_depth(input, start.depth);
+        state.has_location = true;
+        state.location = input.get_point(static_cast<int>(index)-2);
+    }
+    advance(input, input.get_point(static_cast<int>(index)-1), state);
+    return state;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        drive_leg
+// Description: Gets the leg driving the vehicle to a waypoint, turning
+//              onto it first and changing depth on the way.
+// Arguments:   - input: values of the task that the waypoint belongs to
+//              - state: vehicle state before the leg
+//              - target: waypoint with longitude as x and latitude as y
+// Returns:     Time and distance of the leg.
+//------------------------------------------------------------------------------
+MissionEstimator::Leg MissionEstimator::drive_leg(const TaskInput& input,
+    const State& state, QPointF target) const
+{
+
+    // The mission starts at its first waypoint
+    Leg leg;
+    leg.driven = true;
+    if (!state.has_location)
+        return leg;
+
+    double distance = avl::geo::distance(state.location.y(), state.location.x(),
+                                         target.y(), target.x());
+    double bearing = avl::geo::bearing(state.location.y(), state.location.x(),
+                                       target.y(), target.x()) * avl::geo::DEGREES_TO_RADIANS;
+    double horizontal = distance;
+
+    // Turn along a circle toward the waypoint and drive straight from where
+    // the circle's tangent passes through it. The turn is mirrored so that
+    // it is always a turn through a positive angle in the leg's own frame,
+    // with the vehicle at the origin heading along x and the circle's center
+    // on the y axis
+    if (state.has_heading && turn_radius > 0.0 && distance > 0.0)
+    {
+        double turn = std::fabs(std::remainder(bearing - state.heading, 2.0 * avl::geo::PI));
+        double center_to_target_x = distance * std::cos(turn);
+        double center_to_target_y = distance * std::sin(turn) - turn_radius;
+        double center_distance = std::hypot(center_to_target_x, center_to_target_y);
+        if (center_distance > turn_radius)
+        {
+            double tangent_angle = std::atan2(center_to_target_y, center_to_target_x) -
+                                   std::acos(turn_radius / center_distance);
+            double arc = tangent_angle + avl::geo::PI / 2.0;
+            if (arc < -ANGLE_TOLERANCE)
+                arc += 2.0 * avl::geo::PI;
+            arc = std::max(arc, 0.0);
+            horizontal = turn_radius * arc + std::sqrt(center_distance * center_distance -
+                                                       turn_radius * turn_radius);
+        }
+        else
+        {
+            // The waypoint is inside the turning circle, so the vehicle
+            // turns through the full angle before heading straight to it
+            horizontal = turn_radius * turn + distance;
+        }
+    }
+
+    // Depth changes while driving, and a diving task surfaces at the end of
+    // each leg after reaching its depth
+    double target_depth = std::isfinite(input.depth) ? input.depth : state.depth;
+    double vertical = std::fabs(target_depth - state.depth);
+    if (input.dive)
+        vertical += target_depth;
+
+    leg.time = horizontal / input.speed;
+    if (vertical_speed > 0.0)
+        leg.time = std::max(leg.time, vertical / vertical_speed);
+    leg.distance = horizontal;
+    return leg;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        advance
+// Description: Moves the vehicle state to the end of the leg to a
+//              waypoint.
+// Arguments:   - input: values of the task that the waypoint belongs to
+//              - target: waypoint with longitude as x and latitude as y
+//              - state: vehicle state, which is advanced to the waypoint
+//------------------------------------------------------------------------------
+void MissionEstimator::advance(const TaskInput& input, QPointF target, State& state)
+{
+
+    // The mission starts at its first waypoint
+    if (!state.has_location)
+    {
+        state.has_location = true;
+        state.location = target;
+        return;
+    }
+
+    state.has_heading = true;
+    state.heading = avl::geo::bearing(state.location.y(), state.location.x(),
+                                      target.y(), target.x()) * avl::geo::DEGREES_TO_RADIANS;
+    state.location = target;
+    state.depth = get_end_depth(input, state.depth);
+
+}
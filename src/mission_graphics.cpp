@@ -0,0 +1,826 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Map graphics for a vehicle's mission, kept between updates so
+//              that an update only touches the graphics of points that
+//              changed, and shifted at the edited index as points are
+//              inserted, removed and moved.
+//==============================================================================
+
+#include "mission_graphics.h"
+
+// Survey generation and z-indices
+#include "graphics.h"
+
+// Cached waypoint symbols
+#include "symbol_cache.h"
+
+// ArcGIS includes
+#include <LabelDefinition.h>
+#include <PolygonBuilder.h>
+#include <PolylineBuilder.h>
+#include <SpatialReference.h>
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+
+// Names of the graphic attributes holding the kind of graphic, which
+// selects its symbol, and the waypoint label
+const char* MissionGraphics::KIND_ATTRIBUTE = "kind";
+const char* MissionGraphics::LABEL_ATTRIBUTE = "label";
+
+// Names of the waypoint graphic attributes holding the index of the
+// waypoint's task in the mission and of the waypoint in its task
+const char* MissionGraphics::TASK_INDEX_ATTRIBUTE = "task_index";
+const char* MissionGraphics::POINT_INDEX_ATTRIBUTE = "point_index";
+
+// Values of the kind attribute
+const char* MissionGraphics::WAYPOINT_KIND = "waypoint";
+const char* MissionGraphics::SEGMENT_KIND = "segment";
+const char* MissionGraphics::OUTLINE_KIND = "outline";
+
+// Waypoint label definition, which draws the label attribute in bold black
+// text centered on the waypoint. Waypoint labels are never hidden to make
+// room for other labels
+static const char* WAYPOINT_LABEL_JSON = R"({
+    "labelExpressionInfo": {"expression": "$feature.label"},
+    "labelPlacement": "esriServerPointLabelPlacementCenterCenter",
+    "deconflictionStrategy": "none",
+    "symbol": {
+        "type": "esriTS",
+        "color": [0, 0, 0, 255],
+        "font": {"size": 13, "weight": "bold"}
+    }
+})";
+
+//------------------------------------------------------------------------------
+// Name:        has_location
+// Description: Checks whether a point has a location.
+// Arguments:   - point: point with longitude as x and latitude as y
+// Returns:     True if neither coordinate is NaN.
+//------------------------------------------------------------------------------
+static bool has_location(const QPointF& point)
+{
+    return !std::isnan(point.x()) && !std::isnan(point.y());
+}
+
+//------------------------------------------------------------------------------
+// Name:        same_point
+// Description: Checks whether two points are the same, treating NaN
+//              coordinates as equal to each other.
+// Arguments:   - a: first point
+//              - b: second point
+// Returns:     True if the points are the same.
+//------------------------------------------------------------------------------
+static bool same_point(const QPointF& a, const QPointF& b)
+{
+    bool same_x = a.x() == b.x() || (std::isnan(a.x()) && std::isnan(b.x()));
+    bool same_y = a.y() == b.y() || (std::isnan(a.y()) && std::isnan(b.y()));
+    return same_x && same_y;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_task_points
+// Description: Gets the locations of a task's points.
+// Arguments:   - task: task to get the points of
+// Returns:     Point locations with longitude as x and latitude as y.
+//------------------------------------------------------------------------------
+static std::vector<QPointF> get_task_points(Task* task)
+{
+    avl::Span<double> lats = task->get_lats();
+    avl::Span<double> lons = task->get_lons();
+    std::vector<QPointF> points;
+    points.reserve(lats.size());
+    for (size_t i = 0; i < lats.size(); i++)
+        points.push_back(QPointF(lons[i], lats[i]));
+    return points;
+}
+
+//------------------------------------------------------------------------------
+// Name:        move_value
+// Description: Moves a value to another index of a vector, shifting the
+//              values between the two indices by one.
+// Arguments:   - values: vector to move the value in
+//              - from: index of the value before it moves
+//              - to: index of the value after it moves
+//------------------------------------------------------------------------------
+template<typename T>
+static void move_value(std::vector<T>& values, int from, int to)
+{
+    if (from < to)
+        std::rotate(values.begin() + from, values.begin() + from + 1, values.begin() + to + 1);
+    else
+        std::rotate(values.begin() + to, values.begin() + from, values.begin() + from + 1);
+}
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        MissionGraphics constructor
+// Description: Constructs mission graphics that draw into a graphics
+//              overlay, with nothing drawn.
+// Arguments:   - graphics_overlay: overlay to add the graphics to
+//              - graphic_index: index to keep the visible waypoint
+//                graphics in
+//              - parent: parent QObject
+//------------------------------------------------------------------------------
+MissionGraphics::MissionGraphics(GraphicsOverlay* graphics_overlay, GraphicIndex* graphic_index,
+                                 QObject* parent) :
+    QObject(parent), graphics_overlay(graphics_overlay), graphic_index(graphic_index)
+{
+
+    // A finished survey is written into its task by the next update
+    survey_generator = new SurveyGenerator(this);
+    connect(survey_generator, &SurveyGenerator::surveyReady,
+            this, &MissionGraphics::surveyChanged);
+
+    // Segments are partially transparent so that they do not hide the map
+    QColor segment_color = color;
+    segment_color.setAlpha(100);
+    segment_symbol = new SimpleLineSymbol(SimpleLineSymbolStyle::Solid, segment_color, 3, this);
+    outline_symbol = new SimpleLineSymbol(SimpleLineSymbolStyle::Solid, color, 3, this);
+
+    // Every graphic is drawn with the symbol of its kind
+    UniqueValueRenderer* renderer = new UniqueValueRenderer(this);
+    renderer->setFieldNames(QStringList{KIND_ATTRIBUTE});
+    waypoint_value = new UniqueValue(WAYPOINT_KIND, "", QVariantList{WAYPOINT_KIND},
+                                     SymbolCache::instance()->get_waypoint_symbol(color), this);
+    segment_value = new UniqueValue(SEGMENT_KIND, "", QVariantList{SEGMENT_KIND}, segment_symbol, this);
+    outline_value = new UniqueValue(OUTLINE_KIND, "", QVariantList{OUTLINE_KIND}, outline_symbol, this);
+    renderer->uniqueValues()->append(waypoint_value);
+    renderer->uniqueValues()->append(segment_value);
+    renderer->uniqueValues()->append(outline_value);
+    graphics_overlay->setRenderer(renderer);
+
+    // Waypoint numbers are drawn as labels rather than as part of the
+    // waypoint symbol
+    graphics_overlay->labelDefinitions()->append(
+        LabelDefinition::fromJson(WAYPOINT_LABEL_JSON, this));
+    graphics_overlay->setLabelsEnabled(true);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        MissionGraphics destructor
+// Description: Default destructor.
+//------------------------------------------------------------------------------
+MissionGraphics::~MissionGraphics()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        update
+// Description: Updates the graphics to match a mission, generating the
+//              survey path of any zone task whose survey inputs changed.
+// Arguments:   - mission: mission to draw
+//------------------------------------------------------------------------------
+void MissionGraphics::update(Mission* mission)
+{
+
+    for (auto& entry : task_graphics)
+        entry.second.found = false;
+
+    for (int i = 0; i < mission->size(); i++)
+    {
+
+        Task* task = mission->get(i);
+
+        // A zone task with enough points to enclose an area fills the task
+        // after it with its survey path
+        if (task->get_type() == TaskType::TASK_ZONE && task->get_num_points() > 2 &&
+            i + 1 < mission->size())
+        {
+            update_task(task, i);
+            update_survey(task, mission->get(i+1));
+            update_task(mission->get(i+1), i+1);
+            i++;
+            continue;
+        }
+
+        update_task(task, i);
+
+    }
+
+    // Remove the graphics of tasks that are no longer in the mission
+    for (auto it = task_graphics.begin(); it != task_graphics.end(); )
+    {
+        if (!it->second.found)
+        {
+            remove_task_graphics(it->second);
+            it = task_graphics.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        preview_point
+// Description: Moves the graphics of one point of a drawn task without
+//              looking at the rest of the mission. Only the point's
+//              waypoint, the segments to its neighbours and its zone
+//              outline are touched. The next update sees the point as
+//              already drawn.
+// Arguments:   - task: task that the point belongs to
+//              - point_index: index of the point in the task
+//              - location: new point location with longitude as x and
+//                latitude as y
+//------------------------------------------------------------------------------
+void MissionGraphics::preview_point(Task* task, int point_index, QPointF location)
+{
+
+    auto it = task_graphics.find(task);
+    if (it == task_graphics.end() || point_index < 0 ||
+        static_cast<size_t>(point_index) >= it->second.points.size())
+        return;
+
+    TaskGraphics& graphics = it->second;
+    size_t index = static_cast<size_t>(point_index);
+    graphics.points[index] = location;
+
+    switch (graphics.type)
+    {
+
+        case TaskType::TASK_PRIMITIVE:
+        {
+            break;
+        }
+
+        case TaskType::TASK_WAYPOINT:
+        {
+            update_waypoint(graphics, index, "");
+            break;
+        }
+
+        case TaskType::TASK_PATH:
+        {
+            update_waypoint(graphics, index, "");
+            if (index > 0)
+                update_segment(graphics, index);
+            if (index + 1 < graphics.points.size())
+                update_segment(graphics, index + 1);
+            break;
+        }
+
+        case TaskType::TASK_ZONE:
+        {
+            update_waypoint(graphics, index, "z");
+            update_outline(graphics);
+            break;
+        }
+
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        set_color
+// Description: Sets the mission color.
+// Arguments:   - color: mission color
+//------------------------------------------------------------------------------
+void MissionGraphics::set_color(QColor color)
+{
+
+    if (color == this->color)
+        return;
+
+    this->color = color;
+    QColor segment_color = color;
+    segment_color.setAlpha(100);
+    segment_symbol->setColor(segment_color);
+    outline_symbol->setColor(color);
+
+    // The symbols are set again so that the renderer redraws with them
+    waypoint_value->setSymbol(SymbolCache::instance()->get_waypoint_symbol(color));
+    segment_value->setSymbol(segment_symbol);
+    outline_value->setSymbol(outline_symbol);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        clear
+// Description: Removes every graphic.
+//------------------------------------------------------------------------------
+void MissionGraphics::clear()
+{
+
+    graphics_overlay->graphics()->clear();
+
+    for (auto& entry : task_graphics)
+    {
+        TaskGraphics& graphics = entry.second;
+        for (const QMetaObject::Connection& connection : graphics.connections)
+            disconnect(connection);
+        for (Graphic* graphic : graphics.waypoint_graphics)
+        {
+            graphic_index->remove(graphic);
+            delete graphic;
+        }
+        for (Graphic* graphic : graphics.segment_graphics)
+            delete graphic;
+        delete graphics.outline_graphic;
+    }
+    task_graphics.clear();
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        update_task
+// Description: Updates the graphics of a task to match its points.
+// Arguments:   - task: task to draw
+//              - task_index: index of the task in the mission
+//------------------------------------------------------------------------------
+void MissionGraphics::update_task(Task* task, int task_index)
+{
+
+    // A task whose type changed is drawn again from scratch
+    auto it = task_graphics.find(task);
+    if (it != task_graphics.end() && it->second.type != task->get_type())
+    {
+        remove_task_graphics(it->second);
+        task_graphics.erase(it);
+        it = task_graphics.end();
+    }
+    if (it == task_graphics.end())
+    {
+        it = task_graphics.insert(std::make_pair(task, TaskGraphics())).first;
+        it->second.type = task->get_type();
+        connect_task(task, it->second);
+    }
+
+    TaskGraphics& graphics = it->second;
+    graphics.found = true;
+    std::vector<QPointF> points = get_task_points(task);
+
+    // Waypoints keep their task index up to date as tasks are reordered
+    if (graphics.task_index != task_index)
+    {
+        graphics.task_index = task_index;
+        for (Graphic* graphic : graphics.waypoint_graphics)
+            graphic->attributes()->replaceAttribute(TASK_INDEX_ATTRIBUTE, task_index);
+    }
+
+    switch (graphics.type)
+    {
+
+        case TaskType::TASK_PRIMITIVE:
+        {
+            break;
+        }
+
+        case TaskType::TASK_WAYPOINT:
+        {
+            points.resize(std::min(points.size(), size_t(1)));
+            update_points(graphics, points, "", false);
+            break;
+        }
+
+        case TaskType::TASK_PATH:
+        {
+            update_points(graphics, points, "", true);
+            break;
+        }
+
+        case TaskType::TASK_ZONE:
+        {
+
+            // The outline is a single graphic, so it is rebuilt whenever any
+            // zone point changes
+            if (update_points(graphics, points, "z", false) || graphics.outline_graphic == nullptr)
+                update_outline(graphics);
+
+            break;
+
+        }
+
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        connect_task
+// Description: Connects to a task's point edit signals so that its drawn
+//              graphics are shifted as points are inserted, removed and
+//              moved.
+// Arguments:   - task: task to connect to
+//              - graphics: graphics of the task
+//------------------------------------------------------------------------------
+void MissionGraphics::connect_task(Task* task, TaskGraphics& graphics)
+{
+
+    // Only the task is captured, since its graphics may be drawn again
+    // from scratch by the time it signals
+    graphics.connections.push_back(connect(task, &Task::pointsInserted, this,
+        [this, task](int first, int last) { insert_points(task, first, last); }));
+    graphics.connections.push_back(connect(task, &Task::pointsRemoved, this,
+        [this, task](int first, int last) { remove_points(task, first, last); }));
+    graphics.connections.push_back(connect(task, &Task::pointMoved, this,
+        [this, task](int from, int to) { move_point(task, from, to); }));
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        insert_points
+// Description: Inserts the graphics of points inserted into a drawn path
+//              or zone task. Does nothing if the task is not drawn up to
+//              the inserted points, leaving them to the next update.
+// Arguments:   - task: task that the points were inserted into
+//              - first: index of the first inserted point
+//              - last: index of the last inserted point
+//------------------------------------------------------------------------------
+void MissionGraphics::insert_points(Task* task, int first, int last)
+{
+
+    auto it = task_graphics.find(task);
+    if (it == task_graphics.end())
+        return;
+
+    TaskGraphics& graphics = it->second;
+    size_t begin = static_cast<size_t>(first);
+    size_t count = static_cast<size_t>(last - first + 1);
+    if ((graphics.type != TaskType::TASK_PATH && graphics.type != TaskType::TASK_ZONE) ||
+        begin > graphics.points.size() ||
+        graphics.points.size() + count != static_cast<size_t>(task->get_num_points()))
+        return;
+
+    graphics.points.insert(graphics.points.begin() + begin, count, QPointF());
+    graphics.waypoint_graphics.insert(graphics.waypoint_graphics.begin() + begin, count, nullptr);
+    graphics.segment_graphics.insert(graphics.segment_graphics.begin() + begin, count, nullptr);
+    for (size_t i = begin; i < begin + count; i++)
+        graphics.points[i] = task->get_point(static_cast<int>(i));
+
+    redraw_points(graphics, begin, begin + count);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        remove_points
+// Description: Removes the graphics of points removed from a drawn path
+//              or zone task. Does nothing if the task was not drawn with
+//              the removed points, leaving them to the next update.
+// Arguments:   - task: task that the points were removed from
+//              - first: index of the first removed point
+//              - last: index of the last removed point
+//------------------------------------------------------------------------------
+void MissionGraphics::remove_points(Task* task, int first, int last)
+{
+
+    auto it = task_graphics.find(task);
+    if (it == task_graphics.end())
+        return;
+
+    TaskGraphics& graphics = it->second;
+    size_t begin = static_cast<size_t>(first);
+    size_t end = static_cast<size_t>(last + 1);
+    if ((graphics.type != TaskType::TASK_PATH && graphics.type != TaskType::TASK_ZONE) ||
+        end > graphics.points.size() ||
+        graphics.points.size() - (end - begin) != static_cast<size_t>(task->get_num_points()))
+        return;
+
+    for (size_t i = begin; i < end; i++)
+    {
+        remove_graphic(graphics.waypoint_graphics[i]);
+        remove_graphic(graphics.segment_graphics[i]);
+    }
+    graphics.points.erase(graphics.points.begin() + begin, graphics.points.begin() + end);
+    graphics.waypoint_graphics.erase(graphics.waypoint_graphics.begin() + begin,
+                                     graphics.waypoint_graphics.begin() + end);
+    graphics.segment_graphics.erase(graphics.segment_graphics.begin() + begin,
+                                    graphics.segment_graphics.begin() + end);
+
+    redraw_points(graphics, begin, begin);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        move_point
+// Description: Moves the graphics of a point that moved to another index
+//              of a drawn path or zone task.
+// Arguments:   - task: task that the point moved in
+//              - from: index of the point before it moved
+//              - to: index of the point after it moved
+//------------------------------------------------------------------------------
+void MissionGraphics::move_point(Task* task, int from, int to)
+{
+
+    auto it = task_graphics.find(task);
+    if (it == task_graphics.end())
+        return;
+
+    TaskGraphics& graphics = it->second;
+    size_t begin = static_cast<size_t>(std::min(from, to));
+    size_t end = static_cast<size_t>(std::max(from, to) + 1);
+    if ((graphics.type != TaskType::TASK_PATH && graphics.type != TaskType::TASK_ZONE) ||
+        from < 0 || to < 0 || end > graphics.points.size() ||
+        graphics.points.size() != static_cast<size_t>(task->get_num_points()))
+        return;
+
+    move_value(graphics.points, from, to);
+    move_value(graphics.waypoint_graphics, from, to);
+    move_value(graphics.segment_graphics, from, to);
+
+    redraw_points(graphics, begin, end);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        redraw_points
+// Description: Redraws the waypoints of a range of points after the
+//              graphics were shifted, along with the segments joining
+//              them to each other and to their neighbours, the zone
+//              outline, and the labels and point indices of every
+//              waypoint from the start of the range on.
+// Arguments:   - graphics: graphics of the task
+//              - begin: index of the first point to redraw
+//              - end: index past the last point to redraw
+//------------------------------------------------------------------------------
+void MissionGraphics::redraw_points(TaskGraphics& graphics, size_t begin, size_t end)
+{
+
+    QString label_prefix = graphics.type == TaskType::TASK_ZONE ? "z" : "";
+    size_t size = graphics.points.size();
+
+    for (size_t i = begin; i < end; i++)
+        update_waypoint(graphics, i, label_prefix);
+
+    // Waypoints after the range keep their graphics but not their index
+    for (size_t i = end; i < size; i++)
+    {
+        Graphic* waypoint_graphic = graphics.waypoint_graphics[i];
+        if (waypoint_graphic == nullptr)
+            continue;
+        waypoint_graphic->attributes()->replaceAttribute(LABEL_ATTRIBUTE,
+                                                         label_prefix + QString::number(i));
+        waypoint_graphic->attributes()->replaceAttribute(POINT_INDEX_ATTRIBUTE,
+                                                         static_cast<int>(i));
+    }
+
+    if (graphics.type == TaskType::TASK_ZONE)
+    {
+        update_outline(graphics);
+        return;
+    }
+
+    // A segment that was shifted to the first point has nothing to join
+    if (size > 0 && graphics.segment_graphics[0] != nullptr)
+    {
+        remove_graphic(graphics.segment_graphics[0]);
+        graphics.segment_graphics[0] = nullptr;
+    }
+
+    for (size_t i = std::max(begin, size_t(1)); i < std::min(end + 1, size); i++)
+        update_segment(graphics, i);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        update_survey
+// Description: Writes the survey path of a zone task into the task that
+//              follows it if the zone's survey inputs changed and the
+//              path has been generated, and starts generating it if it
+//              has not.
+// Arguments:   - zone_task: zone task
+//              - path_task: task to hold the survey path
+//------------------------------------------------------------------------------
+void MissionGraphics::update_survey(Task* zone_task, Task* path_task)
+{
+
+    TaskGraphics& graphics = task_graphics[zone_task];
+    std::vector<QPointF> zone_points = get_task_points(zone_task);
+    double angle = zone_task->get_angle();
+    double swath = zone_task->get_swath();
+
+    quint64 key = SurveyGenerator::get_key(zone_points, angle, swath);
+    if (graphics.survey_task == path_task && graphics.survey_key == key)
+        return;
+
+    // An uncached survey is written on a later update, once surveyChanged
+    // is emitted
+    std::vector<QPointF> path;
+    if (!survey_generator->get_survey(zone_points, angle, swath, path))
+        return;
+
+    path_task->set_points_silent(QVector<QPointF>::fromStdVector(path));
+
+    graphics.survey_task = path_task;
+    graphics.survey_key = key;
+
+    // The path task changed without signalling, so the mission is told
+    emit surveyChanged();
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        update_points
+// Description: Updates the waypoint and segment graphics of a task to
+//              match a list of points, only touching the graphics of
+//              changed points.
+// Arguments:   - graphics: graphics of the task
+//              - points: points to draw
+//              - label_prefix: text before each waypoint's number
+//              - connect: true to join the points with segments
+// Returns:     True if any point changed.
+//------------------------------------------------------------------------------
+bool MissionGraphics::update_points(TaskGraphics& graphics, const std::vector<QPointF>& points,
+                                    QString label_prefix, bool connect)
+{
+
+    size_t old_size = graphics.points.size();
+    size_t new_size = points.size();
+    bool changed = old_size != new_size;
+
+    // Remove the graphics of points past the new end
+    for (size_t i = new_size; i < old_size; i++)
+    {
+        remove_graphic(graphics.waypoint_graphics[i]);
+        remove_graphic(graphics.segment_graphics[i]);
+    }
+    graphics.points.resize(new_size);
+    graphics.waypoint_graphics.resize(new_size, nullptr);
+    graphics.segment_graphics.resize(new_size, nullptr);
+
+    // Move changed points and add new ones, remembering which segments
+    // have a moved end
+    std::vector<bool> segment_changed(new_size, false);
+    for (size_t i = 0; i < new_size; i++)
+    {
+
+        if (i < old_size && same_point(graphics.points[i], points[i]))
+            continue;
+
+        changed = true;
+        graphics.points[i] = points[i];
+        update_waypoint(graphics, i, label_prefix);
+
+        if (connect)
+        {
+            segment_changed[i] = true;
+            if (i + 1 < new_size)
+                segment_changed[i+1] = true;
+        }
+
+    }
+
+    for (size_t i = 1; i < new_size; i++)
+        if (segment_changed[i])
+            update_segment(graphics, i);
+
+    return changed;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        update_waypoint
+// Description: Moves the waypoint graphic of a point to its drawn
+//              location, creating it if needed, and hides it if the point
+//              has no location.
+// Arguments:   - graphics: graphics of the task
+//              - index: index of the point
+//              - label_prefix: text before the waypoint's number
+//------------------------------------------------------------------------------
+void MissionGraphics::update_waypoint(TaskGraphics& graphics, size_t index, QString label_prefix)
+{
+
+    const QPointF& point = graphics.points[index];
+    bool visible = has_location(point);
+    Point location = visible ? Point(point.x(), point.y(), SpatialReference::wgs84()) : Point();
+
+    Graphic*& waypoint_graphic = graphics.waypoint_graphics[index];
+    if (waypoint_graphic == nullptr)
+    {
+        QVariantMap attributes;
+        attributes[KIND_ATTRIBUTE] = WAYPOINT_KIND;
+        attributes[LABEL_ATTRIBUTE] = label_prefix + QString::number(index);
+        attributes[TASK_INDEX_ATTRIBUTE] = graphics.task_index;
+        attributes[POINT_INDEX_ATTRIBUTE] = static_cast<int>(index);
+        waypoint_graphic = new Graphic(location, attributes, this);
+        waypoint_graphic->setZIndex(WAYPOINT_Z_INDEX);
+        graphics_overlay->graphics()->append(waypoint_graphic);
+    }
+    else
+    {
+        waypoint_graphic->setGeometry(location);
+    }
+    waypoint_graphic->setVisible(visible);
+
+    // Hidden waypoints cannot be picked
+    if (visible)
+        graphic_index->insert(waypoint_graphic, point);
+    else
+        graphic_index->remove(waypoint_graphic);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        update_outline
+// Description: Redraws the outline of a zone task through its drawn
+//              points.
+// Arguments:   - graphics: graphics of the zone task
+//------------------------------------------------------------------------------
+void MissionGraphics::update_outline(TaskGraphics& graphics)
+{
+
+    PolygonBuilder polygon_builder(SpatialReference::wgs84());
+    for (const QPointF& point : graphics.points)
+        polygon_builder.addPoint(point.x(), point.y());
+
+    if (graphics.outline_graphic == nullptr)
+    {
+        QVariantMap attributes;
+        attributes[KIND_ATTRIBUTE] = OUTLINE_KIND;
+        graphics.outline_graphic = new Graphic(polygon_builder.toGeometry(), attributes, this);
+        graphics.outline_graphic->setZIndex(SWATH_LINE_Z_INDEX);
+        graphics_overlay->graphics()->append(graphics.outline_graphic);
+    }
+    else
+    {
+        graphics.outline_graphic->setGeometry(polygon_builder.toGeometry());
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        update_segment
+// Description: Redraws the segment joining a point to the point before
+//              it, hiding it if either point has no location.
+// Arguments:   - graphics: graphics of the task
+//              - index: index of the point that the segment ends at
+//------------------------------------------------------------------------------
+void MissionGraphics::update_segment(TaskGraphics& graphics, size_t index)
+{
+
+    const QPointF& start = graphics.points[index-1];
+    const QPointF& end = graphics.points[index];
+    bool visible = has_location(start) && has_location(end);
+
+    PolylineBuilder polyline_builder(SpatialReference::wgs84());
+    if (visible)
+    {
+        polyline_builder.addPoint(start.x(), start.y());
+        polyline_builder.addPoint(end.x(), end.y());
+    }
+
+    Graphic*& segment_graphic = graphics.segment_graphics[index];
+    if (segment_graphic == nullptr)
+    {
+        QVariantMap attributes;
+        attributes[KIND_ATTRIBUTE] = SEGMENT_KIND;
+        segment_graphic = new Graphic(polyline_builder.toGeometry(), attributes, this);
+        segment_graphic->setZIndex(SWATH_LINE_Z_INDEX);
+        graphics_overlay->graphics()->append(segment_graphic);
+    }
+    else
+    {
+        segment_graphic->setGeometry(polyline_builder.toGeometry());
+    }
+    segment_graphic->setVisible(visible);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        remove_task_graphics
+// Description: Removes every graphic of a task and disconnects from the
+//              task's point edit signals.
+// Arguments:   - graphics: graphics of the task
+//------------------------------------------------------------------------------
+void MissionGraphics::remove_task_graphics(TaskGraphics& graphics)
+{
+
+    for (const QMetaObject::Connection& connection : graphics.connections)
+        disconnect(connection);
+    graphics.connections.clear();
+
+    for (Graphic* graphic : graphics.waypoint_graphics)
+        remove_graphic(graphic);
+    for (Graphic* graphic : graphics.segment_graphics)
+        remove_graphic(graphic);
+    remove_graphic(graphics.outline_graphic);
+
+    graphics.points.clear();
+    graphics.waypoint_graphics.clear();
+    graphics.segment_graphics.clear();
+    graphics.outline_graphic = nullptr;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        remove_graphic
+// Description: Removes a graphic from the overlay and the graphic index
+//              and deletes it. Does nothing if the graphic is null.
+// Arguments:   - graphic: graphic to remove
+//------------------------------------------------------------------------------
+void MissionGraphics::remove_graphic(Graphic* graphic)
+{
+    if (graphic == nullptr)
+        return;
+    graphic_index->remove(graphic);
+    graphics_overlay->graphics()->removeOne(graphic);
+    delete graphic;
+}
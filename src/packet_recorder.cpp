@@ -0,0 +1,506 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Flight recorder for raw vehicle traffic. Every buffer that is
+//              received from or sent to a vehicle is appended, with its
+//              timestamp, interface, peer address and direction, to a pcapng
+//              file that can be opened in Wireshark or replayed later.
+//==============================================================================
+
+#include "packet_recorder.h"
+
+// C++ includes
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+//==============================================================================
+//                                  CONSTANTS
+//==============================================================================
+
+// pcapng block types
+static const uint32_t SECTION_HEADER_BLOCK = 0x0A0D0D0A;
+static const uint32_t INTERFACE_DESCRIPTION_BLOCK = 0x00000001;
+static const uint32_t ENHANCED_PACKET_BLOCK = 0x00000006;
+
+// pcapng section header byte order magic and version
+static const uint32_t BYTE_ORDER_MAGIC = 0x1A2B3C4D;
+static const uint16_t MAJOR_VERSION = 1;
+static const uint16_t MINOR_VERSION = 0;
+
+// pcapng option codes
+static const uint16_t OPT_ENDOFOPT = 0;
+static const uint16_t OPT_COMMENT = 1;
+static const uint16_t SHB_USERAPPL = 4;
+static const uint16_t IF_NAME = 2;
+static const uint16_t IF_DESCRIPTION = 3;
+static const uint16_t EPB_FLAGS = 2;
+
+// epb_flags direction values
+static const uint32_t EPB_FLAGS_INBOUND = 0x1;
+static const uint32_t EPB_FLAGS_OUTBOUND = 0x2;
+
+// Link type for the raw AVL packet payloads
+static const uint16_t LINKTYPE_USER0 = 147;
+
+// Interface names and descriptions indexed by interface
+static const char* INTERFACE_NAMES[PacketRecorder::NUM_INTERFACES] =
+    {"avl-udp", "avl-tcp"};
+static const char* INTERFACE_DESCRIPTIONS[PacketRecorder::NUM_INTERFACES] =
+    {"AVL UDP multicast status traffic", "AVL TCP vehicle connections"};
+
+// Application name stored in the section header
+static const char* APPLICATION_NAME = "AVL Vehicle Control";
+
+// Interval at which the writer thread writes buffered records even if few
+// have arrived, bounding how much is lost if the application crashes
+static const std::chrono::milliseconds FLUSH_INTERVAL(1000);
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        PacketRecorder constructor
+// Description: Constructs a stopped recorder and allocates both record
+//              buffers.
+// Arguments:   - buffer_size: size of each record buffer in bytes
+//              - max_file_size: file size in bytes at which a new file
+//                is started
+//              - max_files: number of files to keep, or 0 to keep every
+//                file
+//------------------------------------------------------------------------------
+PacketRecorder::PacketRecorder(size_t buffer_size, size_t max_file_size,
+                               size_t max_files) :
+    buffer_size(buffer_size), max_file_size(max_file_size), max_files(max_files)
+{
+    front_buffer.reserve(buffer_size);
+    back_buffer.reserve(buffer_size);
+}
+
+//------------------------------------------------------------------------------
+// Name:        PacketRecorder destructor
+// Description: Stops the recorder, writing any buffered records.
+//------------------------------------------------------------------------------
+PacketRecorder::~PacketRecorder()
+{
+    stop();
+}
+
+//------------------------------------------------------------------------------
+// Name:        start
+// Description: Opens the first file and starts the writer thread. Files
+//              are named with the prefix followed by a file number and
+//              the .pcapng extension. Throws a std::runtime_error if the
+//              recorder is already running or the file cannot be
+//              opened.
+// Arguments:   - file_prefix: path and file name prefix of the files
+//------------------------------------------------------------------------------
+void PacketRecorder::start(const std::string& file_prefix)
+{
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (running)
+        throw std::runtime_error("PacketRecorder: recorder is already running");
+
+    this->file_prefix = file_prefix;
+    file_number = 0;
+    file_names.clear();
+    if (!open_file())
+        throw std::runtime_error("PacketRecorder: failed to open " + file_name);
+
+    front_buffer.clear();
+    back_buffer.clear();
+    stop_requested = false;
+    running = true;
+    writer_thread = std::thread(&PacketRecorder::writer_loop, this);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        stop
+// Description: Stops the writer thread after it has written all buffered
+//              records and closes the current file. Does nothing if the
+//              recorder is not running.
+//------------------------------------------------------------------------------
+void PacketRecorder::stop()
+{
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running)
+            return;
+        stop_requested = true;
+    }
+    buffer_ready.notify_one();
+
+    writer_thread.join();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    close_file();
+    running = false;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        is_running
+// Description: Checks whether the recorder is running.
+// Returns:     True if the recorder is running, false otherwise.
+//------------------------------------------------------------------------------
+bool PacketRecorder::is_running()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return running;
+}
+
+//------------------------------------------------------------------------------
+// Name:        record
+// Description: Records a buffer with the current time as its timestamp.
+//              The buffer is copied, so it does not need to outlive the
+//              call. If the record buffer is full the buffer is dropped
+//              and counted instead of blocking the caller. Does nothing
+//              if the recorder is not running.
+// Arguments:   - interface: interface the buffer was received or sent on
+//              - direction: direction of the buffer
+//              - peer_address: IPv4 address of the peer in host byte
+//                order
+//              - peer_port: port of the peer
+//              - data: pointer to the buffer
+//              - size: number of bytes in the buffer
+//------------------------------------------------------------------------------
+void PacketRecorder::record(Interface interface, Direction direction, uint32_t peer_address,
+                            uint16_t peer_port, const void* data, size_t size)
+{
+
+    // Take the timestamp before waiting on the lock so that it is as close
+    // to the receive time as possible
+    RecordHeader header;
+    header.time_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    header.size = static_cast<uint32_t>(size);
+    header.peer_address = peer_address;
+    header.peer_port = peer_port;
+    header.interface = static_cast<uint8_t>(interface);
+    header.direction = static_cast<uint8_t>(direction);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!running || stop_requested)
+        return;
+
+    // Never grow the buffer on the ingest path. A full buffer means the
+    // writer thread has fallen behind, so the record is dropped
+    if (front_buffer.size() + sizeof(RecordHeader) + size > buffer_size)
+    {
+        num_dropped++;
+        return;
+    }
+
+    const uint8_t* header_bytes = reinterpret_cast<const uint8_t*>(&header);
+    const uint8_t* data_bytes = static_cast<const uint8_t*>(data);
+    front_buffer.insert(front_buffer.end(), header_bytes, header_bytes + sizeof(RecordHeader));
+    front_buffer.insert(front_buffer.end(), data_bytes, data_bytes + size);
+
+    // Only wake the writer thread when the buffer is half full. Otherwise it
+    // wakes on its flush interval, which keeps wakeups off the ingest path
+    if (front_buffer.size() > buffer_size / 2)
+        buffer_ready.notify_one();
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_num_recorded
+// Description: Gets the number of buffers that have been recorded.
+// Returns:     Number of recorded buffers.
+//------------------------------------------------------------------------------
+uint64_t PacketRecorder::get_num_recorded()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return num_recorded;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_num_dropped
+// Description: Gets the number of buffers that were dropped because the
+//              record buffer was full or a file could not be written.
+// Returns:     Number of dropped buffers.
+//------------------------------------------------------------------------------
+uint64_t PacketRecorder::get_num_dropped()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return num_dropped;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_file_name
+// Description: Gets the name of the file currently being written.
+// Returns:     Current file name, or an empty string if the recorder is
+//              not running.
+//------------------------------------------------------------------------------
+std::string PacketRecorder::get_file_name()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return running ? file_name : std::string();
+}
+
+//------------------------------------------------------------------------------
+// Name:        writer_loop
+// Description: Writer thread function. Waits for records, swaps the
+//              record buffers and writes the records to file until the
+//              recorder is stopped.
+//------------------------------------------------------------------------------
+void PacketRecorder::writer_loop()
+{
+
+    bool stopping = false;
+    while (!stopping)
+    {
+
+        // Wait for the buffer to fill, the flush interval or a stop request
+        // and take the records. The swap keeps both buffers' storage
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            buffer_ready.wait_for(lock, FLUSH_INTERVAL, [this]
+            {
+                return stop_requested || front_buffer.size() > buffer_size / 2;
+            });
+            stopping = stop_requested;
+            front_buffer.swap(back_buffer);
+        }
+
+        // Write the records without holding the lock so that callers can
+        // keep filling the other buffer
+        uint64_t num_written = 0;
+        uint64_t num_failed = 0;
+        write_records(num_written, num_failed);
+        back_buffer.clear();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        num_recorded += num_written;
+        num_dropped += num_failed;
+
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        write_records
+// Description: Writes every record in the back buffer to file, rotating
+//              the file when it reaches the maximum size.
+// Arguments:   - num_written: set to the number of records written
+//              - num_failed: set to the number of records that could not
+//                be written
+//------------------------------------------------------------------------------
+void PacketRecorder::write_records(uint64_t& num_written, uint64_t& num_failed)
+{
+
+    num_written = 0;
+    num_failed = 0;
+
+    size_t offset = 0;
+    while (offset < back_buffer.size())
+    {
+
+        RecordHeader header;
+        std::memcpy(&header, back_buffer.data() + offset, sizeof(RecordHeader));
+        const uint8_t* data = back_buffer.data() + offset + sizeof(RecordHeader);
+        offset += sizeof(RecordHeader) + header.size;
+
+        // Enhanced packet block with the timestamp split into its high and
+        // low 32 bits in the default microsecond resolution
+        uint64_t time_us = static_cast<uint64_t>(header.time_us);
+        begin_block(ENHANCED_PACKET_BLOCK);
+        add_value<uint32_t>(header.interface);
+        add_value<uint32_t>(static_cast<uint32_t>(time_us >> 32));
+        add_value<uint32_t>(static_cast<uint32_t>(time_us & 0xFFFFFFFF));
+        add_value<uint32_t>(header.size);
+        add_value<uint32_t>(header.size);
+        add_bytes(data, header.size);
+
+        uint32_t flags = header.direction == DIRECTION_IN ? EPB_FLAGS_INBOUND : EPB_FLAGS_OUTBOUND;
+        add_option(EPB_FLAGS, &flags, sizeof(flags));
+
+        char peer[32];
+        int peer_length = std::snprintf(peer, sizeof(peer), "%u.%u.%u.%u:%u",
+                                        (header.peer_address >> 24) & 0xFF,
+                                        (header.peer_address >> 16) & 0xFF,
+                                        (header.peer_address >> 8) & 0xFF,
+                                        header.peer_address & 0xFF,
+                                        static_cast<unsigned>(header.peer_port));
+        if (peer_length > 0)
+            add_option(OPT_COMMENT, peer, static_cast<size_t>(peer_length));
+
+        add_option(OPT_ENDOFOPT, nullptr, 0);
+        end_block();
+
+        // Start a new file before this block if it would take the current
+        // file past its maximum size. A file that cannot be opened drops
+        // records until the next rotation attempt succeeds
+        if (file == nullptr || file_size + block.size() > max_file_size)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!open_file())
+            {
+                num_failed++;
+                continue;
+            }
+        }
+
+        if (write_block())
+            num_written++;
+        else
+            num_failed++;
+
+    }
+
+    if (file != nullptr)
+        std::fflush(file);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        open_file
+// Description: Closes the current file, opens the next file and writes
+//              the section header and interface description blocks.
+//              Deletes the oldest file if there are too many files.
+// Returns:     True if the file was opened, false otherwise.
+//------------------------------------------------------------------------------
+bool PacketRecorder::open_file()
+{
+
+    close_file();
+
+    file_name = file_prefix + "_" + std::to_string(file_number++) + ".pcapng";
+    file = std::fopen(file_name.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    file_size = 0;
+    file_names.push_back(file_name);
+    while (max_files > 0 && file_names.size() > max_files)
+    {
+        std::remove(file_names.front().c_str());
+        file_names.pop_front();
+    }
+
+    // The file blocks are built in a separate vector so that a block that
+    // is waiting to be written is not overwritten
+    std::vector<uint8_t> pending_block;
+    pending_block.swap(block);
+
+    // Section header block with an unspecified section length
+    begin_block(SECTION_HEADER_BLOCK);
+    add_value<uint32_t>(BYTE_ORDER_MAGIC);
+    add_value<uint16_t>(MAJOR_VERSION);
+    add_value<uint16_t>(MINOR_VERSION);
+    add_value<int64_t>(-1);
+    add_option(SHB_USERAPPL, APPLICATION_NAME, std::strlen(APPLICATION_NAME));
+    add_option(OPT_ENDOFOPT, nullptr, 0);
+    end_block();
+    bool success = write_block();
+
+    // Interface description block for each interface with no snapshot
+    // length limit
+    for (int i = 0; i < NUM_INTERFACES; i++)
+    {
+        begin_block(INTERFACE_DESCRIPTION_BLOCK);
+        add_value<uint16_t>(LINKTYPE_USER0);
+        add_value<uint16_t>(0);
+        add_value<uint32_t>(0);
+        add_option(IF_NAME, INTERFACE_NAMES[i], std::strlen(INTERFACE_NAMES[i]));
+        add_option(IF_DESCRIPTION, INTERFACE_DESCRIPTIONS[i], std::strlen(INTERFACE_DESCRIPTIONS[i]));
+        add_option(OPT_ENDOFOPT, nullptr, 0);
+        end_block();
+        success = success && write_block();
+    }
+
+    block.swap(pending_block);
+
+    if (!success)
+        close_file();
+
+    return success;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        close_file
+// Description: Closes the current file if one is open.
+//------------------------------------------------------------------------------
+void PacketRecorder::close_file()
+{
+    if (file != nullptr)
+    {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Name:        write_block
+// Description: Writes the block bytes to the current file.
+// Returns:     True if the block was written, false otherwise.
+//------------------------------------------------------------------------------
+bool PacketRecorder::write_block()
+{
+    if (file == nullptr)
+        return false;
+    size_t written = std::fwrite(block.data(), 1, block.size(), file);
+    file_size += written;
+    return written == block.size();
+}
+
+//------------------------------------------------------------------------------
+// Name:        begin_block
+// Description: Clears the block bytes and adds the header of a block.
+//              The block length is filled in by end_block.
+// Arguments:   - type: pcapng block type
+//------------------------------------------------------------------------------
+void PacketRecorder::begin_block(uint32_t type)
+{
+    block.clear();
+    add_value<uint32_t>(type);
+    add_value<uint32_t>(0);
+}
+
+//------------------------------------------------------------------------------
+// Name:        end_block
+// Description: Adds the trailing block length and fills in the leading
+//              block length.
+//------------------------------------------------------------------------------
+void PacketRecorder::end_block()
+{
+    uint32_t length = static_cast<uint32_t>(block.size() + sizeof(uint32_t));
+    add_value<uint32_t>(length);
+    std::memcpy(block.data() + sizeof(uint32_t), &length, sizeof(length));
+}
+
+//------------------------------------------------------------------------------
+// Name:        add_bytes
+// Description: Adds bytes to the block, padded to a multiple of four
+//              bytes.
+// Arguments:   - data: pointer to the bytes
+//              - size: number of bytes
+//------------------------------------------------------------------------------
+void PacketRecorder::add_bytes(const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    if (size > 0)
+        block.insert(block.end(), bytes, bytes + size);
+    block.insert(block.end(), (4 - size % 4) % 4, 0);
+}
+
+//------------------------------------------------------------------------------
+// Name:        add_option
+// Description: Adds an option to the block.
+// Arguments:   - code: pcapng option code
+//              - data: pointer to the option value
+//              - size: number of bytes in the option value
+//------------------------------------------------------------------------------
+void PacketRecorder::add_option(uint16_t code, const void* data, size_t size)
+{
+    add_value<uint16_t>(code);
+    add_value<uint16_t>(static_cast<uint16_t>(size));
+    add_bytes(data, size);
+}
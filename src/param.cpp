@@ -47,7 +47,10 @@ int Params::size()
 //--------------------------------------------------------------------------
 void Params::append(std::string name, std::string type, QVariant value)
 {
+    int index = param_list.size();
+    emit paramsAboutToBeInserted(index, index);
     param_list.push_back({name, type, value});
+    emit paramsInserted(index, index);
 //    Task* new_task = new Task(this);
 //    task_list.append(new_task);
 //    connect(new_task, SIGNAL(taskChanged()), this, SLOT(task_changed()));
@@ -62,7 +65,25 @@ void Params::append(std::string name, std::string type, QVariant value)
 //--------------------------------------------------------------------------
 void Params::clear()
 {
+    if (param_list.isEmpty())
+        return;
+    int last = param_list.size() - 1;
+    emit paramsAboutToBeRemoved(0, last);
     param_list.clear();
+    emit paramsRemoved(0, last);
+}
+
+//--------------------------------------------------------------------------
+// Name:        remove
+// Description: Removes the parameter at the specified index from the
+//              parameter list.
+// Arguments:   - index: index of the parameter to remove
+//--------------------------------------------------------------------------
+void Params::remove(int index)
+{
+    emit paramsAboutToBeRemoved(index, index);
+    param_list.remove(index);
+    emit paramsRemoved(index, index);
 }
 
 //--------------------------------------------------------------------------
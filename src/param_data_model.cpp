@@ -113,6 +113,55 @@ QHash<int, QByteArray> ParamDataModel::roleNames() const
     return { {Qt::DisplayRole, "display"} };
 }
 
+//------------------------------------------------------------------------------
+// Name:        set_params
+// Description: Sets the parameter list that should be displayed.
+// Arguments:   - params: pointer to the parameter list to display
+//------------------------------------------------------------------------------
+void ParamDataModel::set_params(Params* params)
+{
+
+    beginResetModel();
+
+    if (current_params != nullptr)
+        disconnect(current_params, nullptr, this, nullptr);
+    current_params = params;
+
+    // Forward each change to the list as a change to only the rows it
+    // affects, so that parameters are added as they are received
+    if (current_params != nullptr)
+    {
+
+        connect(current_params, &Params::paramsAboutToBeInserted, this,
+                [this](int first, int last)
+        {
+            beginInsertRows(QModelIndex(), first, last);
+        });
+        connect(current_params, &Params::paramsInserted, this, [this]()
+        {
+            endInsertRows();
+        });
+
+        connect(current_params, &Params::paramsAboutToBeRemoved, this,
+                [this](int first, int last)
+        {
+            beginRemoveRows(QModelIndex(), first, last);
+        });
+
+        // Rows after the removed ones are renumbered
+        connect(current_params, &Params::paramsRemoved, this, [this](int first, int)
+        {
+            endRemoveRows();
+            if (first < rowCount())
+                emit dataChanged(index(first, 0), index(rowCount() - 1, 0));
+        });
+
+    }
+
+    endResetModel();
+
+}
+
 //------------------------------------------------------------------------------
 // Name:        redraw
 // Description: Redraws the mission data model.
@@ -220,9 +269,7 @@ int ParamDataModel::get_selected_task_index()
 //------------------------------------------------------------------------------
 void ParamDataModel::clear_params()
 {
-    beginResetModel();
     current_params->clear();
-    endResetModel();
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,238 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Compact history of a vehicle's locations, stored as a struct
+//              of fixed point arrays in a ring buffer.
+//==============================================================================
+
+#include "path_history.h"
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+constexpr double PathHistory::DEGREES_SCALE;
+constexpr double PathHistory::MILLISECONDS_SCALE;
+constexpr double PathHistory::YAW_SCALE;
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        PathHistory constructor
+// Description: Constructs an empty history. Throws a std::runtime_error if
+//              the capacity is zero.
+// Arguments:   - capacity: maximum number of samples stored
+//------------------------------------------------------------------------------
+PathHistory::PathHistory(size_t capacity) : max_samples(capacity)
+{
+    if (capacity == 0)
+        throw std::runtime_error("PathHistory: capacity must be non-zero");
+}
+
+//------------------------------------------------------------------------------
+// Name:        PathHistory destructor
+// Description: Default destructor.
+//------------------------------------------------------------------------------
+PathHistory::~PathHistory()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        append
+// Description: Appends a sample, overwriting the oldest sample if the
+//              history is full. A timestamp older than the newest
+//              sample is replaced with the newest sample's.
+// Arguments:   - time: sample time in seconds
+//              - lat: latitude in degrees
+//              - lon: longitude in degrees
+//              - yaw: yaw in degrees
+//              - depth: depth in meters
+//------------------------------------------------------------------------------
+void PathHistory::append(double time, double lat, double lon, double yaw, double depth)
+{
+
+    // Times are stored relative to the first sample so that they fit in
+    // 32 bits, and are kept from decreasing
+    if (end_index == 0)
+        time_origin = time;
+    double milliseconds = (time - time_origin) * MILLISECONDS_SCALE;
+    if (!(milliseconds >= 0.0))
+        milliseconds = 0.0;
+    milliseconds = std::min(milliseconds, static_cast<double>(UINT32_MAX));
+    uint32_t stored_time = std::max(static_cast<uint32_t>(std::lround(milliseconds)), last_time);
+    last_time = stored_time;
+
+    // Yaw is wrapped into [0, 360) so that it fits an unsigned 16 bits
+    double wrapped_yaw = std::fmod(yaw, 360.0);
+    if (wrapped_yaw < 0.0)
+        wrapped_yaw += 360.0;
+    uint16_t stored_yaw = static_cast<uint16_t>(
+        std::min(std::lround(wrapped_yaw * YAW_SCALE), 35999L));
+
+    int32_t stored_lat = static_cast<int32_t>(std::lround(lat * DEGREES_SCALE));
+    int32_t stored_lon = static_cast<int32_t>(std::lround(lon * DEGREES_SCALE));
+
+    // The buffers grow until they reach the capacity, after which the slot
+    // of the oldest sample is reused by moving the head
+    if (count < max_samples)
+    {
+        lats.push_back(stored_lat);
+        lons.push_back(stored_lon);
+        times.push_back(stored_time);
+        yaws.push_back(stored_yaw);
+        depths.push_back(static_cast<float>(depth));
+        count++;
+    }
+    else
+    {
+        size_t slot = head;
+        head = (head + 1) % max_samples;
+        lats[slot] = stored_lat;
+        lons[slot] = stored_lon;
+        times[slot] = stored_time;
+        yaws[slot] = stored_yaw;
+        depths[slot] = static_cast<float>(depth);
+    }
+
+    end_index++;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        clear
+// Description: Removes all samples and releases their storage.
+//------------------------------------------------------------------------------
+void PathHistory::clear()
+{
+
+    head = 0;
+    count = 0;
+    end_index = 0;
+    last_time = 0;
+
+    std::vector<int32_t>().swap(lats);
+    std::vector<int32_t>().swap(lons);
+    std::vector<uint32_t>().swap(times);
+    std::vector<uint16_t>().swap(yaws);
+    std::vector<float>().swap(depths);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        size
+// Description: Gets the number of stored samples.
+// Returns:     Number of stored samples.
+//------------------------------------------------------------------------------
+size_t PathHistory::size() const
+{
+    return count;
+}
+
+//------------------------------------------------------------------------------
+// Name:        capacity
+// Description: Gets the maximum number of samples that can be stored.
+// Returns:     History capacity in samples.
+//------------------------------------------------------------------------------
+size_t PathHistory::capacity() const
+{
+    return max_samples;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_first_index
+// Description: Gets the sequence index of the oldest stored sample.
+// Returns:     Sequence index of the oldest sample.
+//------------------------------------------------------------------------------
+uint64_t PathHistory::get_first_index() const
+{
+    return end_index - count;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_end_index
+// Description: Gets the sequence index that the next sample will have,
+//              which is one past the newest stored sample.
+// Returns:     Sequence index of the next sample.
+//------------------------------------------------------------------------------
+uint64_t PathHistory::get_end_index() const
+{
+    return end_index;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_time
+// Description: Gets the time of a sample. Throws a std::runtime_error if
+//              the sample is not stored.
+// Arguments:   - index: sequence index of the sample
+// Returns:     Sample time in seconds.
+//------------------------------------------------------------------------------
+double PathHistory::get_time(uint64_t index) const
+{
+    return time_origin + times[get_slot(index)] / MILLISECONDS_SCALE;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_lat
+// Description: Gets the latitude of a sample. Throws a std::runtime_error
+//              if the sample is not stored.
+// Arguments:   - index: sequence index of the sample
+// Returns:     Latitude in degrees.
+//------------------------------------------------------------------------------
+double PathHistory::get_lat(uint64_t index) const
+{
+    return lats[get_slot(index)] / DEGREES_SCALE;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_lon
+// Description: Gets the longitude of a sample. Throws a std::runtime_error
+//              if the sample is not stored.
+// Arguments:   - index: sequence index of the sample
+// Returns:     Longitude in degrees.
+//------------------------------------------------------------------------------
+double PathHistory::get_lon(uint64_t index) const
+{
+    return lons[get_slot(index)] / DEGREES_SCALE;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_yaw
+// Description: Gets the yaw of a sample. Throws a std::runtime_error if
+//              the sample is not stored.
+// Arguments:   - index: sequence index of the sample
+// Returns:     Yaw in degrees in [0, 360).
+//------------------------------------------------------------------------------
+double PathHistory::get_yaw(uint64_t index) const
+{
+    return yaws[get_slot(index)] / YAW_SCALE;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_depth
+// Description: Gets the depth of a sample. Throws a std::runtime_error if
+//              the sample is not stored.
+// Arguments:   - index: sequence index of the sample
+// Returns:     Depth in meters.
+//------------------------------------------------------------------------------
+double PathHistory::get_depth(uint64_t index) const
+{
+    return depths[get_slot(index)];
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_slot
+// Description: Converts a sequence index to a ring buffer slot. Throws a
+//              std::runtime_error if the sample is not stored.
+// Arguments:   - index: sequence index of the sample
+// Returns:     Ring buffer slot.
+//------------------------------------------------------------------------------
+size_t PathHistory::get_slot(uint64_t index) const
+{
+    if (index < get_first_index() || index >= end_index)
+        throw std::runtime_error("PathHistory: sample index out of range");
+    return (head + static_cast<size_t>(index - get_first_index())) % max_samples;
+}
@@ -7,6 +7,9 @@
 
 #include "points_data_model.h"
 
+// C++ includes
+#include <algorithm>
+
 //==============================================================================
 //                              CLASS DEFINITION
 //==============================================================================
@@ -28,7 +31,7 @@ int PointsDataModel::rowCount(const QModelIndex&) const
 {
     // The number of rows is the number of points in the task
     if (task != nullptr)
-        return task->get_points().size();
+        return task->get_num_points();
     else
         return 0;
 }
@@ -56,19 +59,19 @@ QVariant PointsDataModel::data(const QModelIndex &index, int role) const
         case Qt::DisplayRole:
         {
 
-            if (task != nullptr && task->get_points().size() > 0)
+            if (task != nullptr && index.row() >= 0 && index.row() < task->get_num_points())
             {
 
-                // Get the list of points in the task
-                QVector<std::pair<QPointF, ActionType::Value>> points = task->get_points();
-
+                // Read the point's values in place rather than copying the
+                // task's points for every cell
+                size_t row = static_cast<size_t>(index.row());
                 switch (index.column())
                 {
                     case 0: return index.row();
-                    case 1: return QString::number(points.at(index.row()).first.y(), 'f', 6);
-                    case 2: return QString::number(points.at(index.row()).first.x(), 'f', 6);
+                    case 1: return QString::number(task->get_lats()[row], 'f', 6);
+                    case 2: return QString::number(task->get_lons()[row], 'f', 6);
                     case 3: return 0;
-                    case 4: return QVariant::fromValue(QString::fromStdString(ActionType::to_string(points.at(index.row()).second)));
+                    case 4: return QVariant::fromValue(QString::fromStdString(ActionType::to_string(task->get_commands()[row])));
                 }
             }
 
@@ -129,8 +132,73 @@ QHash<int, QByteArray> PointsDataModel::roleNames() const
 //------------------------------------------------------------------------------
 void PointsDataModel::set_task(Task* task_ptr)
 {
+
+    beginResetModel();
+
+    if (task != nullptr)
+        disconnect(task, nullptr, this, nullptr);
     task = task_ptr;
-    redraw();
+
+    // Forward each change to the task's points as a change to only the rows
+    // it affects, so that the view keeps the delegates of the other rows
+    if (task != nullptr)
+    {
+
+        connect(task, &Task::pointsAboutToBeInserted, this, [this](int first, int last)
+        {
+            beginInsertRows(QModelIndex(), first, last);
+        });
+        connect(task, &Task::pointsInserted, this, [this](int first, int)
+        {
+            endInsertRows();
+            number_rows(first);
+            emit pointsChanged();
+        });
+
+        connect(task, &Task::pointsAboutToBeRemoved, this, [this](int first, int last)
+        {
+            beginRemoveRows(QModelIndex(), first, last);
+        });
+        connect(task, &Task::pointsRemoved, this, [this](int first, int)
+        {
+            endRemoveRows();
+            number_rows(first);
+            emit pointsChanged();
+        });
+
+        // A row moving down is inserted before the row after its new index
+        connect(task, &Task::pointAboutToBeMoved, this, [this](int from, int to)
+        {
+            beginMoveRows(QModelIndex(), from, from, QModelIndex(), to > from ? to + 1 : to);
+        });
+        connect(task, &Task::pointMoved, this, [this](int from, int to)
+        {
+            endMoveRows();
+            number_rows(std::min(from, to), std::max(from, to));
+            emit pointsChanged();
+        });
+
+        connect(task, &Task::pointsAboutToBeReset, this, [this]()
+        {
+            beginResetModel();
+        });
+        connect(task, &Task::pointsReset, this, [this]()
+        {
+            endResetModel();
+            emit pointsChanged();
+        });
+
+        connect(task, &Task::pointChanged, this, [this](int index)
+        {
+            emit dataChanged(this->index(index, 0), this->index(index, columnCount() - 1));
+            emit pointsChanged();
+        });
+
+    }
+
+    endResetModel();
+    emit pointsChanged();
+
 }
 
 //------------------------------------------------------------------------------
@@ -152,12 +220,7 @@ void PointsDataModel::redraw()
 void PointsDataModel::move_point_up(const int row)
 {
     if (row > 0)
-    {
-        beginResetModel();
         task->move_point_up(row);
-        endResetModel();
-        emit pointsChanged();
-    }
 }
 
 //------------------------------------------------------------------------------
@@ -168,12 +231,7 @@ void PointsDataModel::move_point_up(const int row)
 void PointsDataModel::move_point_down(const int row)
 {
     if (row < rowCount() - 1)
-    {
-        beginResetModel();
         task->move_point_down(row);
-        endResetModel();
-        emit pointsChanged();
-    }
 }
 
 //------------------------------------------------------------------------------
@@ -183,10 +241,7 @@ void PointsDataModel::move_point_down(const int row)
 //------------------------------------------------------------------------------
 void PointsDataModel::delete_point(const int row)
 {
-    beginResetModel();
     task->remove_point(row);
-    endResetModel();
-    emit pointsChanged();
 }
 
 //------------------------------------------------------------------------------
@@ -195,10 +250,7 @@ void PointsDataModel::delete_point(const int row)
 //------------------------------------------------------------------------------
 void PointsDataModel::clear_points()
 {
-    beginResetModel();
     task->clear_points();
-    endResetModel();
-    emit pointsChanged();
 }
 
 //------------------------------------------------------------------------------
@@ -224,10 +276,6 @@ void PointsDataModel::edit_point(const int row, const int column, const QVariant
             case 4:  task->set_point_command(row, ActionType::from_string(value.toString())); break;
         }
 
-        emit dataChanged(this->index(row, column),
-                         this->index(row, column));
-        emit pointsChanged();
-
     }
 
 }
@@ -249,14 +297,10 @@ void PointsDataModel::reset_value(const int row, const int column)
         {
             // case 0: task number
             case 1:  task->set_point_lat(row, std::nan("")); break;
-            case 2:  task->set_point_lat(row, std::nan("")); break;
+            case 2:  task->set_point_lon(row, std::nan("")); break;
             case 4:  task->set_point_command(row, ActionType::ACTION_NO_ACTION);
         }
 
-        emit dataChanged(this->index(row, column),
-                         this->index(row, column));
-
-        emit pointsChanged();
     }
 
 }
@@ -272,9 +316,6 @@ void PointsDataModel::append_point(double lat, double lon)
     if(!task)
         return;
     task->add_point(QPointF(lon, lat));
-    emit dataChanged(this->index(rowCount(), 4),
-                     this->index(rowCount(), 4));
-    emit pointsChanged();
 }
 
 
@@ -289,8 +330,22 @@ void PointsDataModel::append_point(double lat, double lon, ActionType::Value com
 {
     if(!task)
         return;
-    task->add_point(QPointF(lat, lon), command);
-    emit dataChanged(this->index((rowCount()), 4),
-                     this->index(rowCount(), 4));
-    emit pointsChanged();
+    task->add_point(QPointF(lon, lat), command);
+}
+
+//------------------------------------------------------------------------------
+// Name:        number_rows
+// Description: Updates the point number column of a range of rows, whose
+//              numbers change when rows are inserted, removed or moved
+//              before them.
+// Arguments:   - first: first row whose number changed
+//              - last: last row whose number changed, or -1 for the last
+//                row in the table
+//------------------------------------------------------------------------------
+void PointsDataModel::number_rows(int first, int last)
+{
+    if (last < 0 || last >= rowCount())
+        last = rowCount() - 1;
+    if (first <= last)
+        emit dataChanged(this->index(first, 0), this->index(last, 0));
 }
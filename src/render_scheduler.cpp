@@ -0,0 +1,199 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Schedules display updates at a fixed frame rate instead of on
+//              every received packet, merging the updates to each vehicle
+//              between frames and spending at most an adaptive time budget
+//              on each frame.
+//==============================================================================
+
+#include "render_scheduler.h"
+
+// C++ includes
+#include <algorithm>
+
+const int RenderScheduler::MIN_FRAME_RATE;
+const int RenderScheduler::MAX_FRAME_RATE;
+const int RenderScheduler::DEFAULT_FRAME_RATE;
+constexpr double RenderScheduler::MAX_BUDGET_FRACTION;
+constexpr double RenderScheduler::MIN_BUDGET_MS;
+constexpr double RenderScheduler::LATE_FRAME_FACTOR;
+constexpr double RenderScheduler::BUDGET_INCREASE_MS;
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        RenderScheduler constructor
+// Description: Constructs the scheduler at the default frame rate with
+//              nothing to redraw.
+// Arguments:   - parent: parent QObject
+//------------------------------------------------------------------------------
+RenderScheduler::RenderScheduler(QObject* parent) : QObject(parent)
+{
+
+    frame_timer = new QTimer(this);
+    frame_timer->setTimerType(Qt::PreciseTimer);
+    frame_timer->setInterval(static_cast<int>(get_frame_period()));
+    connect(frame_timer, &QTimer::timeout, this, &RenderScheduler::frame_timer_timeout);
+
+    budget = get_frame_period() * MAX_BUDGET_FRACTION;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        RenderScheduler destructor
+// Description: Default destructor.
+//------------------------------------------------------------------------------
+RenderScheduler::~RenderScheduler()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        mark_dirty
+// Description: Records that part of a vehicle's display is out of date.
+//              The vehicle is redrawn on one of the following frames.
+// Arguments:   - vehicle_id: ID of the vehicle
+//              - flags: bitwise OR of dirty flags
+//------------------------------------------------------------------------------
+void RenderScheduler::mark_dirty(int vehicle_id, int flags)
+{
+
+    auto it = dirty_flags.find(vehicle_id);
+    if (it != dirty_flags.end())
+    {
+        it.value() |= flags;
+        return;
+    }
+
+    dirty_flags.insert(vehicle_id, flags);
+    dirty_order.push_back(vehicle_id);
+
+    // The frame interval of the first frame after the timer starts is
+    // measured from the start
+    if (!frame_timer->isActive())
+    {
+        frame_timer->start();
+        frame_interval_timer.start();
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        flush
+// Description: Redraws every dirty vehicle now, ignoring the budget.
+//------------------------------------------------------------------------------
+void RenderScheduler::flush()
+{
+    while (!dirty_order.empty())
+        render_next();
+    frame_timer->stop();
+}
+
+//------------------------------------------------------------------------------
+// Name:        set_frame_rate
+// Description: Sets the frame rate, limited to the supported range.
+// Arguments:   - frame_rate: frame rate in Hz
+//------------------------------------------------------------------------------
+void RenderScheduler::set_frame_rate(int frame_rate)
+{
+
+    if (frame_rate < MIN_FRAME_RATE)
+        frame_rate = MIN_FRAME_RATE;
+    if (frame_rate > MAX_FRAME_RATE)
+        frame_rate = MAX_FRAME_RATE;
+
+    this->frame_rate = frame_rate;
+    frame_timer->setInterval(static_cast<int>(get_frame_period()));
+    budget = std::min(budget, get_frame_period() * MAX_BUDGET_FRACTION);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_frame_rate
+// Description: Gets the frame rate.
+// Returns:     Frame rate in Hz.
+//------------------------------------------------------------------------------
+int RenderScheduler::get_frame_rate() const
+{
+    return frame_rate;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_budget
+// Description: Gets the current redraw time budget of a frame.
+// Returns:     Budget in milliseconds.
+//------------------------------------------------------------------------------
+double RenderScheduler::get_budget() const
+{
+    return budget;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_frame_period
+// Description: Gets the frame period.
+// Returns:     Frame period in milliseconds.
+//------------------------------------------------------------------------------
+double RenderScheduler::get_frame_period() const
+{
+    return 1000.0 / frame_rate;
+}
+
+//------------------------------------------------------------------------------
+// Name:        render_next
+// Description: Redraws the dirty vehicle that has waited the longest.
+//------------------------------------------------------------------------------
+void RenderScheduler::render_next()
+{
+
+    // The flags are taken before the signal is emitted, so that anything
+    // marked dirty while redrawing is redrawn on a later frame
+    int vehicle_id = dirty_order.front();
+    dirty_order.pop_front();
+    int flags = dirty_flags.take(vehicle_id);
+
+    emit renderRequested(vehicle_id, flags);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        frame_timer_timeout
+// Description: Slot that is called on each frame. Adapts the budget to
+//              the frame interval and redraws dirty vehicles until the
+//              budget is spent.
+//------------------------------------------------------------------------------
+void RenderScheduler::frame_timer_timeout()
+{
+
+    if (dirty_order.empty())
+    {
+        frame_timer->stop();
+        return;
+    }
+
+    // A late frame means the event loop is overloaded, so the budget is
+    // halved to give it time back. It then grows back slowly while frames
+    // are on time
+    double frame_period = get_frame_period();
+    double frame_interval = frame_interval_timer.restart();
+    if (frame_interval > frame_period * LATE_FRAME_FACTOR)
+        budget = std::max(budget / 2.0, MIN_BUDGET_MS);
+    else
+        budget = std::min(budget + BUDGET_INCREASE_MS, frame_period * MAX_BUDGET_FRACTION);
+
+    // At least one vehicle is redrawn on every frame so that every vehicle
+    // is eventually redrawn however small the budget gets
+    QElapsedTimer render_timer;
+    render_timer.start();
+    do
+    {
+        render_next();
+    }
+    while (!dirty_order.empty() && render_timer.nsecsElapsed() / 1.0e6 < budget);
+
+    if (dirty_order.empty())
+        frame_timer->stop();
+
+}
@@ -0,0 +1,283 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Replays recorded vehicle traffic into the vehicle manager as
+//              if the vehicles were live. Recorded UDP datagrams go through
+//              the same parsing as live status datagrams and recorded TCP
+//              data through the same parsing as live vehicle connection
+//              data, so a replay exercises the whole path from ingest to
+//              rendering.
+//==============================================================================
+
+#include "replay_engine.h"
+
+// File URL handling
+#include <QUrl>
+
+// C++ includes
+#include <algorithm>
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        ReplayEngine constructor
+// Description: Constructs a replay engine that replays into a vehicle
+//              manager.
+// Arguments:   - vehicle_manager: pointer to the vehicle manager
+//              - parent: parent QObject
+//------------------------------------------------------------------------------
+ReplayEngine::ReplayEngine(VehicleManager* vehicle_manager, QObject* parent) :
+    QObject(parent), vehicle_manager(vehicle_manager)
+{
+    connect(&replay_timer, &QTimer::timeout, this, &ReplayEngine::replay_timer_timeout);
+}
+
+//------------------------------------------------------------------------------
+// Name:        ReplayEngine destructor
+// Description: Default destructor.
+//------------------------------------------------------------------------------
+ReplayEngine::~ReplayEngine()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        load
+// Description: Stops any replay and loads a replay file. Files with the
+//              .pcapng extension are loaded as packet captures and any
+//              other file as an AVL text log.
+// Arguments:   - file_path: path or file URL of the replay file
+//              - vehicle_id: vehicle ID given to statuses from an AVL
+//                text log, which does not contain one
+// Returns:     True if the file was loaded, false otherwise.
+//------------------------------------------------------------------------------
+bool ReplayEngine::load(QString file_path, int vehicle_id)
+{
+
+    pause();
+
+    // QML file dialogs give file URLs rather than paths
+    if (file_path.startsWith("file:"))
+        file_path = QUrl(file_path).toLocalFile();
+
+    try
+    {
+        if (file_path.endsWith(".pcapng", Qt::CaseInsensitive))
+            replay_log.load_pcapng(file_path.toStdString());
+        else
+            replay_log.load_avl_log(file_path.toStdString(), vehicle_id);
+    }
+    catch (const std::exception& ex)
+    {
+        qDebug() << "ReplayEngine: failed to load replay (" << ex.what() << ")";
+        replay_log.clear();
+        seek(0.0);
+        return false;
+    }
+
+    seek(0.0);
+    emit replayLoaded(get_duration(), static_cast<int>(replay_log.size()));
+    return true;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        play
+// Description: Starts or resumes replay from the current position. Does
+//              nothing if there is nothing left to replay.
+//------------------------------------------------------------------------------
+void ReplayEngine::play()
+{
+
+    if (replay_timer.isActive() || next_event >= replay_log.size())
+        return;
+
+    anchor_clock();
+    replay_timer.start(speed == SPEED_UNLIMITED ? 0 : TICK_INTERVAL_MS);
+    emit playingChanged(true);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        pause
+// Description: Pauses replay at the current position.
+//------------------------------------------------------------------------------
+void ReplayEngine::pause()
+{
+    if (!replay_timer.isActive())
+        return;
+    replay_timer.stop();
+    emit playingChanged(false);
+}
+
+//------------------------------------------------------------------------------
+// Name:        stop
+// Description: Stops replay and moves back to the start of the replay.
+//------------------------------------------------------------------------------
+void ReplayEngine::stop()
+{
+    pause();
+    seek(0.0);
+}
+
+//------------------------------------------------------------------------------
+// Name:        seek
+// Description: Moves the replay position. Events before the new position
+//              are skipped, and replay continues from the first event at
+//              or after it.
+// Arguments:   - position: seconds from the start of the replay
+//------------------------------------------------------------------------------
+void ReplayEngine::seek(double position)
+{
+
+    this->position = std::max(0.0, std::min(position, get_duration()));
+    next_event = replay_log.find_event(replay_log.get_start_time() + this->position);
+    anchor_clock();
+
+    emit positionChanged(this->position);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        set_speed
+// Description: Sets the replay speed as a multiple of real time.
+// Arguments:   - speed: speed multiplier, or SPEED_UNLIMITED to replay
+//                as fast as possible
+//------------------------------------------------------------------------------
+void ReplayEngine::set_speed(double speed)
+{
+
+    this->speed = std::max(0.0, speed);
+    anchor_clock();
+
+    if (replay_timer.isActive())
+        replay_timer.setInterval(this->speed == SPEED_UNLIMITED ? 0 : TICK_INTERVAL_MS);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_speed
+// Description: Gets the replay speed.
+// Returns:     Speed multiplier, or SPEED_UNLIMITED.
+//------------------------------------------------------------------------------
+double ReplayEngine::get_speed()
+{
+    return speed;
+}
+
+//------------------------------------------------------------------------------
+// Name:        is_playing
+// Description: Checks whether replay is playing.
+// Returns:     True if replay is playing, false otherwise.
+//------------------------------------------------------------------------------
+bool ReplayEngine::is_playing()
+{
+    return replay_timer.isActive();
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_position
+// Description: Gets the replay position.
+// Returns:     Seconds from the start of the replay.
+//------------------------------------------------------------------------------
+double ReplayEngine::get_position()
+{
+    return position;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_duration
+// Description: Gets the replay duration.
+// Returns:     Seconds from the first to the last event.
+//------------------------------------------------------------------------------
+double ReplayEngine::get_duration()
+{
+    return replay_log.get_duration();
+}
+
+//------------------------------------------------------------------------------
+// Name:        replay_timer_timeout
+// Description: Slot that is called on each replay timer tick. Replays the
+//              events up to the current replay time.
+//------------------------------------------------------------------------------
+void ReplayEngine::replay_timer_timeout()
+{
+
+    // At unlimited speed every event is due. Otherwise the events up to the
+    // time elapsed since the clock was anchored, scaled by the speed, are due
+    double start_time = replay_log.get_start_time();
+    double target_position = get_duration();
+    if (speed != SPEED_UNLIMITED)
+        target_position = anchor_position + anchor_timer.nsecsElapsed() / 1e9 * speed;
+
+    size_t num_replayed = 0;
+    while (next_event < replay_log.size() && num_replayed < MAX_EVENTS_PER_TICK)
+    {
+        const ReplayLog::Event& event = replay_log.get_event(next_event);
+        if (event.time - start_time > target_position)
+            break;
+        replay_event(event);
+        next_event++;
+        num_replayed++;
+    }
+
+    // If the tick limit was reached, replay has fallen behind the requested
+    // speed. The position stays at the last replayed event and the clock is
+    // re-anchored there, so replay runs as fast as the ingest path allows
+    // instead of trying to catch up in one long tick
+    if (num_replayed == MAX_EVENTS_PER_TICK && next_event < replay_log.size())
+    {
+        position = replay_log.get_event(next_event - 1).time - start_time;
+        anchor_clock();
+    }
+    else
+    {
+        position = std::min(target_position, get_duration());
+    }
+
+    emit positionChanged(position);
+
+    if (next_event >= replay_log.size())
+    {
+        pause();
+        emit replayFinished();
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        anchor_clock
+// Description: Restarts the replay clock from the current position, so
+//              that speed changes and seeks take effect from now.
+//------------------------------------------------------------------------------
+void ReplayEngine::anchor_clock()
+{
+    anchor_position = position;
+    anchor_timer.start();
+}
+
+//------------------------------------------------------------------------------
+// Name:        replay_event
+// Description: Feeds an event into the vehicle manager.
+// Arguments:   - event: event to replay
+//------------------------------------------------------------------------------
+void ReplayEngine::replay_event(const ReplayLog::Event& event)
+{
+
+    QByteArray data(reinterpret_cast<const char*>(event.data.data()),
+                    static_cast<int>(event.data.size()));
+    QString ip_address = QHostAddress(event.peer_address).toString();
+
+    switch (event.interface)
+    {
+        case PacketRecorder::INTERFACE_TCP:
+            vehicle_manager->process_tcp_data(ip_address, data);
+            break;
+        default:
+            vehicle_manager->process_udp_datagram(data, ip_address, true);
+            break;
+    }
+
+}
@@ -0,0 +1,676 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Recorded vehicle traffic loaded for replay. Traffic can be
+//              loaded from a pcapng capture, either written by the packet
+//              recorder or captured with Wireshark on an Ethernet interface,
+//              or from an AVL text log, whose status data lines are turned
+//              back into STATUS packets.
+//==============================================================================
+
+#include "replay_log.h"
+
+// Vehicle command packets
+#include "comms/avl_commands.h"
+
+// Angle unit conversion
+#include "util/geo.h"
+
+// C++ includes
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+//==============================================================================
+//                                  CONSTANTS
+//==============================================================================
+
+// pcapng block types
+static const uint32_t SECTION_HEADER_BLOCK = 0x0A0D0D0A;
+static const uint32_t INTERFACE_DESCRIPTION_BLOCK = 0x00000001;
+static const uint32_t ENHANCED_PACKET_BLOCK = 0x00000006;
+
+// pcapng byte order magic as read in host byte order, and as read from a
+// file written with the other byte order
+static const uint32_t BYTE_ORDER_MAGIC = 0x1A2B3C4D;
+static const uint32_t BYTE_ORDER_MAGIC_SWAPPED = 0x4D3C2B1A;
+
+// pcapng option codes
+static const uint16_t OPT_ENDOFOPT = 0;
+static const uint16_t OPT_COMMENT = 1;
+static const uint16_t IF_NAME = 2;
+static const uint16_t IF_TSRESOL = 9;
+static const uint16_t EPB_FLAGS = 2;
+
+// epb_flags direction mask and outbound value
+static const uint32_t EPB_FLAGS_DIRECTION_MASK = 0x3;
+static const uint32_t EPB_FLAGS_OUTBOUND = 0x2;
+
+// Link types
+static const uint16_t LINKTYPE_ETHERNET = 1;
+static const uint16_t LINKTYPE_USER0 = 147;
+
+// Name of the packet recorder's TCP interface
+static const char* TCP_INTERFACE_NAME = "avl-tcp";
+
+// Ethernet, IPv4 and UDP header values
+static const size_t ETHERNET_HEADER_SIZE = 14;
+static const uint16_t ETHERTYPE_IPV4 = 0x0800;
+static const uint16_t ETHERTYPE_VLAN = 0x8100;
+static const uint8_t IP_PROTOCOL_UDP = 17;
+static const size_t UDP_HEADER_SIZE = 8;
+
+// Status values that can be read from AVL log data lines
+enum LogValue
+{
+    LOG_LAT,
+    LOG_LON,
+    LOG_ALT,
+    LOG_ROLL,
+    LOG_PITCH,
+    LOG_YAW,
+    LOG_VX,
+    LOG_VY,
+    LOG_VZ,
+    LOG_DEPTH,
+    LOG_HEIGHT,
+    LOG_RPM,
+    LOG_VOLTAGE,
+    LOG_SATS,
+    NUM_LOG_VALUES
+};
+
+// Space separated labels that each status value may be logged under
+static const char* LOG_VALUE_LABELS[NUM_LOG_VALUES] =
+{
+    "lat latitude",
+    "lon lng longitude",
+    "alt altitude",
+    "roll",
+    "pitch",
+    "yaw heading",
+    "vx vn",
+    "vy ve",
+    "vz vd",
+    "depth",
+    "height",
+    "rpm",
+    "voltage",
+    "sats num_sats gps_sats"
+};
+
+// Whether each status value is an angle, converted to degrees if it is
+// logged in radians
+static const bool LOG_VALUE_IS_ANGLE[NUM_LOG_VALUES] =
+{
+    true, true, false, true, true, true, false, false, false,
+    false, false, false, false, false
+};
+
+//==============================================================================
+//                              HELPER FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        read_value
+// Description: Reads a value in host byte order from a byte array.
+// Arguments:   - bytes: pointer to the value's first byte
+// Returns:     Value read from the bytes.
+//------------------------------------------------------------------------------
+template <typename T>
+static T read_value(const uint8_t* bytes)
+{
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+//------------------------------------------------------------------------------
+// Name:        read_big_endian
+// Description: Reads a 16 bit value in network byte order.
+// Arguments:   - bytes: pointer to the value's first byte
+// Returns:     Value read from the bytes.
+//------------------------------------------------------------------------------
+static uint16_t read_big_endian(const uint8_t* bytes)
+{
+    return static_cast<uint16_t>((bytes[0] << 8) | bytes[1]);
+}
+
+//------------------------------------------------------------------------------
+// Name:        to_lower
+// Description: Converts a string to lower case.
+// Arguments:   - str: string to convert
+// Returns:     Lower case string.
+//------------------------------------------------------------------------------
+static std::string to_lower(std::string str)
+{
+    for (char& c : str)
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return str;
+}
+
+//------------------------------------------------------------------------------
+// Name:        split_spaces
+// Description: Splits a string into the words separated by spaces.
+// Arguments:   - str: string to split
+// Returns:     Vector of words.
+//------------------------------------------------------------------------------
+static std::vector<std::string> split_spaces(const std::string& str)
+{
+    std::istringstream stream(str);
+    return std::vector<std::string>(std::istream_iterator<std::string>(stream),
+                                    std::istream_iterator<std::string>());
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_log_value
+// Description: Gets the status value logged under a label.
+// Arguments:   - label: data label
+// Returns:     Status value, or NUM_LOG_VALUES if the label is not a status
+//              value.
+//------------------------------------------------------------------------------
+static int get_log_value(const std::string& label)
+{
+    std::string lower_label = to_lower(label);
+    for (int i = 0; i < NUM_LOG_VALUES; i++)
+    {
+        std::vector<std::string> aliases = split_spaces(LOG_VALUE_LABELS[i]);
+        if (std::find(aliases.begin(), aliases.end(), lower_label) != aliases.end())
+            return i;
+    }
+    return NUM_LOG_VALUES;
+}
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        ReplayLog constructor
+// Description: Constructs an empty replay log.
+//------------------------------------------------------------------------------
+ReplayLog::ReplayLog()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        ReplayLog destructor
+// Description: Default destructor.
+//------------------------------------------------------------------------------
+ReplayLog::~ReplayLog()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        load_pcapng
+// Description: Replaces the events with the received traffic in a pcapng
+//              file. Packet recorder captures are replayed on the
+//              interface they were recorded on. Ethernet captures are
+//              searched for IPv4 UDP datagrams sent to the status port.
+//              Packets on other link types are skipped. Throws a
+//              std::runtime_error if the file cannot be read or is not a
+//              valid pcapng file.
+// Arguments:   - file_path: path to the pcapng file
+//------------------------------------------------------------------------------
+void ReplayLog::load_pcapng(const std::string& file_path)
+{
+
+    std::vector<uint8_t> bytes = read_file(file_path);
+
+    // Interface link types, replay interfaces and timestamp units per
+    // second, indexed by interface ID within the current section
+    struct Interface
+    {
+        uint16_t link_type;
+        PacketRecorder::Interface interface;
+        double units_per_second;
+    };
+    std::vector<Interface> interfaces;
+
+    std::vector<Event> loaded_events;
+    bool has_section = false;
+
+    size_t offset = 0;
+    while (offset + 12 <= bytes.size())
+    {
+
+        const uint8_t* block = bytes.data() + offset;
+        uint32_t type = read_value<uint32_t>(block);
+        uint32_t length = read_value<uint32_t>(block + 4);
+
+        // A section header is needed before the length can be trusted,
+        // since the byte order is only known from the section header
+        if (type == SECTION_HEADER_BLOCK)
+        {
+            uint32_t magic = read_value<uint32_t>(block + 8);
+            if (magic == BYTE_ORDER_MAGIC_SWAPPED)
+                throw std::runtime_error("load_pcapng: captures written with the other byte order are not supported");
+            if (magic != BYTE_ORDER_MAGIC)
+                throw std::runtime_error("load_pcapng: invalid section header in " + file_path);
+            has_section = true;
+            interfaces.clear();
+        }
+        else if (!has_section)
+        {
+            throw std::runtime_error("load_pcapng: " + file_path + " is not a pcapng file");
+        }
+
+        if (length < 12 || length % 4 != 0 || offset + length > bytes.size())
+            throw std::runtime_error("load_pcapng: invalid block length in " + file_path);
+
+        // Options start after the fixed fields of the block
+        size_t options_offset = 0;
+
+        if (type == INTERFACE_DESCRIPTION_BLOCK && length >= 20)
+        {
+            Interface interface;
+            interface.link_type = read_value<uint16_t>(block + 8);
+            interface.interface = PacketRecorder::INTERFACE_UDP;
+            interface.units_per_second = 1e6;
+            options_offset = 16;
+
+            for (size_t i = options_offset; i + 4 <= length - 4; )
+            {
+                uint16_t code = read_value<uint16_t>(block + i);
+                uint16_t option_length = read_value<uint16_t>(block + i + 2);
+                const uint8_t* value = block + i + 4;
+                if (code == OPT_ENDOFOPT || i + 4 + option_length > length - 4)
+                    break;
+                if (code == IF_NAME &&
+                    std::string(reinterpret_cast<const char*>(value), option_length) == TCP_INTERFACE_NAME)
+                    interface.interface = PacketRecorder::INTERFACE_TCP;
+                if (code == IF_TSRESOL && option_length >= 1)
+                {
+                    // The high bit selects a power of two resolution instead
+                    // of a power of ten
+                    uint8_t resolution = value[0];
+                    if (resolution & 0x80)
+                        interface.units_per_second = std::pow(2.0, resolution & 0x7F);
+                    else
+                        interface.units_per_second = std::pow(10.0, resolution);
+                }
+                i += 4 + (option_length + 3) / 4 * 4;
+            }
+
+            interfaces.push_back(interface);
+        }
+        else if (type == ENHANCED_PACKET_BLOCK && length >= 32)
+        {
+
+            uint32_t interface_id = read_value<uint32_t>(block + 8);
+            uint64_t timestamp = (static_cast<uint64_t>(read_value<uint32_t>(block + 12)) << 32) |
+                                 read_value<uint32_t>(block + 16);
+            uint32_t captured_length = read_value<uint32_t>(block + 20);
+            const uint8_t* data = block + 28;
+            options_offset = 28 + (static_cast<size_t>(captured_length) + 3) / 4 * 4;
+
+            if (interface_id >= interfaces.size() || options_offset > length - 4)
+                throw std::runtime_error("load_pcapng: invalid enhanced packet block in " + file_path);
+
+            const Interface& interface = interfaces.at(interface_id);
+
+            Event event;
+            event.time = timestamp / interface.units_per_second;
+            event.interface = interface.interface;
+            event.peer_address = 0;
+
+            bool outbound = false;
+            for (size_t i = options_offset; i + 4 <= length - 4; )
+            {
+                uint16_t code = read_value<uint16_t>(block + i);
+                uint16_t option_length = read_value<uint16_t>(block + i + 2);
+                const uint8_t* value = block + i + 4;
+                if (code == OPT_ENDOFOPT || i + 4 + option_length > length - 4)
+                    break;
+                if (code == EPB_FLAGS && option_length == 4)
+                    outbound = (read_value<uint32_t>(value) & EPB_FLAGS_DIRECTION_MASK) == EPB_FLAGS_OUTBOUND;
+                if (code == OPT_COMMENT)
+                    event.peer_address = parse_peer_address(
+                        std::string(reinterpret_cast<const char*>(value), option_length));
+                i += 4 + (option_length + 3) / 4 * 4;
+            }
+
+            // Only traffic received from vehicles is replayed
+            if (!outbound)
+            {
+                if (interface.link_type == LINKTYPE_USER0)
+                {
+                    event.data.assign(data, data + captured_length);
+                    loaded_events.push_back(event);
+                }
+                else if (interface.link_type == LINKTYPE_ETHERNET &&
+                         get_ethernet_payload(data, captured_length, event))
+                {
+                    loaded_events.push_back(event);
+                }
+            }
+
+        }
+
+        offset += length;
+
+    }
+
+    if (!has_section)
+        throw std::runtime_error("load_pcapng: " + file_path + " is not a pcapng file");
+
+    events.swap(loaded_events);
+    sort_events();
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        load_avl_log
+// Description: Replaces the events with STATUS packets built from the
+//              data lines of an AVL text log. The first two data lines
+//              of each tag hold the labels and units of the values in
+//              the following lines, and values are matched to status
+//              fields by their label. The tag selects the comms channel
+//              of the packet. Throws a std::runtime_error if the file
+//              cannot be read.
+// Arguments:   - file_path: path to the log file
+//              - vehicle_id: vehicle ID to give the STATUS packets
+//------------------------------------------------------------------------------
+void ReplayLog::load_avl_log(const std::string& file_path, int vehicle_id)
+{
+
+    std::ifstream file(file_path);
+    if (!file.is_open())
+        throw std::runtime_error("load_avl_log: failed to open " + file_path);
+
+    // Status value and unit scale of each message column, for each tag
+    struct TagColumns
+    {
+        int num_lines = 0;
+        std::vector<int> values;
+        std::vector<double> scales;
+    };
+    std::map<std::string, TagColumns> tags;
+
+    std::vector<Event> loaded_events;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+
+        // Log lines are bracketed tags followed by the message, as in
+        // [timestamp] [level] [node] [tag] message
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        size_t last_tag = line.find_last_of(']');
+        if (last_tag == std::string::npos)
+            continue;
+
+        std::string tags_string = line.substr(0, last_tag);
+        tags_string.erase(std::remove(tags_string.begin(), tags_string.end(), '['), tags_string.end());
+        std::replace(tags_string.begin(), tags_string.end(), ']', ' ');
+        std::vector<std::string> line_tags = split_spaces(tags_string);
+        std::vector<std::string> words = split_spaces(line.substr(last_tag + 1));
+
+        if (line_tags.size() < 3 || line_tags.at(1) != "DAT")
+            continue;
+
+        std::string tag = line_tags.size() > 3 ? line_tags.at(3) : "";
+        TagColumns& columns = tags[tag];
+        columns.num_lines++;
+
+        // The first data line of a tag holds the labels, and the second
+        // holds the units
+        if (columns.num_lines == 1)
+        {
+            for (const std::string& label : words)
+                columns.values.push_back(get_log_value(label));
+            columns.scales.assign(columns.values.size(), 1.0);
+            continue;
+        }
+        if (columns.num_lines == 2)
+        {
+            for (size_t i = 0; i < words.size() && i < columns.values.size(); i++)
+                if (columns.values.at(i) != NUM_LOG_VALUES &&
+                    LOG_VALUE_IS_ANGLE[columns.values.at(i)] && to_lower(words.at(i)) == "rad")
+                    columns.scales.at(i) = avl::geo::RADIANS_TO_DEGREES;
+            continue;
+        }
+
+        // Match the message values to the status values
+        double values[NUM_LOG_VALUES];
+        bool has_value[NUM_LOG_VALUES] = {};
+        std::fill(values, values + NUM_LOG_VALUES, std::nan(""));
+        bool has_any_value = false;
+        for (size_t i = 0; i < words.size() && i < columns.values.size(); i++)
+        {
+            int value = columns.values.at(i);
+            if (value == NUM_LOG_VALUES)
+                continue;
+            char* end;
+            double number = std::strtod(words.at(i).c_str(), &end);
+            if (end == words.at(i).c_str())
+                continue;
+            values[value] = number * columns.scales.at(i);
+            has_value[value] = true;
+            has_any_value = true;
+        }
+        if (!has_any_value)
+            continue;
+
+        // Build the STATUS packet with a field for each group of values that
+        // has at least one value
+        avl::Packet packet = STATUS_PACKET();
+        if (has_value[LOG_ROLL] || has_value[LOG_PITCH] || has_value[LOG_YAW])
+            packet.add_field(STATUS_ATTITUDE(values[LOG_ROLL], values[LOG_PITCH], values[LOG_YAW]));
+        if (has_value[LOG_VX] || has_value[LOG_VY] || has_value[LOG_VZ])
+            packet.add_field(STATUS_VELOCITY(values[LOG_VX], values[LOG_VY], values[LOG_VZ]));
+        if (has_value[LOG_LAT] || has_value[LOG_LON] || has_value[LOG_ALT])
+            packet.add_field(STATUS_POSITION(values[LOG_LAT], values[LOG_LON], values[LOG_ALT]));
+        if (has_value[LOG_DEPTH])
+            packet.add_field(STATUS_DEPTH(values[LOG_DEPTH]));
+        if (has_value[LOG_HEIGHT])
+            packet.add_field(STATUS_HEIGHT(values[LOG_HEIGHT]));
+        if (has_value[LOG_RPM])
+            packet.add_field(STATUS_RPM(values[LOG_RPM]));
+        if (has_value[LOG_VOLTAGE])
+            packet.add_field(STATUS_VOLTAGE(values[LOG_VOLTAGE]));
+        if (has_value[LOG_SATS])
+            packet.add_field(STATUS_GPS_SATS(static_cast<uint8_t>(values[LOG_SATS])));
+
+        std::string lower_tag = to_lower(tag);
+        if (lower_tag == "acomms")
+            packet.add_field(COMMS_CHANNEL(COMMS_CHANNEL_ACOMMS));
+        else if (lower_tag == "iridium")
+            packet.add_field(COMMS_CHANNEL(COMMS_CHANNEL_IRIDIUM));
+        else
+            packet.add_field(COMMS_CHANNEL(COMMS_CHANNEL_RADIO));
+        packet.add_field(VEHICLE_ID(static_cast<uint8_t>(vehicle_id)));
+
+        Event event;
+        event.time = std::strtod(line_tags.at(0).c_str(), nullptr);
+        event.interface = PacketRecorder::INTERFACE_UDP;
+        event.peer_address = 0;
+        event.data = packet.get_bytes();
+        loaded_events.push_back(event);
+
+    }
+
+    events.swap(loaded_events);
+    sort_events();
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        clear
+// Description: Removes all events.
+//------------------------------------------------------------------------------
+void ReplayLog::clear()
+{
+    events.clear();
+}
+
+//------------------------------------------------------------------------------
+// Name:        size
+// Description: Gets the number of events.
+// Returns:     Number of events.
+//------------------------------------------------------------------------------
+size_t ReplayLog::size() const
+{
+    return events.size();
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_event
+// Description: Gets an event. Throws a std::runtime_error if the index is
+//              out of range.
+// Arguments:   - index: event index, in time order
+// Returns:     Event at the index.
+//------------------------------------------------------------------------------
+const ReplayLog::Event& ReplayLog::get_event(size_t index) const
+{
+    if (index >= events.size())
+        throw std::runtime_error("get_event: event index out of range");
+    return events[index];
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_start_time
+// Description: Gets the time of the first event.
+// Returns:     Time of the first event in seconds, or 0 if there are no
+//              events.
+//------------------------------------------------------------------------------
+double ReplayLog::get_start_time() const
+{
+    return events.empty() ? 0.0 : events.front().time;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_duration
+// Description: Gets the time from the first event to the last event.
+// Returns:     Duration in seconds, or 0 if there are no events.
+//------------------------------------------------------------------------------
+double ReplayLog::get_duration() const
+{
+    return events.empty() ? 0.0 : events.back().time - events.front().time;
+}
+
+//------------------------------------------------------------------------------
+// Name:        find_event
+// Description: Finds the first event at or after a time using a binary
+//              search.
+// Arguments:   - time: time in seconds
+// Returns:     Index of the first event at or after the time, or the
+//              number of events if there is none.
+//------------------------------------------------------------------------------
+size_t ReplayLog::find_event(double time) const
+{
+    auto it = std::lower_bound(events.begin(), events.end(), time,
+        [](const Event& event, double t) { return event.time < t; });
+    return static_cast<size_t>(it - events.begin());
+}
+
+//------------------------------------------------------------------------------
+// Name:        read_file
+// Description: Reads an entire file. Throws a std::runtime_error if the
+//              file cannot be read.
+// Arguments:   - file_path: path to the file
+// Returns:     File bytes.
+//------------------------------------------------------------------------------
+std::vector<uint8_t> ReplayLog::read_file(const std::string& file_path)
+{
+    std::ifstream file(file_path, std::ios::binary);
+    if (!file.is_open())
+        throw std::runtime_error("read_file: failed to open " + file_path);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file),
+                                std::istreambuf_iterator<char>());
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_ethernet_payload
+// Description: Gets the payload of an IPv4 UDP datagram sent to the
+//              status port from an Ethernet frame.
+// Arguments:   - frame: pointer to the frame bytes
+//              - size: number of bytes in the frame
+//              - event: event to fill with the sender and payload
+// Returns:     True if the frame holds such a datagram, false otherwise.
+//------------------------------------------------------------------------------
+bool ReplayLog::get_ethernet_payload(const uint8_t* frame, size_t size, Event& event)
+{
+
+    // Skip a VLAN tag if there is one
+    size_t offset = ETHERNET_HEADER_SIZE;
+    if (size < offset)
+        return false;
+    uint16_t ethertype = read_big_endian(frame + 12);
+    if (ethertype == ETHERTYPE_VLAN)
+    {
+        if (size < offset + 4)
+            return false;
+        ethertype = read_big_endian(frame + 16);
+        offset += 4;
+    }
+    if (ethertype != ETHERTYPE_IPV4 || size < offset + 20)
+        return false;
+
+    // IPv4 header, whose length is given in 32 bit words
+    const uint8_t* ip = frame + offset;
+    size_t ip_header_size = (ip[0] & 0x0F) * 4;
+    size_t ip_total_size = read_big_endian(ip + 2);
+    if (ip[9] != IP_PROTOCOL_UDP || ip_header_size < 20 ||
+        ip_total_size < ip_header_size + UDP_HEADER_SIZE || offset + ip_total_size > size)
+        return false;
+
+    // Fragments after the first do not have a UDP header
+    if (read_big_endian(ip + 6) & 0x1FFF)
+        return false;
+
+    const uint8_t* udp = ip + ip_header_size;
+    if (read_big_endian(udp + 2) != STATUS_PORT)
+        return false;
+    size_t udp_size = read_big_endian(udp + 4);
+    if (udp_size < UDP_HEADER_SIZE || ip_header_size + udp_size > ip_total_size)
+        return false;
+
+    event.peer_address = (static_cast<uint32_t>(ip[12]) << 24) |
+                         (static_cast<uint32_t>(ip[13]) << 16) |
+                         (static_cast<uint32_t>(ip[14]) << 8) |
+                         static_cast<uint32_t>(ip[15]);
+    event.interface = PacketRecorder::INTERFACE_UDP;
+    event.data.assign(udp + UDP_HEADER_SIZE, udp + udp_size);
+    return true;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        parse_peer_address
+// Description: Parses the IPv4 address from a packet recorder peer
+//              comment of the form a.b.c.d:port.
+// Arguments:   - comment: comment string
+// Returns:     IPv4 address in host byte order, or 0 if the comment is
+//              not a peer address.
+//------------------------------------------------------------------------------
+uint32_t ReplayLog::parse_peer_address(const std::string& comment)
+{
+    unsigned int a, b, c, d, port;
+    if (std::sscanf(comment.c_str(), "%u.%u.%u.%u:%u", &a, &b, &c, &d, &port) != 5 ||
+        a > 255 || b > 255 || c > 255 || d > 255)
+        return 0;
+    return (a << 24) | (b << 16) | (c << 8) | d;
+}
+
+//------------------------------------------------------------------------------
+// Name:        sort_events
+// Description: Sorts the events by time, keeping the order of events
+//              with equal times.
+//------------------------------------------------------------------------------
+void ReplayLog::sort_events()
+{
+    std::stable_sort(events.begin(), events.end(),
+        [](const Event& a, const Event& b) { return a.time < b.time; });
+}
@@ -0,0 +1,198 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Generates survey paths for zone tasks off the GUI thread and
+//              caches them by a hash of their inputs.
+//==============================================================================
+
+#include "survey_generator.h"
+
+// Survey path planning
+#include "coverage_planner.h"
+
+// Background planning
+#include <QtConcurrent>
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+const int SurveyGenerator::MAX_CACHED_POINTS;
+
+//==============================================================================
+//                              HELPER FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        hash_double
+// Description: Adds a double to a 64 bit FNV-1a hash.
+// Arguments:   - hash: hash to add to
+//              - value: value to add
+// Returns:     Updated hash.
+//------------------------------------------------------------------------------
+static quint64 hash_double(quint64 hash, double value)
+{
+
+    // Every NaN hashes the same, since any NaN means a missing value
+    if (std::isnan(value))
+        value = std::numeric_limits<double>::quiet_NaN();
+
+    unsigned char bytes[sizeof(double)];
+    std::memcpy(bytes, &value, sizeof(double));
+    for (unsigned char byte : bytes)
+    {
+        hash ^= byte;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        same_value
+// Description: Checks if two values are equal, treating NaNs as equal.
+// Arguments:   - a: first value
+//              - b: second value
+// Returns:     True if the values are equal.
+//------------------------------------------------------------------------------
+static bool same_value(double a, double b)
+{
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        SurveyGenerator constructor
+// Description: Constructs a generator with an empty cache.
+// Arguments:   - parent: parent QObject
+//------------------------------------------------------------------------------
+SurveyGenerator::SurveyGenerator(QObject* parent) : QObject(parent),
+    cache(MAX_CACHED_POINTS)
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        SurveyGenerator destructor
+// Description: Default destructor. Surveys that are still generating
+//              finish in the background and are discarded.
+//------------------------------------------------------------------------------
+SurveyGenerator::~SurveyGenerator()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_key
+// Description: Hashes the inputs of a survey.
+// Arguments:   - outline: zone outline with longitude as x and latitude
+//                as y
+//              - angle: pass heading in degrees
+//              - swath: pass spacing in meters
+// Returns:     Survey key.
+//------------------------------------------------------------------------------
+quint64 SurveyGenerator::get_key(const std::vector<QPointF>& outline, double angle, double swath)
+{
+
+    quint64 hash = 14695981039346656037ULL;
+    hash = hash_double(hash, angle);
+    hash = hash_double(hash, swath);
+    for (const QPointF& point : outline)
+    {
+        hash = hash_double(hash, point.x());
+        hash = hash_double(hash, point.y());
+    }
+    return hash;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        generate
+// Description: Plans a survey path on the calling thread.
+// Arguments:   - outline: zone outline with longitude as x and latitude
+//                as y
+//              - angle: pass heading in degrees
+//              - swath: pass spacing in meters
+// Returns:     Survey path with longitude as x and latitude as y.
+//------------------------------------------------------------------------------
+std::vector<QPointF> SurveyGenerator::generate(const std::vector<QPointF>& outline,
+                                               double angle, double swath)
+{
+
+    std::vector<CoveragePlanner::Location> zone;
+    zone.reserve(outline.size());
+    for (const QPointF& point : outline)
+        zone.push_back(CoveragePlanner::Location{point.y(), point.x()});
+
+    std::vector<QPointF> path;
+    for (const CoveragePlanner::Location& location : CoveragePlanner(angle, swath).plan(zone))
+        path.push_back(QPointF(location.lon, location.lat));
+    return path;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_survey
+// Description: Gets a survey path from the cache. If it is not cached it
+//              is generated in the background, unless it already is, and
+//              surveyReady is emitted when it is.
+// Arguments:   - outline: zone outline with longitude as x and latitude
+//                as y
+//              - angle: pass heading in degrees
+//              - swath: pass spacing in meters
+//              - path: set to the survey path with longitude as x and
+//                latitude as y if it is cached
+// Returns:     True if the survey was cached.
+//------------------------------------------------------------------------------
+bool SurveyGenerator::get_survey(const std::vector<QPointF>& outline, double angle, double swath,
+                                 std::vector<QPointF>& path)
+{
+
+    quint64 key = get_key(outline, angle, swath);
+
+    Survey* survey = cache.object(key);
+    if (survey != nullptr && same_value(survey->angle, angle) &&
+        same_value(survey->swath, swath) && survey->outline.size() == outline.size() &&
+        std::equal(outline.begin(), outline.end(), survey->outline.begin(),
+                   [](const QPointF& a, const QPointF& b)
+                   { return same_value(a.x(), b.x()) && same_value(a.y(), b.y()); }))
+    {
+        path = survey->path;
+        return true;
+    }
+
+    if (pending.contains(key))
+        return false;
+
+    // The plan works on copies of the inputs, so nothing it reads can be
+    // changed by the GUI thread while it runs
+    Survey inputs{outline, angle, swath, std::vector<QPointF>()};
+    QFutureWatcher<Survey>* watcher = new QFutureWatcher<Survey>(this);
+    pending.insert(key, watcher);
+    connect(watcher, &QFutureWatcher<Survey>::finished, this, [this, key, watcher]()
+    {
+        // A survey larger than the whole cache is still cached, by costing
+        // it as the whole cache, so that it is not generated again forever
+        Survey* survey = new Survey(watcher->result());
+        int cost = static_cast<int>(std::min(survey->path.size(),
+                                             static_cast<size_t>(MAX_CACHED_POINTS)));
+        cache.insert(key, survey, std::max(cost, 1));
+        pending.remove(key);
+        watcher->deleteLater();
+        emit surveyReady(key);
+    });
+    watcher->setFuture(QtConcurrent::run([inputs]()
+    {
+        Survey survey = inputs;
+        survey.path = generate(inputs.outline, inputs.angle, inputs.swath);
+        return survey;
+    }));
+
+    return false;
+
+}
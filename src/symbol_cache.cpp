@@ -0,0 +1,122 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Cache of recolored icon symbols and waypoint symbols. Each
+//              symbol is created once and shared by every graphic that uses
+//              it.
+//==============================================================================
+
+#include "symbol_cache.h"
+
+// Icon recoloring
+#include "graphics.h"
+
+// Application object that owns the cache
+#include <QCoreApplication>
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+constexpr const char* SymbolCache::VEHICLE_ICON_RESOURCE;
+const int SymbolCache::VEHICLE_ICON_OUTLINE_SIZE;
+const int SymbolCache::VEHICLE_ICON_FILL_SIZE;
+
+//------------------------------------------------------------------------------
+// Name:        instance
+// Description: Gets the application's symbol cache, creating it on first
+//              use. The cache is owned by the application object, so
+//              the symbols are released before the ArcGIS runtime shuts
+//              down.
+// Returns:     Pointer to the symbol cache.
+//------------------------------------------------------------------------------
+SymbolCache* SymbolCache::instance()
+{
+    static SymbolCache* cache = new SymbolCache(QCoreApplication::instance());
+    return cache;
+}
+
+//------------------------------------------------------------------------------
+// Name:        SymbolCache constructor
+// Description: Constructs an empty cache.
+// Arguments:   - parent: parent QObject
+//------------------------------------------------------------------------------
+SymbolCache::SymbolCache(QObject* parent) : QObject(parent)
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_icon_symbol
+// Description: Gets a square picture symbol of an icon resource painted
+//              in a color, creating it on first use.
+// Arguments:   - resource_name: icon resource name
+//              - color: icon color
+//              - size: symbol width and height
+// Returns:     Pointer to the cached symbol, owned by the cache.
+//------------------------------------------------------------------------------
+PictureMarkerSymbol* SymbolCache::get_icon_symbol(QString resource_name, QColor color, int size)
+{
+
+    IconKey key(resource_name, color.rgba(), size);
+    auto it = icon_symbols.find(key);
+    if (it != icon_symbols.end())
+        return it->second;
+
+    PictureMarkerSymbol* symbol =
+            new PictureMarkerSymbol(get_icon_in_color(resource_name, color), this);
+    symbol->setWidth(size);
+    symbol->setHeight(size);
+    icon_symbols[key] = symbol;
+    return symbol;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_vehicle_icon_symbol
+// Description: Gets the vehicle icon symbol in a color, which is the
+//              icon in the color on top of a larger white outline.
+// Arguments:   - color: vehicle icon color
+// Returns:     Pointer to the cached symbol, owned by the cache.
+//------------------------------------------------------------------------------
+CompositeSymbol* SymbolCache::get_vehicle_icon_symbol(QColor color)
+{
+
+    auto it = vehicle_icon_symbols.find(color.rgba());
+    if (it != vehicle_icon_symbols.end())
+        return it->second;
+
+    QList<Symbol*> symbol_list;
+    symbol_list.append(get_icon_symbol(VEHICLE_ICON_RESOURCE, QColor(255, 255, 255),
+                                       VEHICLE_ICON_OUTLINE_SIZE));
+    symbol_list.append(get_icon_symbol(VEHICLE_ICON_RESOURCE, color,
+                                       VEHICLE_ICON_FILL_SIZE));
+    CompositeSymbol* symbol = new CompositeSymbol(symbol_list, this);
+    vehicle_icon_symbols[color.rgba()] = symbol;
+    return symbol;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_waypoint_symbol
+// Description: Gets a mission waypoint symbol, which is a white circle
+//              with a colored border, creating it on first use. Waypoint
+//              labels are drawn separately.
+// Arguments:   - color: waypoint border color
+// Returns:     Pointer to the cached symbol, owned by the cache.
+//------------------------------------------------------------------------------
+CompositeSymbol* SymbolCache::get_waypoint_symbol(QColor color)
+{
+
+    auto it = waypoint_symbols.find(color.rgba());
+    if (it != waypoint_symbols.end())
+        return it->second;
+
+    QList<Symbol*> symbol_list;
+    symbol_list.append(new SimpleMarkerSymbol(SimpleMarkerSymbolStyle::Circle, color, 31, this));
+    symbol_list.append(new SimpleMarkerSymbol(SimpleMarkerSymbolStyle::Circle, QColor(Qt::white), 25, this));
+    CompositeSymbol* symbol = new CompositeSymbol(symbol_list, this);
+    waypoint_symbols[color.rgba()] = symbol;
+    return symbol;
+
+}
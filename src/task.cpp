@@ -72,86 +72,209 @@ void Task::set_command(int new_command)
     emit taskChanged();
 }
 
-QVector<std::pair<QPointF, ActionType::Value>> Task::get_points()
+//------------------------------------------------------------------------------
+// Name:        get_num_points
+// Description: Gets the number of points in the task.
+// Returns:     Number of points.
+//------------------------------------------------------------------------------
+int Task::get_num_points() const
+{
+    return point_lats.size();
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_point
+// Description: Gets the location of a point. The index is not checked.
+// Arguments:   - index: index of the point
+// Returns:     Point location with longitude as x and latitude as y.
+//------------------------------------------------------------------------------
+QPointF Task::get_point(int index) const
+{
+    return QPointF(point_lons[index], point_lats[index]);
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_lats, get_lons, get_commands
+// Description: Gets read-only views of the latitudes and longitudes in
+//              degrees and the commands of the points, without copying
+//              them. A view is only valid until the points next change.
+// Returns:     View of the point values, one element per point.
+//------------------------------------------------------------------------------
+avl::Span<double> Task::get_lats() const
+{
+    return avl::Span<double>(point_lats.constData(),
+                             static_cast<size_t>(point_lats.size()));
+}
+
+avl::Span<double> Task::get_lons() const
+{
+    return avl::Span<double>(point_lons.constData(),
+                             static_cast<size_t>(point_lons.size()));
+}
+
+avl::Span<ActionType::Value> Task::get_commands() const
 {
-    return points;
+    return avl::Span<ActionType::Value>(point_commands.constData(),
+                                        static_cast<size_t>(point_commands.size()));
 }
 
 void Task::add_point(QPointF new_point, ActionType::Value command)
 {
-    points.append(std::make_pair(new_point, command));
+    add_point_silent(new_point, command);
     emit taskChanged();
 }
 
-void Task::add_point_silent(QPointF new_point)
+void Task::add_point_silent(QPointF new_point, ActionType::Value command)
 {
-    points.append(std::make_pair(new_point, ActionType::ACTION_NO_ACTION));
+    int index = point_lats.size();
+    emit pointsAboutToBeInserted(index, index);
+    point_lats.append(new_point.y());
+    point_lons.append(new_point.x());
+    point_commands.append(command);
+    emit pointsInserted(index, index);
 }
 
 void Task::edit_point(int index, QPointF new_point)
 {
-    if (points.size() > index)
-        points[index].first = new_point;
+    if (point_lats.size() > index)
+    {
+        point_lats[index] = new_point.y();
+        point_lons[index] = new_point.x();
+        emit pointChanged(index);
+    }
     emit taskChanged();
 }
 
 void Task::set_point_lat(int index, double lat)
 {
-    points[index].first.setY(lat);
+    point_lats[index] = lat;
+    emit pointChanged(index);
     emit taskChanged();
 }
 
 void Task::set_point_lon(int index, double lon)
 {
-    points[index].first.setX(lon);
+    point_lons[index] = lon;
+    emit pointChanged(index);
     emit taskChanged();
 }
 
 void Task::set_point_command(int index, ActionType::Value new_command)
 {
-    points[index].second = new_command;
+    point_commands[index] = new_command;
+    emit pointChanged(index);
     emit taskChanged();
 }
 
 void Task::move_point_up(int index)
 {
-    points.move(index, index-1);
+    emit pointAboutToBeMoved(index, index-1);
+    point_lats.move(index, index-1);
+    point_lons.move(index, index-1);
+    point_commands.move(index, index-1);
+    emit pointMoved(index, index-1);
     emit taskChanged();
 }
 
 void Task::move_point_down(int index)
 {
-    points.move(index, index+1);
+    emit pointAboutToBeMoved(index, index+1);
+    point_lats.move(index, index+1);
+    point_lons.move(index, index+1);
+    point_commands.move(index, index+1);
+    emit pointMoved(index, index+1);
     emit taskChanged();
 }
 
 void Task::remove_point(int index)
 {
-    points.remove(index);
+    emit pointsAboutToBeRemoved(index, index);
+    point_lats.remove(index);
+    point_lons.remove(index);
+    point_commands.remove(index);
+    emit pointsRemoved(index, index);
     emit taskChanged();
 }
 
 void Task::clear_points()
 {
-    points.clear();
+    clear_points_silent();
     emit taskChanged();
 }
 
 void Task::clear_points_silent()
 {
-    points.clear();
+    if (point_lats.isEmpty())
+        return;
+    int last = point_lats.size() - 1;
+    emit pointsAboutToBeRemoved(0, last);
+    point_lats.clear();
+    point_lons.clear();
+    point_commands.clear();
+    emit pointsRemoved(0, last);
+}
+
+void Task::set_points(const QVector<QPointF>& new_points)
+{
+    set_points_silent(new_points);
+    emit taskChanged();
+}
+
+void Task::set_points_silent(const QVector<QPointF>& new_points)
+{
+    emit pointsAboutToBeReset();
+    point_lats.clear();
+    point_lons.clear();
+    point_lats.reserve(new_points.size());
+    point_lons.reserve(new_points.size());
+    for (const QPointF& new_point : new_points)
+    {
+        point_lats.append(new_point.y());
+        point_lons.append(new_point.x());
+    }
+    point_commands = QVector<ActionType::Value>(new_points.size(), ActionType::ACTION_NO_ACTION);
+    emit pointsReset();
+}
+
+//------------------------------------------------------------------------------
+// Name:        copy_parameters
+// Description: Copies the type, command and guidance values of another
+//              task, leaving this task's points as they are.
+// Arguments:   - task: task to copy from
+//------------------------------------------------------------------------------
+void Task::copy_parameters(Task* task)
+{
+    type       = task->type;
+    action     = task->action;
+    m_duration = task->m_duration;
+    m_roll     = task->m_roll;
+    m_pitch    = task->m_pitch;
+    m_yaw      = task->m_yaw;
+    m_vx       = task->m_vx;
+    m_vy       = task->m_vy;
+    m_vz       = task->m_vz;
+    m_depth    = task->m_depth;
+    m_height   = task->m_height;
+    m_rpm      = task->m_rpm;
+    m_swath    = task->m_swath;
+    m_angle    = task->m_angle;
+    m_dive     = task->m_dive;
+    emit taskChanged();
 }
 
 avl::Packet Task::get_packet()
 {
 
-    std::vector<double> points_vect;
-    for (auto point : points)
+    // Points are packed in order as latitude, longitude, yaw and command
+    int num_points = point_lats.size();
+    std::vector<double> points_vect(static_cast<size_t>(num_points) * 4);
+    for (int i = 0; i < num_points; i++)
     {
-        points_vect.push_back(point.first.y());
-        points_vect.push_back(point.first.x());
-        points_vect.push_back(std::nan(""));
-        points_vect.push_back(point.second);
+        size_t offset = static_cast<size_t>(i) * 4;
+        points_vect[offset]   = point_lats.at(i);
+        points_vect[offset+1] = point_lons.at(i);
+        points_vect[offset+2] = std::nan("");
+        points_vect[offset+3] = point_commands.at(i);
     }
 
     avl::Packet task_packet = TASK_PACKET();
@@ -361,15 +484,16 @@ Task* Task::packet_to_task(avl::Packet task_packet)
     {
         std::vector<double> task_points = avl::vector_from_bytes<double>(task_packet.get_field(TASK_POINTS_DESC).get_data());
 
-        // Add points to the task
-        for(size_t i = 0; i < task_points.size(); i = i+3)
+        // Add points to the task. Points are packed the same way get_packet
+        // packs them, as latitude, longitude, yaw and command
+        for(size_t i = 0; i + 3 < task_points.size(); i = i+4)
         {
-            task->add_point(QPointF(task_points[i+1], task_points[i]), ActionType::Value(task_points[i+2]));
+            task->add_point(QPointF(task_points[i+1], task_points[i]), ActionType::Value(static_cast<int>(task_points[i+3])));
         }
     }
 
     if(task_packet.has_field(TASK_COMMAND_DESC))
-        task->set_command(avl::from_bytes<double>(task_packet.get_field(TASK_COMMAND_DESC).get_data()));
+        task->set_command(avl::from_bytes<uint8_t>(task_packet.get_field(TASK_COMMAND_DESC).get_data()));
 
     return task;
 }
@@ -0,0 +1,273 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Fixed capacity history of vehicle telemetry, stored as a
+//              struct of arrays. Each channel is one contiguous ring buffer
+//              and all channels share a single timestamp ring buffer.
+//==============================================================================
+
+#include "telemetry_history.h"
+
+// C++ includes
+#include <algorithm>
+#include <stdexcept>
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        TelemetryHistory constructor
+// Description: Constructs an empty history and allocates all of its
+//              storage. Throws a std::runtime_error if the number of
+//              channels or the capacity is zero.
+// Arguments:   - num_channels: number of values in each sample
+//              - capacity: maximum number of samples stored
+//------------------------------------------------------------------------------
+TelemetryHistory::TelemetryHistory(size_t num_channels, size_t capacity) :
+    num_channels(num_channels), max_samples(capacity)
+{
+
+    if (num_channels == 0 || capacity == 0)
+        throw std::runtime_error("TelemetryHistory: number of channels and capacity must be non-zero");
+
+    times.resize(max_samples);
+    values.resize(num_channels * max_samples);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        TelemetryHistory destructor
+// Description: Default destructor.
+//------------------------------------------------------------------------------
+TelemetryHistory::~TelemetryHistory()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        append
+// Description: Appends a sample, overwriting the oldest sample if the
+//              history is full. Timestamps must not decrease for the
+//              time range search to work, so a timestamp older than the
+//              newest sample is replaced with the newest sample's.
+// Arguments:   - time: sample time in seconds
+//              - sample_values: array of num_channels values in channel
+//                order
+//------------------------------------------------------------------------------
+void TelemetryHistory::append(double time, const double* sample_values)
+{
+
+    if (count > 0)
+        time = std::max(time, times[get_slot(count - 1)]);
+
+    // Write into the slot after the newest sample. If the history is full
+    // that slot holds the oldest sample, which is dropped by moving the head
+    size_t slot;
+    if (count < max_samples)
+    {
+        slot = get_slot(count);
+        count++;
+    }
+    else
+    {
+        slot = head;
+        head = (head + 1) % max_samples;
+    }
+
+    times[slot] = time;
+    for (size_t c = 0; c < num_channels; c++)
+        values[c * max_samples + slot] = sample_values[c];
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        clear
+// Description: Removes all samples without releasing storage.
+//------------------------------------------------------------------------------
+void TelemetryHistory::clear()
+{
+    head = 0;
+    count = 0;
+}
+
+//------------------------------------------------------------------------------
+// Name:        size
+// Description: Gets the number of stored samples.
+// Returns:     Number of stored samples.
+//------------------------------------------------------------------------------
+size_t TelemetryHistory::size() const
+{
+    return count;
+}
+
+//------------------------------------------------------------------------------
+// Name:        capacity
+// Description: Gets the maximum number of samples that can be stored.
+// Returns:     History capacity in samples.
+//------------------------------------------------------------------------------
+size_t TelemetryHistory::capacity() const
+{
+    return max_samples;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_num_channels
+// Description: Gets the number of values in each sample.
+// Returns:     Number of channels.
+//------------------------------------------------------------------------------
+size_t TelemetryHistory::get_num_channels() const
+{
+    return num_channels;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_time
+// Description: Gets the time of a sample. Throws a std::runtime_error if
+//              the index is out of range.
+// Arguments:   - index: sample index, 0 being the oldest
+// Returns:     Sample time in seconds.
+//------------------------------------------------------------------------------
+double TelemetryHistory::get_time(size_t index) const
+{
+    if (index >= count)
+        throw std::runtime_error("get_time: sample index out of range");
+    return times[get_slot(index)];
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_value
+// Description: Gets a channel value of a sample. Throws a
+//              std::runtime_error if the channel or index is out of
+//              range.
+// Arguments:   - channel: channel index
+//              - index: sample index, 0 being the oldest
+// Returns:     Channel value.
+//------------------------------------------------------------------------------
+double TelemetryHistory::get_value(size_t channel, size_t index) const
+{
+    if (channel >= num_channels || index >= count)
+        throw std::runtime_error("get_value: channel or sample index out of range");
+    return values[channel * max_samples + get_slot(index)];
+}
+
+//------------------------------------------------------------------------------
+// Name:        find_range
+// Description: Finds the samples with times in [start_time, end_time]
+//              using a binary search over the timestamps.
+// Arguments:   - start_time: earliest sample time in seconds
+//              - end_time: latest sample time in seconds
+//              - first: set to the index of the first sample in range
+//              - last: set to one past the index of the last sample in
+//                range. Equal to first if no samples are in range
+//------------------------------------------------------------------------------
+void TelemetryHistory::find_range(double start_time, double end_time,
+                                  size_t& first, size_t& last) const
+{
+
+    // Lower bound: first sample with time >= start_time
+    size_t low = 0;
+    size_t high = count;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        if (times[get_slot(mid)] < start_time)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    first = low;
+
+    // Upper bound: first sample with time > end_time
+    high = count;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        if (times[get_slot(mid)] <= end_time)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    last = low;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_time_spans
+// Description: Gets the timestamps of the samples in [first, last) as up
+//              to two contiguous spans, in order. The second span is
+//              empty unless the range wraps around the buffer end.
+// Arguments:   - first: index of the first sample
+//              - last: one past the index of the last sample
+//              - spans: array of two spans to fill
+//------------------------------------------------------------------------------
+void TelemetryHistory::get_time_spans(size_t first, size_t last, Span spans[2]) const
+{
+    get_spans(times.data(), first, last, spans);
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_channel_spans
+// Description: Gets the values of a channel for the samples in
+//              [first, last) as up to two contiguous spans, in order.
+//              Throws a std::runtime_error if the channel is out of
+//              range.
+// Arguments:   - channel: channel index
+//              - first: index of the first sample
+//              - last: one past the index of the last sample
+//              - spans: array of two spans to fill
+//------------------------------------------------------------------------------
+void TelemetryHistory::get_channel_spans(size_t channel, size_t first, size_t last,
+                                         Span spans[2]) const
+{
+    if (channel >= num_channels)
+        throw std::runtime_error("get_channel_spans: channel out of range");
+    get_spans(values.data() + channel * max_samples, first, last, spans);
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_slot
+// Description: Converts a sample index to a ring buffer slot.
+// Arguments:   - index: sample index, 0 being the oldest
+// Returns:     Ring buffer slot.
+//------------------------------------------------------------------------------
+size_t TelemetryHistory::get_slot(size_t index) const
+{
+    size_t slot = head + index;
+    return slot >= max_samples ? slot - max_samples : slot;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_spans
+// Description: Splits the samples in [first, last) of a ring buffer into
+//              up to two contiguous spans.
+// Arguments:   - buffer: start of the ring buffer
+//              - first: index of the first sample
+//              - last: one past the index of the last sample
+//              - spans: array of two spans to fill
+//------------------------------------------------------------------------------
+void TelemetryHistory::get_spans(const double* buffer, size_t first, size_t last,
+                                 Span spans[2]) const
+{
+
+    spans[0].data = buffer;
+    spans[0].size = 0;
+    spans[1].data = buffer;
+    spans[1].size = 0;
+
+    last = std::min(last, count);
+    if (first >= last)
+        return;
+
+    size_t start_slot = get_slot(first);
+    size_t num = last - first;
+
+    // The run from the start slot to the end of the buffer, then whatever
+    // is left from the start of the buffer
+    size_t to_end = max_samples - start_slot;
+    spans[0].data = buffer + start_slot;
+    spans[0].size = std::min(num, to_end);
+    if (num > to_end)
+        spans[1].size = num - to_end;
+
+}
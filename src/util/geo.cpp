@@ -0,0 +1,237 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Geodesy functions shared by everything that measures or
+//              moves locations on the earth.
+//==============================================================================
+
+#include "util/geo.h"
+
+// C++ includes
+#include <cmath>
+
+namespace avl
+{
+
+namespace geo
+{
+
+//==============================================================================
+//                              HELPER FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        haversine
+// Description: Gets the great circle distance between two locations from
+//              their latitudes and the cosines of their latitudes.
+// Arguments:   - lat1: start latitude in radians
+//              - cos_lat1: cosine of the start latitude
+//              - lat2: end latitude in radians
+//              - cos_lat2: cosine of the end latitude
+//              - dlon: longitude difference in radians
+// Returns:     Distance in meters.
+//------------------------------------------------------------------------------
+static inline double haversine(double lat1, double cos_lat1, double lat2,
+                               double cos_lat2, double dlon)
+{
+    double sin_dlat = std::sin((lat2 - lat1) / 2.0);
+    double sin_dlon = std::sin(dlon / 2.0);
+    double a = sin_dlat * sin_dlat + cos_lat1 * cos_lat2 * sin_dlon * sin_dlon;
+    return 2.0 * EARTH_RADIUS * std::atan2(std::sqrt(a), std::sqrt(1.0 - a));
+}
+
+//------------------------------------------------------------------------------
+// Name:        wrap_bearing
+// Description: Converts an angle from atan2 to a compass bearing.
+// Arguments:   - angle: angle in radians from -pi up to pi
+// Returns:     Bearing in degrees from 0 up to 360.
+//------------------------------------------------------------------------------
+static inline double wrap_bearing(double angle)
+{
+    double bearing = angle * RADIANS_TO_DEGREES;
+    return bearing < 0.0 ? bearing + 360.0 : bearing;
+}
+
+//==============================================================================
+//                             FUNCTION DEFINITIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        distance
+// Description: Gets the great circle distance between two locations.
+// Arguments:   - lat1: start latitude in degrees
+//              - lon1: start longitude in degrees
+//              - lat2: end latitude in degrees
+//              - lon2: end longitude in degrees
+// Returns:     Distance in meters.
+//------------------------------------------------------------------------------
+double distance(double lat1, double lon1, double lat2, double lon2)
+{
+    double lat1_rad = lat1 * DEGREES_TO_RADIANS;
+    double lat2_rad = lat2 * DEGREES_TO_RADIANS;
+    return haversine(lat1_rad, std::cos(lat1_rad), lat2_rad, std::cos(lat2_rad),
+                     (lon2 - lon1) * DEGREES_TO_RADIANS);
+}
+
+//------------------------------------------------------------------------------
+// Name:        bearing
+// Description: Gets the initial great circle bearing from one location to
+//              another.
+// Arguments:   - lat1: start latitude in degrees
+//              - lon1: start longitude in degrees
+//              - lat2: end latitude in degrees
+//              - lon2: end longitude in degrees
+// Returns:     Compass bearing in degrees from 0 up to 360.
+//------------------------------------------------------------------------------
+double bearing(double lat1, double lon1, double lat2, double lon2)
+{
+    double lat1_rad = lat1 * DEGREES_TO_RADIANS;
+    double lat2_rad = lat2 * DEGREES_TO_RADIANS;
+    double dlon = (lon2 - lon1) * DEGREES_TO_RADIANS;
+    double y = std::sin(dlon) * std::cos(lat2_rad);
+    double x = std::cos(lat1_rad) * std::sin(lat2_rad) -
+               std::sin(lat1_rad) * std::cos(lat2_rad) * std::cos(dlon);
+    return wrap_bearing(std::atan2(y, x));
+}
+
+//------------------------------------------------------------------------------
+// Name:        destination
+// Description: Gets the location reached by following a great circle from
+//              a location at a bearing for a distance.
+// Arguments:   - lat: start latitude in degrees
+//              - lon: start longitude in degrees
+//              - bearing: initial compass bearing in degrees
+//              - distance: distance in meters
+//              - dest_lat: set to the destination latitude in degrees
+//              - dest_lon: set to the destination longitude in degrees, from
+//                -180 up to 180
+//------------------------------------------------------------------------------
+void destination(double lat, double lon, double bearing, double distance,
+                 double& dest_lat, double& dest_lon)
+{
+    double lat_rad = lat * DEGREES_TO_RADIANS;
+    double bearing_rad = bearing * DEGREES_TO_RADIANS;
+    double angle = distance / EARTH_RADIUS;
+    double sin_lat = std::sin(lat_rad);
+    double cos_lat = std::cos(lat_rad);
+    double sin_angle = std::sin(angle);
+    double cos_angle = std::cos(angle);
+    double sin_dest_lat = sin_lat * cos_angle + cos_lat * sin_angle * std::cos(bearing_rad);
+    double dlon = std::atan2(std::sin(bearing_rad) * sin_angle * cos_lat,
+                             cos_angle - sin_lat * sin_dest_lat);
+    dest_lat = std::asin(sin_dest_lat) * RADIANS_TO_DEGREES;
+    dest_lon = std::remainder(lon + dlon * RADIANS_TO_DEGREES, 360.0);
+}
+
+//------------------------------------------------------------------------------
+// Name:        path_length
+// Description: Gets the length of a path of great circle segments.
+// Arguments:   - lat: path latitudes in degrees
+//              - lon: path longitudes in degrees
+//              - count: number of path locations
+// Returns:     Path length in meters.
+//------------------------------------------------------------------------------
+double path_length(const double* lat, const double* lon, size_t count)
+{
+
+    // Each location starts one segment and ends another, so its latitude
+    // and the cosine of its latitude are carried over to the next segment
+    // instead of being computed twice
+    double length = 0.0;
+    if (count < 2)
+        return length;
+
+    double lat1 = lat[0] * DEGREES_TO_RADIANS;
+    double cos_lat1 = std::cos(lat1);
+    for (size_t i = 1; i < count; i++)
+    {
+        double lat2 = lat[i] * DEGREES_TO_RADIANS;
+        double cos_lat2 = std::cos(lat2);
+        length += haversine(lat1, cos_lat1, lat2, cos_lat2,
+                            (lon[i] - lon[i-1]) * DEGREES_TO_RADIANS);
+        lat1 = lat2;
+        cos_lat1 = cos_lat2;
+    }
+
+    return length;
+
+}
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        EnuFrame constructor
+// Description: Constructs a local east-north frame tangent to the WGS84
+//              ellipsoid at an origin.
+// Arguments:   - origin_lat: origin latitude in degrees
+//              - origin_lon: origin longitude in degrees
+//------------------------------------------------------------------------------
+EnuFrame::EnuFrame(double origin_lat, double origin_lon) :
+    origin_lat(origin_lat), origin_lon(origin_lon)
+{
+
+    // Meridian and prime vertical radii of curvature at the origin
+    double sin_lat = std::sin(origin_lat * DEGREES_TO_RADIANS);
+    double w = std::sqrt(1.0 - WGS84_E2 * sin_lat * sin_lat);
+    double meridian_radius = WGS84_A * (1.0 - WGS84_E2) / (w * w * w);
+    double normal_radius = WGS84_A / w;
+
+    meters_per_lat = meridian_radius * DEGREES_TO_RADIANS;
+    meters_per_lon = normal_radius * std::cos(origin_lat * DEGREES_TO_RADIANS) *
+                     DEGREES_TO_RADIANS;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_origin_lat
+// Description: Gets the latitude of the frame's origin.
+// Returns:     Origin latitude in degrees.
+//------------------------------------------------------------------------------
+double EnuFrame::get_origin_lat() const
+{
+    return origin_lat;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_origin_lon
+// Description: Gets the longitude of the frame's origin.
+// Returns:     Origin longitude in degrees.
+//------------------------------------------------------------------------------
+double EnuFrame::get_origin_lon() const
+{
+    return origin_lon;
+}
+
+//------------------------------------------------------------------------------
+// Name:        to_enu
+// Description: Converts a location to the frame.
+// Arguments:   - lat: latitude in degrees
+//              - lon: longitude in degrees
+//              - east: set to the east offset from the origin in meters
+//              - north: set to the north offset from the origin in meters
+//------------------------------------------------------------------------------
+void EnuFrame::to_enu(double lat, double lon, double& east, double& north) const
+{
+    east = (lon - origin_lon) * meters_per_lon;
+    north = (lat - origin_lat) * meters_per_lat;
+}
+
+//------------------------------------------------------------------------------
+// Name:        to_wgs84
+// Description: Converts a point in the frame to a location.
+// Arguments:   - east: east offset from the origin in meters
+//              - north: north offset from the origin in meters
+//              - lat: set to the latitude in degrees
+//              - lon: set to the longitude in degrees
+//------------------------------------------------------------------------------
+void EnuFrame::to_wgs84(double east, double north, double& lat, double& lon) const
+{
+    lat = origin_lat + north / meters_per_lat;
+    lon = origin_lon + east / meters_per_lon;
+}
+
+} // namespace geo
+
+} // namespace avl
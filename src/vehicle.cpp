@@ -14,6 +14,15 @@
 
 #include "graphics.h"
 
+// Telemetry history timestamps
+#include <QDateTime>
+
+// Mission segment lengths
+#include "util/geo.h"
+
+// QtCharts series for plotting telemetry history
+#include <QtCharts/QXYSeries>
+
 //==============================================================================
 //                              CLASS DEFINITION
 //==============================================================================
@@ -46,6 +55,15 @@ Vehicle::Vehicle(QString ip_address, quint16 port, QObject* parent) :
     path_overlay = std::shared_ptr<GraphicsOverlay>(new GraphicsOverlay(this));
     mission_overlay = std::shared_ptr<GraphicsOverlay>(new GraphicsOverlay(this));
     geofence_overlay = std::shared_ptr<GraphicsOverlay>(new GraphicsOverlay(this));
+    path = new VehiclePath(path_overlay.get(), &graphic_index, MAX_PATH_POINTS, this);
+    path->set_color(color);
+    mission_graphics = new MissionGraphics(mission_overlay.get(), &graphic_index, this);
+    mission_graphics->set_color(color);
+
+    // Survey paths are generated in the background and written into the
+    // mission while it is being drawn, so the mission is updated afterwards
+    connect(mission_graphics, &MissionGraphics::surveyChanged,
+            this, &Vehicle::mission_changed, Qt::QueuedConnection);
 
     //Initialize Geofence
 
@@ -53,6 +71,10 @@ Vehicle::Vehicle(QString ip_address, quint16 port, QObject* parent) :
     // Configure the mission time timer
     connect(mission_time_timer, &QTimer::timeout, this, &Vehicle::mission_time_timer_timeout);
 
+    // Configure the ping timer for clock offset estimation
+    connect(ping_timer, &QTimer::timeout, this, &Vehicle::ping_timer_timeout);
+    ping_timer->start(PING_INTERVAL_MS);
+
     // Conect the mission changed signal of the vehcle's mission to the
     // slot on the vehicle so that the mission graphic can be updated when the
     // mission changes
@@ -81,6 +103,7 @@ void Vehicle::declare_qml()
 {
     qmlRegisterInterface<Vehicle>("Vehicle");
     qRegisterMetaType<VehicleStatus>("VehicleStatus");
+    qRegisterMetaType<LinkStats>("LinkStats");
 }
 
 //------------------------------------------------------------------------------
@@ -127,8 +150,7 @@ void Vehicle::clear_vehicle_responses()
 //------------------------------------------------------------------------------
 void Vehicle::clear_path()
 {
-    path.clear();
-    path_overlay->graphics()->clear();
+    path->clear();
 }
 
 //------------------------------------------------------------------------------
@@ -255,6 +277,19 @@ double Vehicle::get_mission_duration()
     return mission_duration;
 }
 
+//------------------------------------------------------------------------------
+// Name:        get_waypoint_eta
+// Description: Gets the estimated time from the start of the mission
+//              that a mission waypoint is reached.
+// Arguments:   - task_index: index of the waypoint's task in the mission
+//              - point_index: index of the waypoint in its task
+// Returns:     Time in seconds, or NaN if there is no such waypoint.
+//------------------------------------------------------------------------------
+double Vehicle::get_waypoint_eta(int task_index, int point_index)
+{
+    return mission_estimator.get_eta(task_index, point_index);
+}
+
 
 //------------------------------------------------------------------------------
 // Name:        get_vehicle_responses
@@ -297,6 +332,79 @@ std::shared_ptr<GraphicsOverlay> Vehicle::get_geofence_overlay()
     return geofence_overlay;
 }
 
+//------------------------------------------------------------------------------
+// Name:        get_history
+// Description: Gets the vehicle's telemetry history for reading.
+// Returns:     Reference to the vehicle's telemetry history.
+//------------------------------------------------------------------------------
+const TelemetryHistory& Vehicle::get_history()
+{
+    return history;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_history_size
+// Description: Gets the number of samples in the telemetry history.
+// Returns:     Number of telemetry history samples.
+//------------------------------------------------------------------------------
+int Vehicle::get_history_size()
+{
+    return static_cast<int>(history.size());
+}
+
+//------------------------------------------------------------------------------
+// Name:        fill_history_series
+// Description: Replaces the points of a QtCharts XY series (such as a
+//              QML LineSeries) with the recent history of a telemetry
+//              channel. X values are in milliseconds since epoch for use
+//              with a DateTimeAxis. Does nothing if the object is not an
+//              XY series.
+// Arguments:   - series: XY series to fill
+//              - channel: telemetry channel to plot
+//              - duration: length of the history to plot in seconds
+//------------------------------------------------------------------------------
+void Vehicle::fill_history_series(QObject* series, TelemetryChannel::Value channel,
+                                  double duration)
+{
+
+    QtCharts::QXYSeries* xy_series = qobject_cast<QtCharts::QXYSeries*>(series);
+    if (xy_series == nullptr || history.size() == 0)
+        return;
+
+    // Find the samples in the requested window ending at the newest sample
+    double end_time = history.get_time(history.size() - 1);
+    size_t first, last;
+    history.find_range(end_time - duration, end_time, first, last);
+
+    // Read the timestamp and channel spans directly from the ring buffers.
+    // Both are split at the same place since they share slots
+    TelemetryHistory::Span time_spans[2];
+    TelemetryHistory::Span value_spans[2];
+    history.get_time_spans(first, last, time_spans);
+    history.get_channel_spans(static_cast<size_t>(channel), first, last, value_spans);
+
+    // Samples without a value for the channel (NaN) are skipped so that they
+    // do not break the line
+    QVector<QPointF> points;
+    points.reserve(static_cast<int>(last - first));
+    for (int s = 0; s < 2; s++)
+        for (size_t i = 0; i < time_spans[s].size; i++)
+            if (!std::isnan(value_spans[s].data[i]))
+                points.append(QPointF(time_spans[s].data[i] * 1000.0, value_spans[s].data[i]));
+
+    xy_series->replace(points);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        clear_history
+// Description: Clears the vehicle's telemetry history.
+//------------------------------------------------------------------------------
+void Vehicle::clear_history()
+{
+    history.clear();
+}
+
 //------------------------------------------------------------------------------
 // Name:        set_vehicle_color
 // Description: Sets the vehicle's icon and path color.
@@ -306,12 +414,159 @@ void Vehicle::set_vehicle_color(QColor new_color)
 {
 
     color = new_color;
+    path->set_color(color);
+    mission_graphics->set_color(color);
 
     // Call the mission changed slot to redraw the mission with the new color
     mission_changed();
 
 }
 
+//------------------------------------------------------------------------------
+// Name:        set_path_resolution
+// Description: Sets the map resolution that the vehicle's path is drawn
+//              at, which selects the path's level of detail.
+// Arguments:   - meters_per_pixel: ground distance covered by one pixel
+//                on the map in meters
+//------------------------------------------------------------------------------
+void Vehicle::set_path_resolution(double meters_per_pixel)
+{
+    path->set_resolution(meters_per_pixel);
+}
+
+//------------------------------------------------------------------------------
+// Name:        set_render_scheduler
+// Description: Sets the scheduler that the vehicle's graphics updates are
+//              deferred to. Without one the graphics are updated
+//              immediately.
+// Arguments:   - render_scheduler: pointer to the render scheduler
+//------------------------------------------------------------------------------
+void Vehicle::set_render_scheduler(RenderScheduler* render_scheduler)
+{
+    this->render_scheduler = render_scheduler;
+}
+
+//------------------------------------------------------------------------------
+// Name:        render
+// Description: Updates the out of date parts of the vehicle's graphics.
+// Arguments:   - flags: bitwise OR of RenderScheduler dirty flags
+//------------------------------------------------------------------------------
+void Vehicle::render(int flags)
+{
+
+    if (flags & RenderScheduler::DIRTY_PATH)
+        path->redraw_tail();
+
+    if (flags & RenderScheduler::DIRTY_ICON)
+        path->redraw_icon();
+
+    if (flags & RenderScheduler::DIRTY_MISSION)
+        mission_graphics->update(&mission);
+
+    // Only the legs next to the dragged waypoint change, so the estimator
+    // drives just those legs to preview the mission distance and time until
+    // the mission is simulated again when the drag ends
+    if ((flags & RenderScheduler::DIRTY_DRAG) && !drag_task.isNull())
+    {
+        mission_graphics->preview_point(drag_task, drag_point_index, drag_location);
+        double duration;
+        double distance;
+        if (mission_estimator.preview_point(drag_task, drag_point_index, drag_location,
+                                            duration, distance))
+        {
+            mission_distance = distance / 1000.0;
+            mission_duration = duration;
+            emit missionDistanceChanged(id, mission_distance);
+            emit missionDurationChanged(id, mission_duration);
+        }
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        begin_waypoint_drag
+// Description: Starts dragging a waypoint of the vehicle's mission. Until
+//              the drag ends, moves only redraw the waypoint and its
+//              neighbouring segments and leave the mission unchanged.
+// Arguments:   - task_index: index of the waypoint's task in the mission
+//              - point_index: index of the waypoint in its task
+// Returns:     True if the drag started.
+//------------------------------------------------------------------------------
+bool Vehicle::begin_waypoint_drag(int task_index, int point_index)
+{
+
+    if (task_index < 0 || task_index >= mission.size())
+        return false;
+
+    Task* task = mission.get(task_index);
+    int num_points = task->get_num_points();
+    if (point_index < 0 || point_index >= num_points)
+        return false;
+
+    drag_task = task;
+    drag_point_index = point_index;
+    drag_location = task->get_point(point_index);
+
+    return true;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        drag_waypoint
+// Description: Moves the dragged waypoint. The preview is redrawn on the
+//              next frame, so moves between frames cost one redraw.
+// Arguments:   - location: new waypoint location with longitude as x and
+//                latitude as y
+//------------------------------------------------------------------------------
+void Vehicle::drag_waypoint(QPointF location)
+{
+    if (drag_task.isNull())
+        return;
+    drag_location = location;
+    request_render(RenderScheduler::DIRTY_DRAG);
+}
+
+//------------------------------------------------------------------------------
+// Name:        end_waypoint_drag
+// Description: Ends the waypoint drag and moves the waypoint in the
+//              mission to its last dragged location.
+// Returns:     Final waypoint location with longitude as x and latitude
+//              as y.
+//------------------------------------------------------------------------------
+QPointF Vehicle::end_waypoint_drag()
+{
+
+    if (drag_task.isNull())
+        return drag_location;
+
+    // The drag is cleared before the task is edited so that a preview still
+    // waiting for a frame does not move the graphics after the mission
+    // update. Editing the task recalculates the mission once
+    Task* task = drag_task;
+    drag_task.clear();
+    task->edit_point(drag_point_index, drag_location);
+    drag_point_index = -1;
+
+    return drag_location;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        find_graphic
+// Description: Finds the vehicle's waypoint or icon graphic nearest to a
+//              map location.
+// Arguments:   - location: location to search around with longitude as x
+//                and latitude as y
+//              - radius: search radius in meters
+//              - distance: set to the distance in meters to the graphic
+//                that is found, if not null
+// Returns:     Nearest graphic, or null if none is within the radius.
+//------------------------------------------------------------------------------
+Graphic* Vehicle::find_graphic(QPointF location, double radius, double* distance)
+{
+    return graphic_index.find_nearest(location, radius, distance);
+}
+
 //------------------------------------------------------------------------------
 // Name:        set_vehicle_type
 // Description: Sets the vehicle's type.
@@ -334,20 +589,33 @@ void Vehicle::set_vehicle_status(VehicleStatus new_status)
     // Set the new status
     status = new_status;
 
+    // Record the status in the telemetry history, in channel order
+    double sample[TelemetryChannel::NUM_CHANNELS];
+    sample[TelemetryChannel::TELEMETRY_LAT] =          status.lat;
+    sample[TelemetryChannel::TELEMETRY_LON] =          status.lon;
+    sample[TelemetryChannel::TELEMETRY_ALT] =          status.alt;
+    sample[TelemetryChannel::TELEMETRY_DEPTH] =        status.depth;
+    sample[TelemetryChannel::TELEMETRY_HEIGHT] =       status.height;
+    sample[TelemetryChannel::TELEMETRY_ROLL] =         status.roll;
+    sample[TelemetryChannel::TELEMETRY_PITCH] =        status.pitch;
+    sample[TelemetryChannel::TELEMETRY_YAW] =          status.yaw;
+    sample[TelemetryChannel::TELEMETRY_VX] =           status.vx;
+    sample[TelemetryChannel::TELEMETRY_VY] =           status.vy;
+    sample[TelemetryChannel::TELEMETRY_VZ] =           status.vz;
+    sample[TelemetryChannel::TELEMETRY_RPM] =          status.rpm;
+    sample[TelemetryChannel::TELEMETRY_VOLTAGE] =      status.voltage;
+    sample[TelemetryChannel::TELEMETRY_TASK_PERCENT] = status.task_percent;
+    history.append(QDateTime::currentMSecsSinceEpoch() / 1000.0, sample);
+
     // If the new status value has a location, update the vehicle icon and path
     if (!std::isnan(status.lat) && !std::isnan(status.lon))
     {
 
-        // Create a point at the new vehicle location and add it to the path
-        // queue. If the queue is over the max number of points to display,
-        // remove the oldest point (the front of the queue)
-        Point new_location(status.lon, status.lat, SpatialReference::wgs84());
-        path.enqueue(new_location);
-        if (path.size() > MAX_PATH_POINTS)
-            path.dequeue();
-
-        // Update the vehicle and path graphic with the new location
-        get_vehicle_graphic(path_overlay, path, status.yaw, color);
+        // Add the new vehicle location to the path. Its live tail and the
+        // vehicle icon are redrawn on the next frame
+        path->append(QDateTime::currentMSecsSinceEpoch() / 1000.0,
+                     status.lat, status.lon, status.yaw, status.depth);
+        request_render(RenderScheduler::DIRTY_PATH | RenderScheduler::DIRTY_ICON);
 
     }
 
@@ -413,14 +681,16 @@ void Vehicle::save_mission(QString filepath)
         task_node.append_attribute("dive") =     task->get_dive();
         task_node.append_attribute("command") =  ActionType::to_string(task->get_command()).c_str();
 
-        QVector<std::pair<QPointF, ActionType::Value>> points = task->get_points();
-        for (auto point : points)
+        avl::Span<double> lats = task->get_lats();
+        avl::Span<double> lons = task->get_lons();
+        avl::Span<ActionType::Value> commands = task->get_commands();
+        for (size_t i = 0; i < lats.size(); i++)
         {
             xml_node point_node = task_node.append_child("point");
-            point_node.append_attribute("latitude") = point.first.y();
-            point_node.append_attribute("longitude") = point.first.x();
+            point_node.append_attribute("latitude") = lats[i];
+            point_node.append_attribute("longitude") = lons[i];
             point_node.append_attribute("yaw") = NAN;
-            point_node.append_attribute("pcommand") = ActionType::to_string(point.second).c_str();
+            point_node.append_attribute("pcommand") = ActionType::to_string(commands[i]).c_str();
         }
 
     }
@@ -572,47 +842,30 @@ void Vehicle::print_param_list()
 //------------------------------------------------------------------------------
 void Vehicle::mission_changed()
 {
-    get_mission_graphic(mission_overlay.get(), &mission, color);
 
-    // Update Mission Distance and Time
-    mission_distance = 0.0;
-    mission_duration = 0.0;
+    // Redraw the mission on the next frame
+    request_render(RenderScheduler::DIRTY_MISSION);
+
+    // Simulate the legs next to what changed to update the mission distance
+    // and time. The estimator follows the point edits of each task, so the
+    // points are not compared
+    mission_estimator.update(get_mission()->get_all());
+    mission_distance = mission_estimator.get_distance() / 1000.0;
+    mission_duration = mission_estimator.get_time();
 
-    QVector<Task*> current_tasks = get_mission()->get_all();
-    for(auto curr_task:current_tasks)
-    {
-        QVector<std::pair<QPointF, ActionType::Value>> current_points = curr_task->get_points();
-        for(int i = 1; i < current_points.size(); i++)
-        {
-            // Calculate the distance between the current and the point before it
-            mission_distance += calculate_distance(current_points[i].first,
-                                                   current_points[i-1].first);
-        }
-        mission_duration += curr_task->get_duration();
-    }
     emit missionDistanceChanged(id, mission_distance);
     emit missionDurationChanged(id, mission_duration);
 }
 
 double Vehicle::calculate_distance(QPointF start, QPointF end)
 {
-    double R = 6371; // Radius of the earth in km
-    double dLat = degree2rad(end.x() - start.x());  // deg2rad below
-    double dLon = degree2rad(end.y() - start.y());
-    double a =
-            sin(dLat/2) * sin(dLat/2) +
-            cos(degree2rad(start.x())) * cos(degree2rad(end.x())) *
-            sin(dLon/2) * sin(dLon/2);
-
-    double c = 2 * atan2(sqrt(a), sqrt(1-a));
-    double d = R * c; // Distance in km
-    return d;
+    // Points hold the longitude as x and the latitude as y
+    return avl::geo::distance(start.y(), start.x(), end.y(), end.x()) / 1000.0;
 }
 
 double Vehicle::degree2rad(double deg)
 {
-    double pi = 3.14159265;
-    return deg * (pi/180);
+    return deg * avl::geo::DEGREES_TO_RADIANS;
 }
 
 //------------------------------------------------------------------------------
@@ -626,6 +879,18 @@ void Vehicle::mission_time_timer_timeout()
     emit missionTimeChanged(id, mission_time);
 }
 
+//------------------------------------------------------------------------------
+// Name:        ping_timer_timeout
+// Description: Slot that is called when the ping timer times out. Pings
+//              the vehicle over the radio to update the clock offset
+//              estimate if the vehicle is connected.
+//------------------------------------------------------------------------------
+void Vehicle::ping_timer_timeout()
+{
+    if (is_connected())
+        send_clock_ping(CommsChannel::COMMS_RADIO, id);
+}
+
 //--------------------------------------------------------------------------
 // Name:        parse_populate_mission
 // Description: parses and populates the mission as received from the vehicle.
@@ -648,3 +913,18 @@ void Vehicle::geofence_changed(QVector<QPointF> geofencePoints)
     for(auto point:geofencePoints)
         qDebug() <<point.x()<<point.y()<<endl;
 }
+
+//------------------------------------------------------------------------------
+// Name:        request_render
+// Description: Marks parts of the vehicle's graphics as out of date in
+//              the render scheduler, or updates them immediately if there
+//              is no scheduler.
+// Arguments:   - flags: bitwise OR of RenderScheduler dirty flags
+//------------------------------------------------------------------------------
+void Vehicle::request_render(int flags)
+{
+    if (render_scheduler != nullptr)
+        render_scheduler->mark_dirty(id, flags);
+    else
+        render(flags);
+}
@@ -16,6 +16,13 @@
 
 #include <QPointF>
 
+// Packet receive timestamps
+#include <QDateTime>
+
+// Util functions
+#include "util/byte.h"
+#include "util/vector.h"
+
 //==============================================================================
 //                              CLASS DEFINITION
 //==============================================================================
@@ -26,6 +33,15 @@
 //------------------------------------------------------------------------------
 VehicleConnection::VehicleConnection(QObject* parent) : QObject(parent)
 {
+
+    // Create empty link statistics for each comms channel
+    reset_link_stats();
+
+    // Signal link statistics changes once per interval. The status ages
+    // change with time, so the statistics change even without packets
+    connect(link_stats_timer, &QTimer::timeout, this, &VehicleConnection::linkStatsChanged);
+    link_stats_timer->start(LINK_STATS_INTERVAL_MS);
+
     // Create the TCP socket
     tcp_socket = new QTcpSocket();
 
@@ -58,6 +74,11 @@ VehicleConnection::~VehicleConnection()
 //------------------------------------------------------------------------------
 void VehicleConnection::open(QString ip_address, quint16 port)
 {
+    if (replayed)
+    {
+        qDebug() << "not connecting to replayed vehicle " << ip_address;
+        return;
+    }
     if (tcp_socket->state() == QAbstractSocket::UnconnectedState)
     {
         m_ip_address = ip_address;
@@ -87,6 +108,31 @@ bool VehicleConnection::is_connected()
     return tcp_socket->state() == QAbstractSocket::ConnectedState;
 }
 
+//------------------------------------------------------------------------------
+// Name:        set_replayed
+// Description: Marks the connection as belonging to a vehicle that only
+//              exists in replayed traffic. A replayed connection is closed
+//              and never opens or clock pings, so a replay sends nothing
+//              to the real vehicle with the same address.
+// Arguments:   - replayed: true if the vehicle is replayed
+//------------------------------------------------------------------------------
+void VehicleConnection::set_replayed(bool replayed)
+{
+    this->replayed = replayed;
+    if (replayed)
+        close();
+}
+
+//------------------------------------------------------------------------------
+// Name:        is_replayed
+// Description: Checks whether the vehicle only exists in replayed traffic.
+// Returns:     True if the vehicle is replayed, false otherwise.
+//------------------------------------------------------------------------------
+bool VehicleConnection::is_replayed()
+{
+    return replayed;
+}
+
 //----------------------------------------------------------------------------
 // Name:        get_connection_status
 // Description: Returns a string representing the status of the vehicle
@@ -98,6 +144,18 @@ QString VehicleConnection::get_connection_status()
     return connection_status;
 }
 
+//------------------------------------------------------------------------------
+// Name:        set_packet_recorder
+// Description: Sets the recorder that all raw traffic to and from the
+//              vehicle is recorded to.
+// Arguments:   - recorder: pointer to the packet recorder, or nullptr to
+//                stop recording
+//------------------------------------------------------------------------------
+void VehicleConnection::set_packet_recorder(PacketRecorder* recorder)
+{
+    packet_recorder = recorder;
+}
+
 //------------------------------------------------------------------------------
 // Name:        send_emergency_stop
 // Description: Sends an emergency stop command to the vehicle.
@@ -110,6 +168,39 @@ void VehicleConnection::send_emergency_stop(CommsChannel::Value comms_channel,
     write_packet(packet, comms_channel, vehicle_id);
 }
 
+//------------------------------------------------------------------------------
+// Name:        send_ping
+// Description: Sends a plain ping to the vehicle, whose response is shown
+//              to the operator.
+//------------------------------------------------------------------------------
+void VehicleConnection::send_ping(CommsChannel::Value comms_channel,
+                                  int vehicle_id)
+{
+    avl::Packet packet = ACTION_PACKET();
+    packet.add_field(ACTION_PING());
+    write_packet(packet, comms_channel, vehicle_id);
+    operator_pings_pending++;
+}
+
+//------------------------------------------------------------------------------
+// Name:        send_clock_ping
+// Description: Sends a ping carrying the current time to the vehicle. The
+//              vehicle's timestamped response only updates the clock offset
+//              estimate, so it is not shown to the operator. Vehicles that
+//              have responded to a clock ping with text rather than
+//              timestamps are not pinged again.
+//------------------------------------------------------------------------------
+void VehicleConnection::send_clock_ping(CommsChannel::Value comms_channel,
+                                        int vehicle_id)
+{
+    if (replayed || !timestamped_pings)
+        return;
+    avl::Packet packet = ACTION_PACKET();
+    packet.add_field(ACTION_PING(QDateTime::currentMSecsSinceEpoch() / 1000.0));
+    write_packet(packet, comms_channel, vehicle_id);
+    clock_pings_pending++;
+}
+
 //------------------------------------------------------------------------------
 // Name:        send_enable_helm_mode
 // Description: Sends an enable helm mode command to the vehicle.
@@ -214,9 +305,10 @@ void VehicleConnection::send_write_params(Params* parameters,
                                           CommsChannel::Value comms_channel,
                                           int vehicle_id)
 {
+    std::vector<avl::Packet> parameter_packets = parameters->get_params();
     avl::Packet packet_list = PARAMETER_LIST_PACKET();
-    packet_list.add_field(PARAMETER_LIST(parameters->get_params()));
-    packet_list.add_field(PARAMETER_LIST_SIZE(1));
+    packet_list.add_field(PARAMETER_LIST(parameter_packets));
+    packet_list.add_field(PARAMETER_LIST_SIZE(static_cast<int>(parameter_packets.size())));
     write_packet(packet_list, comms_channel, vehicle_id);
 }
 
@@ -537,8 +629,30 @@ void VehicleConnection::tcp_state_changed(QAbstractSocket::SocketState state)
 void VehicleConnection::tcp_read_data_ready()
 {
 
-    // Read all available bytes and turn the byte array into a vector
+    // Read all available bytes
     QByteArray data = tcp_socket->readAll();
+
+    // Record the raw bytes before parsing so that invalid data is kept
+    if (packet_recorder != nullptr)
+        packet_recorder->record(PacketRecorder::INTERFACE_TCP, PacketRecorder::DIRECTION_IN,
+                                tcp_socket->peerAddress().toIPv4Address(), tcp_socket->peerPort(),
+                                data.constData(), static_cast<size_t>(data.size()));
+
+    process_tcp_data(data);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        process_tcp_data
+// Description: Parses and handles bytes received from the vehicle over TCP.
+//              Called with live data by the TCP socket's read slot and with
+//              recorded data during replay.
+// Arguments:   - data: bytes received from the vehicle
+//------------------------------------------------------------------------------
+void VehicleConnection::process_tcp_data(const QByteArray& data)
+{
+
+    // Turn the byte array into a vector
     std::vector<uint8_t> data_bytes(data.begin(), data.end());
 
     try
@@ -550,6 +664,9 @@ void VehicleConnection::tcp_read_data_ready()
         // Handle all packets in the packet vector
         for (avl::Packet packet: packets)
         {
+
+            record_packet_received(packet, static_cast<int>(packet.get_bytes().size()));
+
             // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
             // Handle response packets
 
@@ -558,7 +675,66 @@ void VehicleConnection::tcp_read_data_ready()
                 if(packet.has_field(RESPONSE_FIELD_DESCRIPTOR_DESC))
                 {
                     uint8_t response_packet_descriptor = packet.get_field(RESPONSE_FIELD_DESCRIPTOR_DESC).get_data().at(0);
-                    if (response_packet_descriptor == MISSION_READ_ALL_DESC)
+
+                    // Field descriptors are only unique within a packet
+                    // type, so the responses with binary data are matched
+                    // on the packet descriptor as well when there is one
+                    int command_packet_descriptor = -1;
+                    if (packet.has_field(RESPONSE_PACKET_DESCRIPTOR_DESC))
+                        command_packet_descriptor = packet.get_field(RESPONSE_PACKET_DESCRIPTOR_DESC).get_data().at(0);
+
+                    // Timestamped ping responses carry the ping originate,
+                    // receive, and transmit times as three doubles. Older
+                    // vehicles respond with text, which is handled below
+                    if (response_packet_descriptor == ACTION_PING_DESC &&
+                        command_packet_descriptor == ACTION_PACKET_DESC &&
+                        packet.has_field(RESPONSE_DATA_DESC) &&
+                        packet.get_field(RESPONSE_DATA_DESC).get_data().size() == 3*sizeof(double))
+                    {
+                        double t3 = QDateTime::currentMSecsSinceEpoch() / 1000.0;
+                        std::vector<uint8_t> times = packet.get_field(RESPONSE_DATA_DESC).get_data();
+                        double t0 = avl::from_bytes<double>(avl::subvector(times,0,8));
+                        double t1 = avl::from_bytes<double>(avl::subvector(times,8,8));
+                        double t2 = avl::from_bytes<double>(avl::subvector(times,16,8));
+
+                        // A replayed response did not arrive now, so it
+                        // says nothing about the clock offset
+                        if (replayed)
+                            continue;
+                        if (!clock_sync.add_sample(t0, t1, t2, t3))
+                            qDebug() << "ignoring inconsistent ping response received by vehicle " << m_ip_address;
+
+                        // A timestamped response that no clock ping is
+                        // waiting for answers the operator, who is shown
+                        // the round trip time
+                        if (clock_pings_pending > 0)
+                        {
+                            clock_pings_pending--;
+                        }
+                        else if (packet.has_field(VEHICLE_ID_DESC))
+                        {
+                            if (operator_pings_pending > 0)
+                                operator_pings_pending--;
+                            int origin_vehicle_id = static_cast<int>(packet.get_field(VEHICLE_ID_DESC).get_data().at(0));
+                            emit vehicleResponseReceived(origin_vehicle_id,
+                                QString("ping response, round trip %1 ms").arg((t3 - t0) * 1000.0, 0, 'f', 1));
+                        }
+                    }
+
+                    // A text response to a clock ping means the vehicle does
+                    // not timestamp pings. It is dropped rather than logged,
+                    // and the vehicle is not clock pinged again. Text
+                    // responses are matched to operator pings first
+                    else if (response_packet_descriptor == ACTION_PING_DESC &&
+                             (command_packet_descriptor == ACTION_PACKET_DESC || command_packet_descriptor < 0) &&
+                             clock_pings_pending > 0 && operator_pings_pending == 0)
+                    {
+                        qDebug() << "vehicle " << m_ip_address << " does not timestamp pings, stopping clock pings";
+                        clock_pings_pending = 0;
+                        timestamped_pings = false;
+                    }
+                    else if (response_packet_descriptor == MISSION_READ_ALL_DESC &&
+                             (command_packet_descriptor == MISSION_PACKET_DESC || command_packet_descriptor < 0))
                     {
                         if (packet.has_field(VEHICLE_ID_DESC))
                         {
@@ -571,7 +747,8 @@ void VehicleConnection::tcp_read_data_ready()
                             emit vehicleMissionReceived(origin_vehicle_id, current_mission);
                         }
                     }
-                    else if(response_packet_descriptor == PARAMETER_LIST_REQUEST_DESC)
+                    else if(response_packet_descriptor == PARAMETER_LIST_REQUEST_DESC &&
+                            (command_packet_descriptor == PARAMETER_LIST_PACKET_DESC || command_packet_descriptor < 0))
                     {
                         if(packet.has_field(VEHICLE_ID_DESC))
                         {
@@ -598,6 +775,8 @@ void VehicleConnection::tcp_read_data_ready()
                     }
                     else if (packet.has_field(RESPONSE_DATA_DESC))
                     {
+                        if (response_packet_descriptor == ACTION_PING_DESC && operator_pings_pending > 0)
+                            operator_pings_pending--;
                         if (packet.has_field(VEHICLE_ID_DESC))
                         {
                             int origin_vehicle_id = static_cast<int>(packet.get_field(VEHICLE_ID_DESC).get_data().at(0));
@@ -631,8 +810,14 @@ void VehicleConnection::tcp_read_data_ready()
         }
 
     }
+    catch (const avl::ChecksumError& ex)
+    {
+        record_invalid_packet(data.size(), true);
+        qDebug() << "ignoring invalid packet (" << ex.what() << ")";
+    }
     catch (const std::exception& ex)
     {
+        record_invalid_packet(data.size(), false);
         qDebug() << "ignoring invalid packet (" << ex.what() << ")";
     }
 
@@ -735,6 +920,11 @@ void VehicleConnection::write(std::vector<uint8_t> data)
         std::string data_string(data.begin(),data.end());
         tcp_socket->write(data_string.c_str(), static_cast<quint16>(data_string.length()));
         tcp_socket->waitForBytesWritten();
+
+        if (packet_recorder != nullptr)
+            packet_recorder->record(PacketRecorder::INTERFACE_TCP, PacketRecorder::DIRECTION_OUT,
+                                    tcp_socket->peerAddress().toIPv4Address(), tcp_socket->peerPort(),
+                                    data.data(), data.size());
     }
 }
 
@@ -750,12 +940,144 @@ void VehicleConnection::write_packet(avl::Packet packet, CommsChannel::Value com
                                      int vehicle_id)
 {
     packet.add_field(VEHICLE_ID(static_cast<uint8_t>(vehicle_id)));
-    qDebug() <<"inside write packet";
     switch (comms_channel)
     {
         case CommsChannel::Value::COMMS_RADIO:    packet.add_field(COMMS_CHANNEL(COMMS_CHANNEL_RADIO)); break;
         case CommsChannel::Value::COMMS_ACOUSTIC: packet.add_field(COMMS_CHANNEL(COMMS_CHANNEL_ACOMMS)); break;
         case CommsChannel::Value::COMMS_IRIDIUM:  packet.add_field(COMMS_CHANNEL(COMMS_CHANNEL_IRIDIUM)); break;
     }
-    write(packet.get_bytes());
+
+    std::vector<uint8_t> packet_bytes = packet.get_bytes();
+    if (tcp_socket->state() == QTcpSocket::ConnectedState)
+        link_stats[comms_channel].record_packet_out(static_cast<int>(packet_bytes.size()));
+    write(packet_bytes);
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_link_stats
+// Description: Gets the link statistics for one of the comms channels,
+//              with the status age updated to the current time.
+// Arguments:   - comms_channel: comms channel to get statistics for
+// Returns:     Link statistics for the comms channel.
+//------------------------------------------------------------------------------
+LinkStats VehicleConnection::get_link_stats(CommsChannel::Value comms_channel)
+{
+    LinkStats stats = link_stats.at(comms_channel);
+    stats.update_status_age(QDateTime::currentMSecsSinceEpoch());
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_link_stats_list
+// Description: Gets the link statistics for every comms channel, with
+//              the status ages updated to the current time.
+// Returns:     List of link statistics indexed by comms channel.
+//------------------------------------------------------------------------------
+QVariantList VehicleConnection::get_link_stats_list()
+{
+    qint64 time_ms = QDateTime::currentMSecsSinceEpoch();
+    QVariantList stats_list;
+    for (LinkStats stats : link_stats)
+    {
+        stats.update_status_age(time_ms);
+        stats_list.append(QVariant::fromValue(stats));
+    }
+    return stats_list;
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_clock_offset
+// Description: Gets the estimated offset of the vehicle clock from the
+//              local clock.
+// Returns:     Clock offset in seconds, or NaN if the vehicle has not
+//              responded to a timestamped ping.
+//------------------------------------------------------------------------------
+double VehicleConnection::get_clock_offset()
+{
+    return clock_sync.get_offset();
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_clock_delay
+// Description: Gets the round trip delay of the ping the clock offset
+//              was estimated from. Half of it bounds the offset error.
+// Returns:     Round trip delay in seconds, or NaN if the vehicle has
+//              not responded to a timestamped ping.
+//------------------------------------------------------------------------------
+double VehicleConnection::get_clock_delay()
+{
+    return clock_sync.get_delay();
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_data_age
+// Description: Gets the age of data timestamped by the vehicle, correcting
+//              for the vehicle clock offset when it is known.
+// Arguments:   - timestamp: vehicle timestamp in seconds since epoch
+// Returns:     Age of the data in seconds, or NaN if the timestamp is NaN.
+//------------------------------------------------------------------------------
+double VehicleConnection::get_data_age(double timestamp)
+{
+    return QDateTime::currentMSecsSinceEpoch() / 1000.0 - clock_sync.to_local_time(timestamp);
+}
+
+//------------------------------------------------------------------------------
+// Name:        reset_link_stats
+// Description: Clears the link statistics for all comms channels.
+//------------------------------------------------------------------------------
+void VehicleConnection::reset_link_stats()
+{
+    link_stats.clear();
+    link_stats.append(LinkStats(CommsChannel::Value::COMMS_RADIO));
+    link_stats.append(LinkStats(CommsChannel::Value::COMMS_ACOUSTIC));
+    link_stats.append(LinkStats(CommsChannel::Value::COMMS_IRIDIUM));
+    emit linkStatsChanged();
+}
+
+//------------------------------------------------------------------------------
+// Name:        record_packet_received
+// Description: Records a valid packet received from the vehicle in the
+//              statistics of the channel it was sent over.
+// Arguments:   - packet: packet that was received
+//              - num_bytes: total number of bytes in the packet
+//------------------------------------------------------------------------------
+void VehicleConnection::record_packet_received(avl::Packet& packet, int num_bytes)
+{
+
+    qint64 time_ms = QDateTime::currentMSecsSinceEpoch();
+    bool is_status = packet.get_descriptor() == STATUS_PACKET_DESC;
+
+    CommsChannel::Value comms_channel = LinkStats::get_packet_channel(packet);
+    link_stats[comms_channel].record_packet_in(num_bytes, is_status, time_ms);
+
+    // Timestamped statuses also give the latency of the link, measured in
+    // local time using the vehicle clock offset. Replayed statuses did not
+    // arrive now, so they have no latency
+    if (is_status && !replayed && packet.has_field(STATUS_TIMESTAMP_DESC))
+    {
+        std::vector<uint8_t> field_data = packet.get_field(STATUS_TIMESTAMP_DESC).get_data();
+        if (field_data.size() == sizeof(double))
+        {
+            double timestamp = avl::from_bytes<double>(field_data);
+            link_stats[comms_channel].record_latency(time_ms / 1000.0 - clock_sync.to_local_time(timestamp));
+        }
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        record_invalid_packet
+// Description: Records received bytes that could not be parsed into a
+//              packet. The channel cannot be read from invalid bytes, so
+//              they are recorded in the radio statistics.
+// Arguments:   - num_bytes: number of bytes that were discarded
+//              - checksum_failure: true if the bytes failed checksum
+//                validation, false for any other parse error
+//------------------------------------------------------------------------------
+void VehicleConnection::record_invalid_packet(int num_bytes, bool checksum_failure)
+{
+    if (checksum_failure)
+        link_stats[CommsChannel::Value::COMMS_RADIO].record_checksum_failure(num_bytes);
+    else
+        link_stats[CommsChannel::Value::COMMS_RADIO].record_parse_error(num_bytes);
 }
@@ -9,6 +9,35 @@
 
 #include "vehicle_manager.h"
 
+// Deckbox range and heading
+#include "util/geo.h"
+
+// Recording file location
+#include <QDateTime>
+#include <QDir>
+#include <QStandardPaths>
+
+// Background pass heading search
+#include <QFutureWatcher>
+#include <QPointer>
+
+//------------------------------------------------------------------------------
+// Name:        get_zone_outline
+// Description: Gets the outline of a zone task.
+// Arguments:   - zone_task: zone task
+// Returns:     Zone outline with longitude as x and latitude as y.
+//------------------------------------------------------------------------------
+static std::vector<QPointF> get_zone_outline(Task* zone_task)
+{
+    avl::Span<double> lats = zone_task->get_lats();
+    avl::Span<double> lons = zone_task->get_lons();
+    std::vector<QPointF> outline;
+    outline.reserve(lats.size());
+    for (size_t i = 0; i < lats.size(); i++)
+        outline.push_back(QPointF(lons[i], lats[i]));
+    return outline;
+}
+
 //==============================================================================
 //                              CLASS DEFINITION
 //==============================================================================
@@ -37,6 +66,27 @@ VehicleManager::VehicleManager(VehicleDataModel* vehicle_data_model,
     udp_socket.bind(QHostAddress::AnyIPv4, port, QUdpSocket::ShareAddress);
     udp_socket.joinMulticastGroup(QHostAddress(multicast_address));
 
+    // Start the flight recorder in the application data directory. A failure
+    // to record should never stop the vehicles from being controlled, so it
+    // is only logged
+    QDir recording_dir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+    recording_dir.mkpath("recordings");
+    recording_dir.cd("recordings");
+    QString recording_prefix = recording_dir.filePath("avl_" +
+        QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"));
+    try
+    {
+        packet_recorder.start(recording_prefix.toStdString());
+    }
+    catch (const std::exception& ex)
+    {
+        qDebug() << "VehicleManager: packet recording disabled (" << ex.what() << ")";
+    }
+
+    // Display updates are applied once per frame rather than per packet
+    connect(&render_scheduler, &RenderScheduler::renderRequested,
+            this,              &VehicleManager::render_vehicle);
+
     // Fixes the startup problem by adding a default vehicle
     add_default_vehicle();
 
@@ -62,6 +112,8 @@ VehicleManager::~VehicleManager()
 void VehicleManager::add_default_vehicle()
 {
     Vehicle* new_vehicle = new Vehicle(0, 1338);
+    new_vehicle->set_packet_recorder(&packet_recorder);
+    new_vehicle->set_render_scheduler(&render_scheduler);
     vehicle_data_model->start_insert_row();
     vehicle_list.append(new_vehicle);
     vehicle_data_model->stop_insert_row();
@@ -181,14 +233,9 @@ void VehicleManager::select_vehicles(QVector<int> vehicle_ids)
 {
     selected_vehicles = vehicle_ids;
 
-    mission_data_model->mission = get_selected_vehicle()->get_mission();
-    mission_data_model->redraw();
-
-    param_data_model->current_params = get_selected_vehicle()->get_params();
-    param_data_model->redraw();
-
-    geofence_data_model->current_geofence = get_selected_vehicle()->get_geofence();
-    geofence_data_model->redraw();
+    mission_data_model->set_mission(get_selected_vehicle()->get_mission());
+    param_data_model->set_params(get_selected_vehicle()->get_params());
+    geofence_data_model->set_geofence(get_selected_vehicle()->get_geofence());
 
     emit vehicleSelectionChanged(selected_vehicles);
 }
@@ -311,21 +358,6 @@ VehicleStatus VehicleManager::generate_empty_status()
     return VehicleStatus();
 }
 
-//------------------------------------------------------------------------------
-// Name:        move_vehicle_waypoint
-// Description: Edits the position of a waypoint in a vehicle's mission.
-// Arguments:   - vehicle_index: index of the vehicle being edited in the
-//                vehicle list. This is not the vehicle ID
-//              - waypoint_index: index of the waypoint being edited
-//              - new_location: new waypoint location in lat/lon in degrees
-//------------------------------------------------------------------------------
-void VehicleManager::move_vehicle_waypoint(int vehicle_index, int waypoint_index,
-                                           QPointF new_location)
-{
-//    vehicle_list.at(vehicle_index)->get_mission()->move_waypoint(waypoint_index, new_location);
-    mission_data_model->redraw();
-}
-
 //------------------------------------------------------------------------------
 // Name:        get_deckbox_distance
 // Description: Calculates the distance from the deckbox to the vehicle with
@@ -348,14 +380,7 @@ double VehicleManager::get_deckbox_distance(int vehicle_id)
         double lon2 = vehicle->get_vehicle_status().lon;
 
         // Calculate the range
-        double d2r = 3.141592 / 180.0;
-        double dlong = (lon2 - lon1) * d2r;
-        double dlat = (lat2 - lat1) * d2r;
-        double a = pow(sin(dlat/2.0), 2) + cos(lat1*d2r) * cos(lat2*d2r) * pow(sin(dlong/2.0), 2);
-        double c = 2.0 * atan2(sqrt(a), sqrt(1.0-a));
-        double d = 6367000.0 * c;
-
-        return d;
+        return avl::geo::distance(lat1, lon1, lat2, lon2);
 
     }
 
@@ -385,22 +410,171 @@ double VehicleManager::get_deckbox_heading(int vehicle_id)
         double lon2 = vehicle->get_vehicle_status().lon;
 
         // Calculate the heading
-        double d2r = 3.141592 / 180.0;
-        double dLon = (lon2 - lon1) * d2r;
-        double y = sin(dLon) * cos(lat2 * d2r);
-        double x = cos(lat1 * d2r) * sin (lat2 * d2r) - sin(lat1 * d2r) * cos(lat2 * d2r) * cos(dLon);
+        return avl::geo::bearing(lat1, lon1, lat2, lon2);
+
+    }
+
+    return std::nan("");
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        partition_zone
+// Description: Splits a survey zone between its vehicle and the selected
+//              vehicles in bands that take equal time to survey. The
+//              zone task keeps the first band, and every other vehicle
+//              gets a copy of the zone task with its band followed by a
+//              survey path task appended to its mission. Each vehicle's
+//              survey path is then generated in the background. Every
+//              band's path task copies the zone's path task, so the
+//              vehicles survey at the same speed.
+// Arguments:   - vehicle_id: ID of the vehicle whose mission holds the
+//                zone
+//              - task_index: index of the zone task in the mission
+// Returns:     Number of vehicles that the zone was split between, or 0
+//              if the task is not a zone that can be surveyed.
+//------------------------------------------------------------------------------
+int VehicleManager::partition_zone(int vehicle_id, int task_index)
+{
+
+    Vehicle* zone_vehicle = get_vehicle(vehicle_id);
+    if (zone_vehicle == nullptr)
+        return 0;
 
-        double r2d = 180.0 / 3.141592;
-        double heading = atan2(y, x);
-        heading = heading * r2d;
-        heading = heading + 360;
-        heading = fmod(heading, 360);
+    Mission* zone_mission = zone_vehicle->get_mission();
+    if (task_index < 0 || task_index >= zone_mission->size())
+        return 0;
+    Task* zone_task = zone_mission->get(task_index);
+    if (zone_task->get_type() != TaskType::TASK_ZONE)
+        return 0;
 
-        return heading;
+    // The zone's own vehicle always surveys part of it
+    QVector<Vehicle*> vehicles = {zone_vehicle};
+    for (int selected_vehicle_id : selected_vehicles)
+    {
+        Vehicle* vehicle = get_vehicle(selected_vehicle_id);
+        if (vehicle != nullptr && vehicle != zone_vehicle)
+            vehicles.append(vehicle);
+    }
 
+    avl::Span<double> lats = zone_task->get_lats();
+    avl::Span<double> lons = zone_task->get_lons();
+    std::vector<CoveragePlanner::Location> outline;
+    outline.reserve(lats.size());
+    for (size_t i = 0; i < lats.size(); i++)
+        outline.push_back(CoveragePlanner::Location{lats[i], lons[i]});
+    CoveragePlanner planner(zone_task->get_angle(), zone_task->get_swath());
+    std::vector<std::vector<CoveragePlanner::Location>> parts =
+        planner.partition(outline, vehicles.size());
+    if (parts.empty())
+    {
+        qDebug() << "partition_zone: task" << task_index << "of vehicle" << vehicle_id
+                 << "is not a zone that can be surveyed";
+        return 0;
     }
 
-    return std::nan("");
+    // Each part becomes a zone task followed by the survey path task that
+    // its vehicle's mission graphics fill. The paths are generated on the
+    // thread pool, so every vehicle's path is generated at the same time
+    Task* path_task = task_index + 1 < zone_mission->size() ?
+                      zone_mission->get(task_index + 1) : nullptr;
+    for (size_t i = 0; i < parts.size(); i++)
+    {
+
+        QVector<QPointF> part_points;
+        part_points.reserve(static_cast<int>(parts[i].size()));
+        for (const CoveragePlanner::Location& location : parts[i])
+            part_points.append(QPointF(location.lon, location.lat));
+
+        if (i == 0)
+        {
+            zone_task->set_points(part_points);
+            continue;
+        }
+
+        Task* part_zone_task = new Task();
+        part_zone_task->copy_parameters(zone_task);
+        part_zone_task->set_points(part_points);
+
+        Task* part_path_task = new Task();
+        if (path_task != nullptr && path_task->get_type() == TaskType::TASK_PATH)
+            part_path_task->copy_parameters(path_task);
+        else
+            part_path_task->set_type(TaskType::TASK_PATH);
+
+        vehicles[static_cast<int>(i)]->get_mission()->append(part_zone_task);
+        vehicles[static_cast<int>(i)]->get_mission()->append(part_path_task);
+
+    }
+
+    return static_cast<int>(parts.size());
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        optimize_zone_angle
+// Description: Starts searching in the background for the pass heading
+//              that surveys a zone in the least time. The heading is set
+//              on the zone and zoneAngleOptimized is emitted when the
+//              search finishes, unless the zone was removed or its points
+//              changed in the meantime. The zone task's x velocity is
+//              used as the survey speed if it is set.
+// Arguments:   - vehicle_id: ID of the vehicle whose mission holds the
+//                zone
+//              - task_index: index of the zone task in the mission
+// Returns:     True if the search was started, or false if the task is
+//              not a zone task.
+//------------------------------------------------------------------------------
+bool VehicleManager::optimize_zone_angle(int vehicle_id, int task_index)
+{
+
+    Vehicle* vehicle = get_vehicle(vehicle_id);
+    if (vehicle == nullptr || task_index < 0 || task_index >= vehicle->get_mission()->size())
+        return false;
+    Task* zone_task = vehicle->get_mission()->get(task_index);
+    if (zone_task->get_type() != TaskType::TASK_ZONE)
+        return false;
+
+    std::vector<QPointF> outline = get_zone_outline(zone_task);
+
+    double speed = zone_task->get_vx() > 0.0 ? zone_task->get_vx() :
+                                               AngleOptimizer::DEFAULT_SPEED;
+    AngleOptimizer optimizer(zone_task->get_swath(), speed);
+
+    // The best heading is applied when the search finishes, as long as the
+    // zone still exists and was searched with its current points
+    QPointer<Task> task = zone_task;
+    QFutureWatcher<AngleOptimizer::Candidate>* watcher =
+        new QFutureWatcher<AngleOptimizer::Candidate>(this);
+    connect(watcher, &QFutureWatcher<AngleOptimizer::Candidate>::finished, this,
+            [this, watcher, task, outline, vehicle_id, task_index]()
+    {
+
+        watcher->deleteLater();
+
+        AngleOptimizer::Candidate best =
+            AngleOptimizer::get_best(AngleOptimizer::get_candidates(watcher->future()));
+        if (std::isnan(best.time))
+        {
+            qDebug() << "optimize_zone_angle: task" << task_index << "of vehicle" << vehicle_id
+                     << "is not a zone that can be surveyed";
+            return;
+        }
+
+        if (task.isNull() || get_zone_outline(task) != outline)
+        {
+            qDebug() << "optimize_zone_angle: task" << task_index << "of vehicle" << vehicle_id
+                     << "changed during the search";
+            return;
+        }
+
+        task->set_angle(best.angle);
+        emit zoneAngleOptimized(vehicle_id, task_index, best.angle);
+
+    });
+    watcher->setFuture(optimizer.evaluate(outline));
+
+    return true;
 
 }
 
@@ -421,108 +595,174 @@ void VehicleManager::udp_read_data_ready()
 
         // Get the IP address that the datagram was received from
         QString ip_address = datagram.senderAddress().toString();
-
-        // Turn the datagram data into an array of bytes, and
         QByteArray datagram_data = datagram.data();
-        std::vector<uint8_t> data_bytes(datagram_data.begin(),
-                                        datagram_data.end());
 
-        // Attempt to parse the bytes in to a packet. If the bytes are not a
-        // valid packet, ignore them
-        avl::Packet packet;
-        try
-        {
-            packet.set_bytes(data_bytes);
-        }
-        catch (const std::exception& ex)
-        {
-            qDebug() << "udp_read_data_ready: ignoring invalid packet bytes (" << ex.what() << ")";
-            return;
-        }
+        // Record the raw datagram before parsing so that invalid data is kept
+        packet_recorder.record(PacketRecorder::INTERFACE_UDP, PacketRecorder::DIRECTION_IN,
+                               datagram.senderAddress().toIPv4Address(),
+                               static_cast<uint16_t>(datagram.senderPort()),
+                               datagram_data.constData(), static_cast<size_t>(datagram_data.size()));
 
-        // Get the origin vehicle ID from the packet. If it does not have a
-        // vehicle ID field, ignore the packet
-        int origin_vehicle_id;
-        if (packet.has_field(VEHICLE_ID_DESC))
-        {
-            origin_vehicle_id = static_cast<int>(packet.get_field(VEHICLE_ID_DESC).get_data().at(0));
-        }
-        else
-        {
-            qDebug() << "udp_read_data_ready: ignoring packet without vehicle ID from" << ip_address << packet.get_num_fields();
-            return;
-        }
+        process_udp_datagram(datagram_data, ip_address);
 
-        // If the vehicle is not already in the vehicle list, append it
-        if (!has_vehicle(origin_vehicle_id))
-        {
+    }
 
-            Vehicle* new_vehicle = new Vehicle(id_to_ip(origin_vehicle_id), 1338, this);
-            vehicle_data_model->start_insert_row();
-            vehicle_list.append(new_vehicle);
-            vehicle_data_model->stop_insert_row();
+}
 
-            connect(new_vehicle, SIGNAL(connectionStatusChanged(QString, QString, bool)),
-                    this,        SLOT(vehicle_connection_status_changed(QString, QString, bool)));
+//------------------------------------------------------------------------------
+// Name:        process_udp_datagram
+// Description: Parses and handles a datagram received over UDP multicast.
+//              Called with live data by the UDP socket's read slot and with
+//              recorded data during replay. Vehicles first seen in
+//              replayed data are marked as replayed so that they never
+//              connect to the real vehicle. Replayed data is only given to
+//              replayed vehicles and live data only to live vehicles, so a
+//              live vehicle and a recording with the same ID never mix.
+// Arguments:   - datagram_data: bytes in the datagram
+//              - ip_address: IP address the datagram was received from
+//              - replayed: true if the datagram is recorded data
+//------------------------------------------------------------------------------
+void VehicleManager::process_udp_datagram(const QByteArray& datagram_data, QString ip_address,
+                                          bool replayed)
+{
 
-            connect(new_vehicle, SIGNAL(vehicleResponseReceived(int, QString)),
-                    this,        SLOT(vehicle_response_received(int, QString)));
+    // Turn the datagram data into an array of bytes
+    std::vector<uint8_t> data_bytes(datagram_data.begin(),
+                                    datagram_data.end());
 
-            connect(new_vehicle, SIGNAL(vehicleStatusReceived(int, VehicleStatus)),
-                    this,        SLOT(vehicle_status_received(int, VehicleStatus)));
+    // Attempt to parse the bytes in to a packet. If the bytes are not a
+    // valid packet, ignore them
+    avl::Packet packet;
+    try
+    {
+        packet.set_bytes(data_bytes);
+    }
+    catch (const avl::ChecksumError& ex)
+    {
+        int sender_id = ip_to_id(ip_address);
+        if (has_vehicle(sender_id) && get_vehicle(sender_id)->is_replayed() == replayed)
+            vehicle_list[get_vehicle_index(sender_id)]->record_invalid_packet(datagram_data.size(), true);
+        qDebug() << "process_udp_datagram: ignoring invalid packet bytes (" << ex.what() << ")";
+        return;
+    }
+    catch (const std::exception& ex)
+    {
+        int sender_id = ip_to_id(ip_address);
+        if (has_vehicle(sender_id) && get_vehicle(sender_id)->is_replayed() == replayed)
+            vehicle_list[get_vehicle_index(sender_id)]->record_invalid_packet(datagram_data.size(), false);
+        qDebug() << "process_udp_datagram: ignoring invalid packet bytes (" << ex.what() << ")";
+        return;
+    }
 
-            connect(new_vehicle, SIGNAL(vehicleTypeChanged(int, VehicleType::Value)),
-                    this,        SLOT(vehicle_type_changed(int, VehicleType::Value)));
+    // Get the origin vehicle ID from the packet. If it does not have a
+    // vehicle ID field, ignore the packet
+    int origin_vehicle_id;
+    if (packet.has_field(VEHICLE_ID_DESC))
+    {
+        origin_vehicle_id = static_cast<int>(packet.get_field(VEHICLE_ID_DESC).get_data().at(0));
+    }
+    else
+    {
+        qDebug() << "process_udp_datagram: ignoring packet without vehicle ID from" << ip_address << packet.get_num_fields();
+        return;
+    }
 
-            connect(new_vehicle, SIGNAL(missionTimeChanged(int, int)),
-                    this,        SLOT(vehicle_mission_time_changed(int, int)));
+    // If the vehicle is not already in the vehicle list, append it
+    if (!has_vehicle(origin_vehicle_id))
+    {
 
-            connect(new_vehicle, SIGNAL(missionDistanceChanged(int, double)),
-                    this,        SLOT(vehicle_mission_distance_changed(int, double)));
+        Vehicle* new_vehicle = new Vehicle(id_to_ip(origin_vehicle_id), 1338, this);
+        new_vehicle->set_replayed(replayed);
+        new_vehicle->set_packet_recorder(&packet_recorder);
+        new_vehicle->set_render_scheduler(&render_scheduler);
+        vehicle_data_model->start_insert_row();
+        vehicle_list.append(new_vehicle);
+        vehicle_data_model->stop_insert_row();
 
-            connect(new_vehicle, SIGNAL(missionDurationChanged(int, double)),
-                    this,        SLOT(vehicle_mission_duration_changed(int, double)));
+        connect(new_vehicle, SIGNAL(connectionStatusChanged(QString, QString, bool)),
+                this,        SLOT(vehicle_connection_status_changed(QString, QString, bool)));
 
-            connect(new_vehicle, SIGNAL(vehicleMissionReceived(int, Mission*)),
-                    this,        SLOT(vehicle_mission_received(int, Mission*)));
+        connect(new_vehicle, SIGNAL(vehicleResponseReceived(int, QString)),
+                this,        SLOT(vehicle_response_received(int, QString)));
 
-            connect(new_vehicle, SIGNAL(vehicleParameterReceived(int, std::string, std::string, QVariant)),
-                    this,        SLOT(vehicle_param_received(int, std::string, std::string, QVariant)));
+        connect(new_vehicle, SIGNAL(vehicleStatusReceived(int, VehicleStatus)),
+                this,        SLOT(vehicle_status_received(int, VehicleStatus)));
 
-            connect(new_vehicle, SIGNAL(vehicleParameterRefresh(int)),
-                    this,        SLOT(vehicle_param_refresh(int)));
+        connect(new_vehicle, SIGNAL(vehicleTypeChanged(int, VehicleType::Value)),
+                this,        SLOT(vehicle_type_changed(int, VehicleType::Value)));
 
-            connect(new_vehicle, SIGNAL(vehicleParametersFullyReceived(int)),
-                    this,        SLOT(vehicle_parameters_fully_received(int)));
+        connect(new_vehicle, SIGNAL(missionTimeChanged(int, int)),
+                this,        SLOT(vehicle_mission_time_changed(int, int)));
 
-            if (selected_vehicles.empty())
-                select_vehicles({origin_vehicle_id});
+        connect(new_vehicle, SIGNAL(missionDistanceChanged(int, double)),
+                this,        SLOT(vehicle_mission_distance_changed(int, double)));
 
-            emit vehicleAdded(origin_vehicle_id, new_vehicle);
+        connect(new_vehicle, SIGNAL(missionDurationChanged(int, double)),
+                this,        SLOT(vehicle_mission_duration_changed(int, double)));
 
-        }
+        connect(new_vehicle, SIGNAL(vehicleMissionReceived(int, Mission*)),
+                this,        SLOT(vehicle_mission_received(int, Mission*)));
 
-        // If the packet is a status packet and does not have magnetic flux
-        // data, handle the status packet. We do not want to handle magnetic
-        // flux status fields because they are only for calibration
-        if (packet.get_descriptor() == STATUS_PACKET_DESC &&
-            !packet.has_field(STATUS_MAG_FLUX_DESC))
-        {
+        connect(new_vehicle, SIGNAL(vehicleParameterReceived(int, std::string, std::string, QVariant)),
+                this,        SLOT(vehicle_param_received(int, std::string, std::string, QVariant)));
 
-            // Update the vehicle's status
-            VehicleStatus status(packet);
-            int vehicle_index = get_vehicle_index(origin_vehicle_id);
-            vehicle_list[vehicle_index]->set_vehicle_status(status);
-            vehicle_data_model->update_row(vehicle_index);
+        connect(new_vehicle, SIGNAL(vehicleParameterRefresh(int)),
+                this,        SLOT(vehicle_param_refresh(int)));
 
-            emit vehicleStatusUpdated(origin_vehicle_id, status);
+        connect(new_vehicle, SIGNAL(vehicleParametersFullyReceived(int)),
+                this,        SLOT(vehicle_parameters_fully_received(int)));
 
-        }
+        if (selected_vehicles.empty())
+            select_vehicles({origin_vehicle_id});
+
+        emit vehicleAdded(origin_vehicle_id, new_vehicle);
+
+    }
+
+    if (get_vehicle(origin_vehicle_id)->is_replayed() != replayed)
+    {
+        qDebug() << "process_udp_datagram: ignoring" << (replayed ? "replayed" : "live")
+                 << "packet for" << (replayed ? "live" : "replayed") << "vehicle" << origin_vehicle_id;
+        return;
+    }
+
+    // Count the packet in the origin vehicle's link statistics
+    vehicle_list[get_vehicle_index(origin_vehicle_id)]->record_packet_received(packet, datagram_data.size());
+
+    // If the packet is a status packet and does not have magnetic flux
+    // data, handle the status packet. We do not want to handle magnetic
+    // flux status fields because they are only for calibration
+    if (packet.get_descriptor() == STATUS_PACKET_DESC &&
+        !packet.has_field(STATUS_MAG_FLUX_DESC))
+    {
+
+        // Update the vehicle's status. Its table row and the status
+        // displays are updated on the next frame with the latest status
+        VehicleStatus status(packet);
+        int vehicle_index = get_vehicle_index(origin_vehicle_id);
+        vehicle_list[vehicle_index]->set_vehicle_status(status);
+        render_scheduler.mark_dirty(origin_vehicle_id,
+            RenderScheduler::DIRTY_ROW | RenderScheduler::DIRTY_STATUS);
 
     }
 
 }
 
+//------------------------------------------------------------------------------
+// Name:        process_tcp_data
+// Description: Parses and handles bytes received over TCP from a vehicle.
+//              Used during replay. Does nothing if the vehicle is not in
+//              the vehicle list or is a live vehicle.
+// Arguments:   - ip_address: IP address of the vehicle
+//              - data: bytes received from the vehicle
+//------------------------------------------------------------------------------
+void VehicleManager::process_tcp_data(QString ip_address, const QByteArray& data)
+{
+    Vehicle* vehicle = get_vehicle(ip_to_id(ip_address));
+    if (vehicle != nullptr && vehicle->is_replayed())
+        vehicle->process_tcp_data(data);
+}
+
 //--------------------------------------------------------------------------
 // Name:        vehicle_connection_status_changed
 // Description: Slot that is called when the connection status of a vehicle
@@ -597,12 +837,34 @@ void VehicleManager::vehicle_parameters_fully_received(int origin_vehicle_id)
     if(has_vehicle(origin_vehicle_id))
     {
         vehicle_list[get_vehicle_index(origin_vehicle_id)]->print_param_list();
-
-        param_data_model->current_params = get_selected_vehicle()->get_params();
-        param_data_model->redraw();
     }
 }
 
+//------------------------------------------------------------------------------
+// Name:        render_vehicle
+// Description: Slot that is called by the render scheduler to update the
+//              out of date parts of a vehicle's display.
+// Arguments:   - vehicle_id: ID of the vehicle to update
+//              - flags: bitwise OR of RenderScheduler dirty flags
+//------------------------------------------------------------------------------
+void VehicleManager::render_vehicle(int vehicle_id, int flags)
+{
+
+    if (!has_vehicle(vehicle_id))
+        return;
+
+    int vehicle_index = get_vehicle_index(vehicle_id);
+    Vehicle* vehicle = vehicle_list[vehicle_index];
+    vehicle->render(flags);
+
+    if (flags & RenderScheduler::DIRTY_ROW)
+        vehicle_data_model->update_row(vehicle_index);
+
+    if (flags & RenderScheduler::DIRTY_STATUS)
+        emit vehicleStatusUpdated(vehicle_id, vehicle->get_vehicle_status());
+
+}
+
 //------------------------------------------------------------------------------
 // Name:        vehicleStatusReceived
 // Description: Slot that is called when a status packet is received from
@@ -615,7 +877,7 @@ void VehicleManager::vehicle_status_received(int origin_vehicle_id, VehicleStatu
 {
     int vehicle_index = get_vehicle_index(origin_vehicle_id);
     vehicle_list[vehicle_index]->set_vehicle_status(status);
-    vehicle_data_model->update_row(vehicle_index);
+    render_scheduler.mark_dirty(origin_vehicle_id, RenderScheduler::DIRTY_ROW);
 }
 
 //------------------------------------------------------------------------------
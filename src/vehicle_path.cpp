@@ -0,0 +1,540 @@
+//==============================================================================
+// Autonomous Vehicle Library
+//
+// Description: Map graphics for a vehicle's location history and icon. The
+//              path is drawn at one of several levels of detail as frozen
+//              fixed size polyline chunks and a short live tail, so each
+//              update costs the same no matter how long the path is and
+//              zoomed out views draw far fewer points. Every level is
+//              filtered as locations arrive, so changing levels never
+//              filters the history again. The drawn level shows at most a
+//              fixed number of its newest locations and the track before
+//              them is drawn from a coarser level, so the whole history is
+//              shown without drawing every location. Locations are kept in a
+//              compact history and only become geometry when drawn.
+//==============================================================================
+
+#include "vehicle_path.h"
+
+// Z-indices
+#include "graphics.h"
+
+// Distances between path locations
+#include "util/geo.h"
+
+// Cached vehicle icon symbols
+#include "symbol_cache.h"
+
+// ArcGIS includes
+#include <PolylineBuilder.h>
+#include <SpatialReference.h>
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+
+// Name of the icon graphic attribute holding the vehicle yaw in degrees
+const char* VehiclePath::YAW_ATTRIBUTE = "yaw";
+
+//==============================================================================
+//                              CLASS DEFINITION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        VehiclePath constructor
+// Description: Constructs an empty path that draws into a graphics
+//              overlay, showing every location until a resolution is
+//              set.
+// Arguments:   - graphics_overlay: overlay to add the path and icon
+//                graphics to
+//              - graphic_index: index to keep the icon graphic in
+//              - max_points: maximum number of locations to keep in the
+//                history
+//              - parent: parent QObject
+//------------------------------------------------------------------------------
+VehiclePath::VehiclePath(GraphicsOverlay* graphics_overlay, GraphicIndex* graphic_index,
+                         int max_points, QObject* parent) :
+    QObject(parent), graphics_overlay(graphics_overlay),
+    history(static_cast<size_t>(max_points)), graphic_index(graphic_index)
+{
+
+    path_symbol = new SimpleLineSymbol(SimpleLineSymbolStyle::Solid, color, 3, this);
+
+    // The path graphics have their own symbol, so the overlay renderer only
+    // draws the icon graphic, rotated by its yaw attribute
+    icon_renderer = new SimpleRenderer(SymbolCache::instance()->get_vehicle_icon_symbol(color), this);
+    icon_renderer->setRotationExpression(QString("[%1]").arg(YAW_ATTRIBUTE));
+    icon_renderer->setRotationType(RotationType::Geographic);
+    graphics_overlay->setRenderer(icon_renderer);
+
+    levels.resize(NUM_LEVELS);
+    levels[0].tolerance = 0.0;
+    for (int i = 1; i < NUM_LEVELS; i++)
+        levels[i].tolerance = FIRST_LEVEL_TOLERANCE * std::pow(LEVEL_TOLERANCE_FACTOR, i - 1);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        VehiclePath destructor
+// Description: Default destructor.
+//------------------------------------------------------------------------------
+VehiclePath::~VehiclePath()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        append
+// Description: Adds a location to the end of the path. The live tail and
+//              icon are not redrawn until redraw_tail and redraw_icon are
+//              called, so that several locations can be added per redraw.
+// Arguments:   - time: location time in seconds
+//              - lat: latitude in degrees
+//              - lon: longitude in degrees
+//              - yaw: vehicle yaw in degrees
+//              - depth: vehicle depth in meters
+//------------------------------------------------------------------------------
+void VehiclePath::append(double time, double lat, double lon, double yaw, double depth)
+{
+
+    location = Point(lon, lat, SpatialReference::wgs84());
+    this->yaw = yaw;
+
+    // Every level is filtered so that a level is ready to draw when it
+    // becomes visible, but only the drawn level's tail grows
+    history.append(time, lat, lon, yaw, depth);
+    uint64_t index = history.get_end_index() - 1;
+    for (int i = 0; i < NUM_LEVELS; i++)
+        if (add_to_level(levels[i], index) && i == visible_level)
+            add_to_tail(track, index);
+    remove_old_chunks();
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        redraw_tail
+// Description: Redraws the visible live tail to end at the latest location.
+//------------------------------------------------------------------------------
+void VehiclePath::redraw_tail()
+{
+    update_tail(track, history.get_end_index() - 1);
+}
+
+//------------------------------------------------------------------------------
+// Name:        redraw_icon
+// Description: Moves and rotates the vehicle icon to the latest location
+//              and yaw.
+//------------------------------------------------------------------------------
+void VehiclePath::redraw_icon()
+{
+    update_icon();
+}
+
+//------------------------------------------------------------------------------
+// Name:        set_resolution
+// Description: Draws the coarsest level of detail whose tolerance is no
+//              larger than the ground size of a pixel.
+// Arguments:   - meters_per_pixel: ground distance covered by one pixel
+//                on the map in meters
+//------------------------------------------------------------------------------
+void VehiclePath::set_resolution(double meters_per_pixel)
+{
+
+    int new_level = 0;
+    for (int i = 1; i < NUM_LEVELS; i++)
+        if (levels[i].tolerance <= meters_per_pixel)
+            new_level = i;
+
+    if (new_level == visible_level)
+        return;
+
+    // The old level's geometry is dropped rather than hidden, so only one
+    // level's geometry exists at a time. The new level already has its kept
+    // locations, so only its remembered locations and the older track are
+    // built
+    clear_track(track);
+    clear_track(old_track);
+    old_level = -1;
+    visible_level = new_level;
+    build_level(levels[visible_level]);
+    update_tail(track, history.get_end_index() - 1);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        set_color
+// Description: Sets the path and icon color.
+// Arguments:   - color: path and icon color
+//------------------------------------------------------------------------------
+void VehiclePath::set_color(QColor color)
+{
+
+    if (color == this->color)
+        return;
+
+    this->color = color;
+    path_symbol->setColor(color);
+    icon_renderer->setSymbol(SymbolCache::instance()->get_vehicle_icon_symbol(color));
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        clear
+// Description: Removes every location and graphic from the path.
+//------------------------------------------------------------------------------
+void VehiclePath::clear()
+{
+
+    // The overlay is emptied first so that the graphics are not searched
+    // for one at a time
+    graphics_overlay->graphics()->clear();
+    clear_track(track);
+    clear_track(old_track);
+    old_level = -1;
+    for (Level& level : levels)
+    {
+        level.kept_indices.clear();
+        level.window_begin = 0;
+    }
+
+    graphic_index->remove(icon_graphic);
+    delete icon_graphic;
+    icon_graphic = nullptr;
+    history.clear();
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        size
+// Description: Gets the number of locations in the path.
+// Returns:     Number of locations.
+//------------------------------------------------------------------------------
+int VehiclePath::size() const
+{
+    return static_cast<int>(history.size());
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_history
+// Description: Gets the history of the path's locations.
+// Returns:     Path history.
+//------------------------------------------------------------------------------
+const PathHistory& VehiclePath::get_history() const
+{
+    return history;
+}
+
+//------------------------------------------------------------------------------
+// Name:        add_to_level
+// Description: Keeps a location from the history in a level if it is at
+//              least the level's tolerance away from the last kept
+//              location, forgetting the level's kept locations that are
+//              no longer stored, and its oldest past MAX_LEVEL_POINTS
+//              unless it is the coarsest level.
+// Arguments:   - level: level of detail
+//              - index: history index of the location
+// Returns:     True if the level kept the location.
+//------------------------------------------------------------------------------
+bool VehiclePath::add_to_level(Level& level, uint64_t index)
+{
+
+    uint64_t first_index = history.get_first_index();
+    while (!level.kept_indices.empty() && level.kept_indices.front() < first_index)
+        level.kept_indices.pop_front();
+
+    double lat = history.get_lat(index);
+    double lon = history.get_lon(index);
+
+    // Distances this short are well approximated on a flat earth
+    if (!level.kept_indices.empty() && level.tolerance > 0.0)
+    {
+        double east, north;
+        avl::geo::EnuFrame(level.last_lat, level.last_lon).to_enu(lat, lon, east, north);
+        if (north*north + east*east < level.tolerance*level.tolerance)
+            return false;
+    }
+
+    // The coarsest level remembers the whole history so that the track
+    // before any other level's remembered locations can always be drawn
+    level.kept_indices.push_back(index);
+    if (&level != &levels.back() &&
+        static_cast<int>(level.kept_indices.size()) > MAX_LEVEL_POINTS)
+    {
+        level.window_begin = level.kept_indices.front() + 1;
+        level.kept_indices.pop_front();
+    }
+
+    level.last_lat = lat;
+    level.last_lon = lon;
+    return true;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        add_to_tail
+// Description: Adds a location to a track's live tail, freezing the tail
+//              into a chunk once it is full.
+// Arguments:   - track: drawn track
+//              - index: history index of the location
+//------------------------------------------------------------------------------
+void VehiclePath::add_to_tail(Track& track, uint64_t index)
+{
+
+    track.tail_indices.push_back(index);
+    if (static_cast<int>(track.tail_indices.size()) > CHUNK_SIZE)
+        freeze_tail(track);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        freeze_tail
+// Description: Turns a track's live tail into a chunk graphic and starts
+//              a new tail from its last location.
+// Arguments:   - track: drawn track
+//------------------------------------------------------------------------------
+void VehiclePath::freeze_tail(Track& track)
+{
+
+    Graphic* chunk_graphic = new Graphic(get_polyline(track.tail_indices), path_symbol, this);
+    chunk_graphic->setZIndex(VEHICLE_PATH_Z_INDEX);
+    graphics_overlay->graphics()->append(chunk_graphic);
+    uint64_t last_index = track.tail_indices.back();
+    track.chunks.push_back({chunk_graphic, track.tail_indices.front(), last_index});
+
+    track.tail_indices.clear();
+    track.tail_indices.push_back(last_index);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        remove_old_chunks
+// Description: Removes the chunks and tail locations that start before
+//              the oldest location left in the history, and the drawn
+//              level's oldest chunks past MAX_LEVEL_POINTS locations,
+//              which are drawn again in the older track.
+//------------------------------------------------------------------------------
+void VehiclePath::remove_old_chunks()
+{
+
+    // The coarsest level draws every location it remembers
+    uint64_t first_index = history.get_first_index();
+    size_t max_chunks = static_cast<size_t>(MAX_LEVEL_POINTS / CHUNK_SIZE);
+    bool capped = visible_level + 1 < NUM_LEVELS;
+    for (Track* drawn : {&track, &old_track})
+    {
+
+        while (!drawn->chunks.empty())
+        {
+            const Chunk& chunk = drawn->chunks.front();
+            bool expired = chunk.first_index < first_index;
+            bool forgotten = drawn == &track && capped && drawn->chunks.size() > max_chunks;
+            if (!expired && !forgotten)
+                break;
+            uint64_t last_index = chunk.last_index;
+            graphics_overlay->graphics()->removeOne(chunk.graphic);
+            delete chunk.graphic;
+            drawn->chunks.pop_front();
+            if (!expired)
+                extend_old_track(last_index);
+        }
+
+        // A coarse level's tail can outlast the history if the vehicle stays
+        // within its tolerance for long enough
+        auto first_stored = std::lower_bound(drawn->tail_indices.begin(),
+                                             drawn->tail_indices.end(), first_index);
+        drawn->tail_indices.erase(drawn->tail_indices.begin(), first_stored);
+
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        update_tail
+// Description: Rebuilds a track's live tail graphic.
+// Arguments:   - track: drawn track
+//              - last_index: history index of the location that the tail
+//                ends at, even if it is not in the tail
+//------------------------------------------------------------------------------
+void VehiclePath::update_tail(Track& track, uint64_t last_index)
+{
+
+    if (track.tail_indices.empty())
+        return;
+
+    std::vector<uint64_t> indices = track.tail_indices;
+    if (track.tail_indices.back() != last_index)
+        indices.push_back(last_index);
+    Polyline polyline = get_polyline(indices);
+
+    if (track.tail_graphic == nullptr)
+    {
+        track.tail_graphic = new Graphic(polyline, path_symbol, this);
+        track.tail_graphic->setZIndex(VEHICLE_PATH_Z_INDEX);
+        graphics_overlay->graphics()->append(track.tail_graphic);
+    }
+    else
+    {
+        track.tail_graphic->setGeometry(polyline);
+    }
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        get_polyline
+// Description: Builds a polyline through locations in the history,
+//              skipping any that are no longer stored.
+// Arguments:   - indices: history indices of the locations
+// Returns:     Polyline through the locations.
+//------------------------------------------------------------------------------
+Polyline VehiclePath::get_polyline(const std::vector<uint64_t>& indices) const
+{
+
+    uint64_t first_index = history.get_first_index();
+    PolylineBuilder polyline_builder(SpatialReference::wgs84());
+    for (uint64_t index : indices)
+        if (index >= first_index)
+            polyline_builder.addPoint(history.get_lon(index), history.get_lat(index));
+    return polyline_builder.toPolyline();
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        build_level
+// Description: Builds the drawn track from the locations that a level
+//              remembers, and the older track before them if the level
+//              forgot any locations that are still in the history.
+// Arguments:   - level: level of detail
+//------------------------------------------------------------------------------
+void VehiclePath::build_level(Level& level)
+{
+
+    track.tail_indices.reserve(CHUNK_SIZE + 1);
+    for (uint64_t index : level.kept_indices)
+        add_to_tail(track, index);
+
+    if (!level.kept_indices.empty() && level.window_begin > history.get_first_index())
+        build_old_track(level.kept_indices.front());
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        build_old_track
+// Description: Builds the older track from the finest level coarser than
+//              the drawn level that remembers every location in the
+//              history.
+// Arguments:   - end_index: history index of the first location of the
+//                drawn track, which the older track ends at
+//------------------------------------------------------------------------------
+void VehiclePath::build_old_track(uint64_t end_index)
+{
+
+    clear_track(old_track);
+
+    // The coarsest level always remembers the whole history
+    old_level = NUM_LEVELS - 1;
+    for (int i = visible_level + 1; i < NUM_LEVELS - 1; i++)
+    {
+        if (levels[i].window_begin <= history.get_first_index())
+        {
+            old_level = i;
+            break;
+        }
+    }
+
+    const Level& level = levels[old_level];
+    old_track.tail_indices.reserve(CHUNK_SIZE + 1);
+    for (auto it = level.kept_indices.begin();
+         it != level.kept_indices.end() && *it < end_index; ++it)
+        add_to_tail(old_track, *it);
+    add_to_tail(old_track, end_index);
+    update_tail(old_track, end_index);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        extend_old_track
+// Description: Extends the older track to a location that the drawn
+//              track no longer shows, building it again from a coarser
+//              level if its level forgot locations in the history.
+// Arguments:   - end_index: history index of the new first location of
+//                the drawn track, which the older track ends at
+//------------------------------------------------------------------------------
+void VehiclePath::extend_old_track(uint64_t end_index)
+{
+
+    // The older track would draw more than its level remembers once the
+    // level forgets locations in the history, so it is drawn again from a
+    // coarser level
+    if (old_level < 0 || old_track.tail_indices.empty() ||
+        levels[old_level].window_begin > history.get_first_index())
+    {
+        build_old_track(end_index);
+        return;
+    }
+
+    // The locations that the level kept since the end of the older track
+    // are added, ending where the drawn track now starts
+    const Level& level = levels[old_level];
+    auto it = std::upper_bound(level.kept_indices.begin(), level.kept_indices.end(),
+                               old_track.tail_indices.back());
+    for (; it != level.kept_indices.end() && *it < end_index; ++it)
+        add_to_tail(old_track, *it);
+    add_to_tail(old_track, end_index);
+    update_tail(old_track, end_index);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        clear_track
+// Description: Removes every graphic and tail location of a track.
+// Arguments:   - track: drawn track
+//------------------------------------------------------------------------------
+void VehiclePath::clear_track(Track& track)
+{
+
+    for (Chunk& chunk : track.chunks)
+    {
+        graphics_overlay->graphics()->removeOne(chunk.graphic);
+        delete chunk.graphic;
+    }
+    track.chunks.clear();
+
+    if (track.tail_graphic != nullptr)
+    {
+        graphics_overlay->graphics()->removeOne(track.tail_graphic);
+        delete track.tail_graphic;
+        track.tail_graphic = nullptr;
+    }
+
+    std::vector<uint64_t>().swap(track.tail_indices);
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        update_icon
+// Description: Moves and rotates the vehicle icon to the latest location
+//              and yaw. The icon symbol is shared, so only the geometry and
+//              yaw attribute change.
+//------------------------------------------------------------------------------
+void VehiclePath::update_icon()
+{
+
+    if (history.size() == 0)
+        return;
+
+    if (icon_graphic == nullptr)
+    {
+        QVariantMap attributes;
+        attributes[YAW_ATTRIBUTE] = yaw;
+        icon_graphic = new Graphic(location, attributes, this);
+        icon_graphic->setZIndex(VEHICLE_ICON_Z_INDEX);
+        graphics_overlay->graphics()->append(icon_graphic);
+    }
+    else
+    {
+        icon_graphic->setGeometry(location);
+        icon_graphic->attributes()->replaceAttribute(YAW_ATTRIBUTE, yaw);
+    }
+    graphic_index->insert(icon_graphic, QPointF(location.x(), location.y()));
+
+}
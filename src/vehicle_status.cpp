@@ -17,6 +17,76 @@
 // Debug output
 #include <QDebug>
 
+// Interned string table
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+
+//==============================================================================
+//                            INTERNED STRING TABLE
+//==============================================================================
+
+// The interned string table is shared by every status. The mutex allows
+// statuses to be decoded off the GUI thread
+
+// The strings come from the network, so the table is limited in size and
+// length to keep a misbehaving vehicle from growing it without bound
+static const int MAX_INTERNED_STRINGS = 256;
+static const int MAX_INTERNED_LENGTH = 64;
+
+static QMutex& interned_mutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+static QHash<QByteArray, uint16_t>& interned_ids()
+{
+    static QHash<QByteArray, uint16_t> ids({{QByteArray("NONE"), 0}});
+    return ids;
+}
+
+static QVector<QString>& interned_strings()
+{
+    static QVector<QString> strings({QStringLiteral("NONE")});
+    return strings;
+}
+
+//==============================================================================
+//                            FUNCTION DEFINITIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Name:        decode_or_partial
+// Description: Decodes a status packet into a status core. If a field is
+//              improperly formatted, the fields decoded before it are kept
+//              and the error is logged.
+// Arguments:   - packet: status packet
+// Returns:     Decoded status core.
+//------------------------------------------------------------------------------
+static VehicleStatusCore decode_or_partial(const avl::Packet& packet)
+{
+
+    VehicleStatusCore core;
+    VehicleStatus::clear_core(core);
+
+    try
+    {
+        VehicleStatus::decode(packet, core);
+    }
+    catch (const std::exception& ex)
+    {
+        qDebug() << "VehicleStatus constructor: ignoring improperly formatted STATUS packet (" << ex.what() << ")";
+    }
+    catch (...)
+    {
+        qDebug() << "VehicleStatus constructor: ignoring improperly formatted STATUS packet (unknown exception)";
+    }
+
+    return core;
+
+}
+
 //==============================================================================
 //                              CLASS DEFINITION
 //==============================================================================
@@ -35,152 +105,276 @@ VehicleStatus::VehicleStatus()
 // Description: Creates a VehicleStatus class from an AVL status packet.
 // Arguments:   - packet: status packet
 //------------------------------------------------------------------------------
-VehicleStatus::VehicleStatus(avl::Packet packet)
+VehicleStatus::VehicleStatus(const avl::Packet& packet) :
+    VehicleStatus(decode_or_partial(packet))
 {
 
-    // Attempt to parse the status packet fields
-    try
+}
+
+//------------------------------------------------------------------------------
+// Name:        VehicleStatus constructor
+// Description: Creates a VehicleStatus class from a decoded status core.
+// Arguments:   - core: decoded status core
+//------------------------------------------------------------------------------
+VehicleStatus::VehicleStatus(const VehicleStatusCore& core) :
+    comms_channel(comms_channel_string(core.comms_channel)),
+    vehicle_id(core.vehicle_id),
+    mode(interned_string(core.mode)),
+    operational_status(interned_string(core.operational_status)),
+    whoi_synced(core.whoi_synced != 0),
+    roll(core.roll),
+    pitch(core.pitch),
+    yaw(core.yaw),
+    vx(core.vx),
+    vy(core.vy),
+    vz(core.vz),
+    lat(core.lat),
+    lon(core.lon),
+    alt(core.alt),
+    depth(core.depth),
+    height(core.height),
+    rpm(core.rpm),
+    voltage(core.voltage),
+    num_gps_sats(core.num_gps_sats),
+    iridium_strength(core.iridium_strength),
+    current_task(core.current_task),
+    total_tasks(core.total_tasks),
+    task_percent(core.task_percent),
+    timestamp(core.timestamp)
+{
+
+}
+
+//--------------------------------------------------------------------------
+// Name:        VehicleStatus destructor
+// Description: Default destructor.
+//--------------------------------------------------------------------------
+VehicleStatus::~VehicleStatus()
+{
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        decode
+// Description: Decodes an AVL status packet into a status core in a
+//              single pass over its fields. Fields that are not in the
+//              packet are left at their defaults (NaN or zero). Throws a
+//              std::runtime_error if a field is improperly formatted,
+//              leaving the fields decoded before it in the core.
+// Arguments:   - packet: status packet
+//              - core: status core to decode into
+//------------------------------------------------------------------------------
+void VehicleStatus::decode(const avl::Packet& packet, VehicleStatusCore& core)
+{
+
+    for (const avl::Field& field : packet.get_fields())
     {
 
-        // Vector to store field data bytes for parsing
-        std::vector<uint8_t> field_data;
+        const uint8_t descriptor = field.get_descriptor();
+        const std::vector<uint8_t>& data = field.get_data_ref();
 
-        // Parse the comms channel field
-        if (packet.has_field(COMMS_CHANNEL_DESC))
+        switch (descriptor)
         {
-            field_data = packet.get_field(COMMS_CHANNEL_DESC).get_data();
-            switch (field_data.at(0))
-            {
-                case COMMS_CHANNEL_RADIO: comms_channel = "RADIO"; break;
-                case COMMS_CHANNEL_ACOMMS: comms_channel = "ACOMMS"; break;
-                case COMMS_CHANNEL_IRIDIUM: comms_channel = "IRIDIUM"; break;
-                default: comms_channel = "UNKNOWN";
-            }
-        }
 
-        // Parse the vehicle ID field
-        if (packet.has_field(VEHICLE_ID_DESC))
-        {
-            field_data = packet.get_field(VEHICLE_ID_DESC).get_data();
-            vehicle_id = static_cast<int>(field_data.at(0));
-        }
+            case COMMS_CHANNEL_DESC:
+                core.comms_channel = avl::from_bytes_at<uint8_t>(data, 0);
+                break;
 
-        // Parse the mode field
-        if (packet.has_field(STATUS_MODE_DESC))
-        {
-            field_data = packet.get_field(STATUS_MODE_DESC).get_data();
-            mode = QString::fromStdString(std::string(field_data.begin(), field_data.end()));
-        }
+            case VEHICLE_ID_DESC:
+                core.vehicle_id = avl::from_bytes_at<uint8_t>(data, 0);
+                break;
 
-        // Parse the operational status field
-        if (packet.has_field(STATUS_OPERATIONAL_STATUS_DESC))
-        {
-            field_data = packet.get_field(STATUS_OPERATIONAL_STATUS_DESC).get_data();
-            operational_status = QString::fromStdString(std::string(field_data.begin(), field_data.end()));
-        }
+            case STATUS_MODE_DESC:
+                core.mode = intern_string(data);
+                break;
 
-        // Parse the micromodem synced status field
-        if (packet.has_field(STATUS_UMODEM_SYNCED_DESC))
-        {
-            field_data = packet.get_field(STATUS_UMODEM_SYNCED_DESC).get_data();
-            whoi_synced = static_cast<bool>(field_data.at(0));
-        }
+            case STATUS_OPERATIONAL_STATUS_DESC:
+                core.operational_status = intern_string(data);
+                break;
 
-        // Parse the attitude field
-        if (packet.has_field(STATUS_ATTITUDE_DESC))
-        {
-            field_data = packet.get_field(STATUS_ATTITUDE_DESC).get_data();
-            roll =  avl::from_bytes<double>(avl::subvector(field_data,0,8));
-            pitch = avl::from_bytes<double>(avl::subvector(field_data,8,8));
-            yaw =   avl::from_bytes<double>(avl::subvector(field_data,16,8));
-        }
+            case STATUS_UMODEM_SYNCED_DESC:
+                core.whoi_synced = avl::from_bytes_at<uint8_t>(data, 0);
+                break;
 
-        // Parse the velocity field
-        if (packet.has_field(STATUS_VELOCITY_DESC))
-        {
-            field_data = packet.get_field(STATUS_VELOCITY_DESC).get_data();
-            vx = avl::from_bytes<double>(avl::subvector(field_data,0,8));
-            vy = avl::from_bytes<double>(avl::subvector(field_data,8,8));
-            vz = avl::from_bytes<double>(avl::subvector(field_data,16,8));
-        }
+            case STATUS_ATTITUDE_DESC:
+                core.roll =  avl::from_bytes_at<double>(data, 0);
+                core.pitch = avl::from_bytes_at<double>(data, 8);
+                core.yaw =   avl::from_bytes_at<double>(data, 16);
+                break;
 
-        // Parse the position field
-        if (packet.has_field(STATUS_POSITION_DESC))
-        {
-            field_data = packet.get_field(STATUS_POSITION_DESC).get_data();
-            lat = avl::from_bytes<double>(avl::subvector(field_data,0,8));
-            lon = avl::from_bytes<double>(avl::subvector(field_data,8,8));
-            alt = avl::from_bytes<double>(avl::subvector(field_data,16,8));
-        }
+            case STATUS_VELOCITY_DESC:
+                core.vx = avl::from_bytes_at<double>(data, 0);
+                core.vy = avl::from_bytes_at<double>(data, 8);
+                core.vz = avl::from_bytes_at<double>(data, 16);
+                break;
 
-        // Parse the depth field
-        if (packet.has_field(STATUS_DEPTH_DESC))
-        {
-            field_data = packet.get_field(STATUS_DEPTH_DESC).get_data();
-            depth = avl::from_bytes<double>(field_data);
-        }
+            case STATUS_POSITION_DESC:
+                core.lat = avl::from_bytes_at<double>(data, 0);
+                core.lon = avl::from_bytes_at<double>(data, 8);
+                core.alt = avl::from_bytes_at<double>(data, 16);
+                break;
 
-        // Parse the altitude field
-        if (packet.has_field(STATUS_HEIGHT_DESC))
-        {
-            field_data = packet.get_field(STATUS_HEIGHT_DESC).get_data();
-            height = avl::from_bytes<double>(field_data);
-        }
+            case STATUS_DEPTH_DESC:
+                core.depth = avl::from_bytes_at<double>(data, 0);
+                break;
 
-        // Parse the rpm field
-        if (packet.has_field(STATUS_RPM_DESC))
-        {
-            field_data = packet.get_field(STATUS_RPM_DESC).get_data();
-            rpm = avl::from_bytes<double>(field_data);
-        }
+            case STATUS_HEIGHT_DESC:
+                core.height = avl::from_bytes_at<double>(data, 0);
+                break;
 
-        // Parse the voltage field
-        if (packet.has_field(STATUS_VOLTAGE_DESC))
-        {
-            field_data = packet.get_field(STATUS_VOLTAGE_DESC).get_data();
-            voltage = avl::from_bytes<double>(field_data);
-        }
+            case STATUS_RPM_DESC:
+                core.rpm = avl::from_bytes_at<double>(data, 0);
+                break;
 
-        // Parse the GPS sats field
-        if (packet.has_field(STATUS_GPS_SATS_DESC))
-        {
-            field_data = packet.get_field(STATUS_GPS_SATS_DESC).get_data();
-            num_gps_sats = static_cast<int>(avl::from_bytes<uint8_t>(field_data));
-        }
+            case STATUS_VOLTAGE_DESC:
+                core.voltage = avl::from_bytes_at<double>(data, 0);
+                break;
 
-        // Parse the Iridium strength field
-        if (packet.has_field(STATUS_GPS_SATS_DESC))
-        {
-            field_data = packet.get_field(STATUS_IRIDIUM_STRENGTH_DESC).get_data();
-            iridium_strength = static_cast<int>(avl::from_bytes<uint8_t>(field_data));
-        }
+            case STATUS_GPS_SATS_DESC:
+                core.num_gps_sats = avl::from_bytes_at<uint8_t>(data, 0);
+                break;
+
+            case STATUS_IRIDIUM_STRENGTH_DESC:
+                core.iridium_strength = avl::from_bytes_at<uint8_t>(data, 0);
+                break;
+
+            case STATUS_TASK_DESC:
+                core.current_task = avl::from_bytes_at<uint8_t>(data, 0);
+                core.total_tasks =  avl::from_bytes_at<uint8_t>(data, 1);
+                core.task_percent = avl::from_bytes_at<double>(data, 2);
+                break;
+
+            case STATUS_TIMESTAMP_DESC:
+                core.timestamp = avl::from_bytes_at<double>(data, 0);
+                break;
+
+            default:
+                break;
 
-        // Parse the task field
-        if (packet.has_field(STATUS_TASK_DESC))
-        {
-            field_data = packet.get_field(STATUS_TASK_DESC).get_data();
-            current_task = static_cast<int>(avl::from_bytes<uint8_t>(avl::subvector(field_data,0,1)));
-            total_tasks = static_cast<int>(avl::from_bytes<uint8_t>(avl::subvector(field_data,1,1)));
-            task_percent = avl::from_bytes<double>(avl::subvector(field_data,2,8));
         }
 
+        if (descriptor < 32)
+            core.fields |= (1u << descriptor);
+
     }
-    catch (const std::exception& ex)
-    {
-        qDebug() << "VehicleStatus constructor: ignoring improperly formatted STATUS packet (" << ex.what() << ")";
-    }
-    catch (...)
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        clear_core
+// Description: Sets a status core to the values of an empty status.
+// Arguments:   - core: status core to clear
+//------------------------------------------------------------------------------
+void VehicleStatus::clear_core(VehicleStatusCore& core)
+{
+
+    const double nan = std::nan("");
+
+    core.fields = 0;
+    core.comms_channel = COMMS_CHANNEL_RADIO;
+    core.vehicle_id = 0;
+    core.mode = 0;
+    core.operational_status = 0;
+    core.whoi_synced = 0;
+    core.num_gps_sats = 0;
+    core.iridium_strength = 0;
+    core.current_task = 0;
+    core.total_tasks = 0;
+    core.roll = nan;
+    core.pitch = nan;
+    core.yaw = nan;
+    core.vx = nan;
+    core.vy = nan;
+    core.vz = nan;
+    core.lat = nan;
+    core.lon = nan;
+    core.alt = nan;
+    core.depth = nan;
+    core.height = nan;
+    core.rpm = nan;
+    core.voltage = nan;
+    core.task_percent = 0.0;
+    core.timestamp = nan;
+
+}
+
+//------------------------------------------------------------------------------
+// Name:        intern_string
+// Description: Gets the interned string ID for a string, adding it to
+//              the interned string table if it is new. ID 0 is always
+//              "NONE", which is also returned if the table is full or the
+//              string is too long to intern.
+// Arguments:   - bytes: string bytes
+// Returns:     Interned string ID.
+//------------------------------------------------------------------------------
+uint16_t VehicleStatus::intern_string(const std::vector<uint8_t>& bytes)
+{
+
+    QMutexLocker lock(&interned_mutex());
+    QHash<QByteArray, uint16_t>& ids = interned_ids();
+    QVector<QString>& strings = interned_strings();
+
+    // Look the string up without copying the bytes. Only a new string is
+    // copied into the table
+    const QByteArray key = QByteArray::fromRawData(
+        reinterpret_cast<const char*>(bytes.data()), static_cast<int>(bytes.size()));
+    QHash<QByteArray, uint16_t>::const_iterator it = ids.constFind(key);
+    if (it != ids.constEnd())
+        return it.value();
+
+    // Strings that do not fit are shown as "NONE", and only the first one is
+    // logged so that a vehicle sending them cannot flood the log either
+    if (strings.size() >= MAX_INTERNED_STRINGS || key.size() > MAX_INTERNED_LENGTH)
     {
-        qDebug() << "VehicleStatus constructor: ignoring improperly formatted STATUS packet (unknown exception)";
+        static bool logged = false;
+        if (!logged)
+            qDebug() << "intern_string: not interning status string " << key << " (table full or string too long)";
+        logged = true;
+        return 0;
     }
 
+    uint16_t id = static_cast<uint16_t>(strings.size());
+    QByteArray owned_key(key.constData(), key.size());
+    strings.append(QString::fromUtf8(owned_key));
+    ids.insert(owned_key, id);
+    return id;
+
 }
 
-//--------------------------------------------------------------------------
-// Name:        VehicleStatus destructor
-// Description: Default destructor.
-//--------------------------------------------------------------------------
-VehicleStatus::~VehicleStatus()
+//------------------------------------------------------------------------------
+// Name:        interned_string
+// Description: Gets the string for an interned string ID. Every status
+//              with the same ID shares the same QString data.
+// Arguments:   - id: interned string ID
+// Returns:     Interned string, or "NONE" for an unknown ID.
+//------------------------------------------------------------------------------
+QString VehicleStatus::interned_string(uint16_t id)
 {
+    QMutexLocker lock(&interned_mutex());
+    const QVector<QString>& strings = interned_strings();
+    return id < strings.size() ? strings.at(id) : strings.at(0);
+}
+
+//------------------------------------------------------------------------------
+// Name:        comms_channel_string
+// Description: Gets the shared string for a raw comms channel value.
+// Arguments:   - channel: comms channel field value
+// Returns:     Comms channel string.
+//------------------------------------------------------------------------------
+QString VehicleStatus::comms_channel_string(uint8_t channel)
+{
+
+    static const QString radio = QStringLiteral("RADIO");
+    static const QString acomms = QStringLiteral("ACOMMS");
+    static const QString iridium = QStringLiteral("IRIDIUM");
+    static const QString unknown = QStringLiteral("UNKNOWN");
+
+    switch (channel)
+    {
+        case COMMS_CHANNEL_RADIO:   return radio;
+        case COMMS_CHANNEL_ACOMMS:  return acomms;
+        case COMMS_CHANNEL_IRIDIUM: return iridium;
+        default:                    return unknown;
+    }
 
 }